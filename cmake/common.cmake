@@ -1,3 +1,6 @@
+# Used by functions that call other scripts in this directory
+set(SYCL_GTX_CMAKE_PATH ${CMAKE_CURRENT_LIST_DIR})
+
 function (get_all_files
   sourceListOut
   rootPath
@@ -67,3 +70,82 @@ function (add_test_group groupName sourceList)
                           PROPERTIES FOLDER "tests")
   endif(MSVC)
 endfunction (add_test_group)
+
+# Benchmarks are built like tests, but are not run by CTest
+function (add_benchmark_group groupName sourceList)
+  set(groupSet "")
+  foreach (benchmarkName ${sourceList})
+    get_filename_component(benchmarkName "${benchmarkName}" NAME)
+    get_filename_component(projectName "${benchmarkName}" NAME_WE)
+
+    add_executable(${projectName} ${benchmarkName})
+    set(groupSet ${groupSet} ${projectName})
+
+    include_directories(${projectName} ${SYCL_GTX_INCLUDE_PATH})
+    include_directories(${projectName} ${OpenCL_INCLUDE_DIRS})
+
+    target_link_libraries(${projectName} sycl-gtx)
+    target_link_libraries(${projectName} ${OpenCL_LIBRARIES})
+
+    if(MSVC)
+      set_target_properties(
+        ${projectName} PROPERTIES FOLDER "${groupName}"
+      )
+    endif(MSVC)
+  endforeach (benchmarkName)
+
+  add_custom_target(${groupName} DEPENDS ${groupSet})
+  if(MSVC)
+    set_target_properties(${groupName} PROPERTIES FOLDER "${groupName}")
+  endif(MSVC)
+
+  # Runs all benchmarks of the group,
+  # each one writes its results to ${projectName}.json
+  set(runCommands "")
+  foreach (projectName ${groupSet})
+    set(runCommands ${runCommands}
+      COMMAND $<TARGET_FILE:${projectName}>
+              "${CMAKE_CURRENT_BINARY_DIR}/${projectName}.json"
+    )
+  endforeach (projectName)
+  add_custom_target(run_${groupName}
+    ${runCommands}
+    DEPENDS ${groupSet}
+    WORKING_DIRECTORY "${CMAKE_CURRENT_BINARY_DIR}"
+  )
+endfunction (add_benchmark_group)
+
+# Runs extractTarget with kernel extraction enabled after it is built
+# and embeds the kernels it built into embedTarget.
+# The kernels are written to the ${extractTarget}_kernels directory
+# in the current binary directory.
+# extractTarget has to exit successfully and can't be the same as embedTarget.
+function (add_kernel_extraction
+  extractTarget
+  embedTarget
+  # ARGV2 binaries = FALSE, requires an OpenCL device at build time
+)
+  set(kernelPath "${CMAKE_CURRENT_BINARY_DIR}/${extractTarget}_kernels")
+  set(embedSource "${kernelPath}/embedded_kernels.cpp")
+
+  set(extractEnv "SYCL_GTX_EXTRACT_DIR=${kernelPath}")
+  if((${ARGC} GREATER 2) AND ("${ARGV2}" STREQUAL "TRUE"))
+    set(extractEnv ${extractEnv} "SYCL_GTX_EXTRACT_BINARIES=1")
+  endif()
+
+  add_custom_command(
+    OUTPUT "${embedSource}"
+    COMMAND ${CMAKE_COMMAND} -E remove_directory "${kernelPath}"
+    COMMAND ${CMAKE_COMMAND} -E make_directory "${kernelPath}"
+    COMMAND ${CMAKE_COMMAND} -E env ${extractEnv}
+            $<TARGET_FILE:${extractTarget}>
+    COMMAND ${CMAKE_COMMAND}
+            -DKERNEL_PATH=${kernelPath}
+            -DOUTPUT=${embedSource}
+            -P "${SYCL_GTX_CMAKE_PATH}/embed_kernels.cmake"
+    DEPENDS ${extractTarget} "${SYCL_GTX_CMAKE_PATH}/embed_kernels.cmake"
+    COMMENT "Extracting kernels from ${extractTarget}"
+    VERBATIM
+  )
+  target_sources(${embedTarget} PRIVATE "${embedSource}")
+endfunction (add_kernel_extraction)
@@ -0,0 +1,56 @@
+# Writes the kernels extracted to KERNEL_PATH as C++ source to OUTPUT,
+# see add_kernel_extraction in common.cmake
+
+function (get_byte_list bytesOut fileName)
+  file(READ "${fileName}" hexString HEX)
+  string(REGEX REPLACE "([0-9a-f][0-9a-f])" "0x\\1," byteList "${hexString}")
+  set(${bytesOut} "${byteList}" PARENT_SCOPE)
+endfunction (get_byte_list)
+
+file(GLOB kernelList "${KERNEL_PATH}/*.cl")
+list(SORT kernelList)
+
+set(source "// Generated from the kernels in ${KERNEL_PATH}\n\n")
+set(source "${source}#include <SYCL/detail/kernel_store.h>\n\nnamespace {\n")
+
+set(kernelIndex 0)
+foreach (kernelFile ${kernelList})
+  get_filename_component(kernelHash "${kernelFile}" NAME_WE)
+  set(kernelName "kernel_${kernelIndex}")
+
+  # The source is null terminated
+  get_byte_list(codeBytes "${kernelFile}")
+  set(source "${source}\nconst unsigned char ${kernelName}[] = {")
+  set(source "${source}${codeBytes}0x00};\n")
+
+  file(GLOB binaryList "${KERNEL_PATH}/${kernelHash}.*.bin")
+  list(SORT binaryList)
+  set(binaries "")
+  set(binaryIndex 0)
+  foreach (binaryFile ${binaryList})
+    get_filename_component(binaryFileName "${binaryFile}" NAME)
+    string(
+      REGEX REPLACE "^${kernelHash}\\.(.+)\\.bin$" "\\1"
+      deviceName "${binaryFileName}"
+    )
+    set(binaryName "${kernelName}_${binaryIndex}")
+
+    get_byte_list(binaryBytes "${binaryFile}")
+    set(source "${source}const unsigned char ${binaryName}[] = {")
+    set(source "${source}${binaryBytes}};\n")
+    set(binaries "${binaries}\n     {\"${deviceName}\", ${binaryName},")
+    set(binaries "${binaries} sizeof(${binaryName})},")
+
+    math(EXPR binaryIndex "${binaryIndex} + 1")
+  endforeach (binaryFile)
+
+  set(source "${source}const ::cl::sycl::detail::kernel_store::registrar ")
+  set(source "${source}${kernelName}_registrar(\n")
+  set(source "${source}    ${kernelName}, sizeof(${kernelName}),")
+  set(source "${source} {${binaries}});\n")
+
+  math(EXPR kernelIndex "${kernelIndex} + 1")
+endforeach (kernelFile)
+
+set(source "${source}\n}  // namespace\n")
+file(WRITE "${OUTPUT}" "${source}")
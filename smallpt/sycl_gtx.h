@@ -32,6 +32,18 @@ using Sphere = Sphere_detail<float_type, modify_sample_rate>;
 #include <CL/sycl_gtx_compatibility.h>
 #endif
 
+// Sphere as stored in the device buffer,
+// padded to the alignment of its vectors like in OpenCL
+struct alignas(16) SphereData {
+  cl::sycl::cl_float3 p, e, c;  // position, emission, color
+  float rad;                    // radius
+  int refl;                     // reflection type
+};
+
+#define SPHERE_DATA_FIELDS(field) \
+  field(p) field(e) field(c) field(rad) field(refl)
+SYCL_STRUCT(SphereData, SPHERE_DATA_FIELDS)
+
 namespace ns_sycl_gtx {
 
 using namespace cl::sycl;
@@ -54,8 +66,8 @@ static Sphere spheres[numSpheres] = {
            DIFF)  // Lite
 };
 
-using spheres_t =
-    accessor<float16, 1, access::mode::read, access::target::global_buffer>;
+using spheres_t = accessor<SphereData, 1, access::mode::read,
+                           access::target::global_buffer>;
 
 struct Vector : public ::Vec_detail<float1> {
  private:
@@ -77,15 +89,14 @@ struct Vector : public ::Vec_detail<float1> {
 using RaySycl = ::Ray_detail<float1>;
 
 struct SphereSycl : public ::Sphere_detail<float1> {
-  float1 refl;
+  int1 refl;
 
-  SphereSycl(const float16& data)
-      : ::Sphere_detail<float1>(
-            data.lo().lo().w(), Vector(data.lo().lo().xyz()),
-            Vector(data.lo().hi().xyz()), Vector(data.hi().lo().xyz()),
-            Refl_t::DIFF  // Not important
-            ),
-        refl(data.hi().lo().w()) {}
+  SphereSycl(const device_struct<SphereData>& data)
+      : ::Sphere_detail<float1>(data.rad, Vector(data.p), Vector(data.e),
+                                Vector(data.c),
+                                Refl_t::DIFF  // Not important
+                                ),
+        refl(data.refl) {}
 
   float1 intersect(
       const Ray_detail<float1>& r) const {  // returns distance, 0 if no hit
@@ -154,19 +165,15 @@ inline bool1 intersect(spheres_t spheres, const RaySycl& r, float1& t,
   return t < inf;
 }
 
-// http://stackoverflow.com/a/16077942
-static float1 getRandom(uint2& seed) {
-  // Note: Should not be declared static
-  const float1 invMaxInt = 1.0f / 4294967296.0f;
-  uint1 x = seed.x() * 17 + seed.y() * 13123;
-  seed.x() = (x << 13) ^ x;
-  seed.y() = seed.y() ^ x << 7;
-  return static_cast<float1>((x * (x * x * 15731 + 74323) + 871483) *
-                             invMaxInt);
+// Every pixel has its own stream of random numbers
+using Random = cl::sycl::random::philox4x32<>;
+
+static float1 getRandom(Random& rng) {
+  return cl::sycl::random::uniform(rng);
 }
 
 static void radiance(Vector& return_vec, spheres_t spheres, RaySycl r,
-                     uint2& randomSeed, Vector cl = {0, 0, 0},
+                     Random& rng, Vector cl = {0, 0, 0},
                      Vector cf = {1, 1, 1}) {
   using namespace cl::sycl;
 
@@ -216,7 +223,7 @@ static void radiance(Vector& return_vec, spheres_t spheres, RaySycl r,
 
     depth += 1;
     SYCL_IF(depth > 5) {
-      SYCL_IF(getRandom(randomSeed) < p) {
+      SYCL_IF(getRandom(rng) < p) {
         f = f * (1 / p);
       }
       SYCL_ELSE {
@@ -229,9 +236,9 @@ static void radiance(Vector& return_vec, spheres_t spheres, RaySycl r,
 
     cf = cf.mult(f);
 
-    SYCL_IF(obj.refl == (::cl_float)DIFF) {  // Ideal DIFFUSE reflection
-      float1 r1 = static_cast<float1>(2 * M_PI * getRandom(randomSeed));
-      float1 r2 = getRandom(randomSeed);
+    SYCL_IF(obj.refl == static_cast<int>(DIFF)) {  // Ideal DIFFUSE reflection
+      float1 r1 = static_cast<float1>(2 * M_PI * getRandom(rng));
+      float1 r2 = getRandom(rng);
       float1 r2s = cl::sycl::sqrt(r2);
       Vector w = nl;
 
@@ -255,7 +262,8 @@ static void radiance(Vector& return_vec, spheres_t spheres, RaySycl r,
       r = RaySycl(x, d);
       SYCL_CONTINUE;
     }
-    SYCL_ELSE_IF(obj.refl == (::cl_float)SPEC) {  // Ideal SPECULAR reflection
+    // Ideal SPECULAR reflection
+    SYCL_ELSE_IF(obj.refl == static_cast<int>(SPEC)) {
       // Recursion
       r = RaySycl(x, r.d - n * 2 * n.dot(r.d));
       SYCL_CONTINUE;
@@ -314,7 +322,7 @@ static void radiance(Vector& return_vec, spheres_t spheres, RaySycl r,
     float1 TP = Tr / (1 - P);
 
     // Tail recursion
-    SYCL_IF(getRandom(randomSeed) < P) {
+    SYCL_IF(getRandom(rng) < P) {
       cf = cf * RP;
       r = reflRay;
     }
@@ -337,13 +345,13 @@ static void compute_sycl_gtx(void* dev, int w, int h, int samps, Ray cameraRay,
 
   queue q(*reinterpret_cast<device*>(dev));  // NOLINT
 
-  auto spheres_tmp = buffer<float16>(range<1>(ns_sycl_gtx::numSpheres));
+  auto spheres_tmp = buffer<SphereData>(range<1>(ns_sycl_gtx::numSpheres));
   {
 // TODO(progtx): Conform to the SYCL spec
 #ifdef SYCL_GTX
-    auto assign = [](cl::sycl::cl_float4& target, ::Vec& data) {
+    auto assign = [](cl::sycl::cl_float3& target, ::Vec& data) {
 #else
-    auto assign = [](cl::sycl::cl_float4 target, ::Vec& data) {
+    auto assign = [](cl::sycl::cl_float3 target, ::Vec& data) {
 #endif
       using type = float4::element_type;
       target.x() = static_cast<type>(data.x);
@@ -353,17 +361,16 @@ static void compute_sycl_gtx(void* dev, int w, int h, int samps, Ray cameraRay,
 
     auto s = spheres_tmp.get_access<access::mode::discard_write,
                                     access::target::host_buffer>();
-    // See SphereSycl
     for (int i = 0; i < ns_sycl_gtx::numSpheres; ++i) {
       auto& si = s[i];
       auto& sj = ns_sycl_gtx::spheres[i];
 
-      assign(si.lo().lo(), sj.p);
-      assign(si.lo().hi(), sj.e);
-      assign(si.hi().lo(), sj.c);
+      assign(si.p, sj.p);
+      assign(si.e, sj.e);
+      assign(si.c, sj.c);
 
-      si.lo().lo().w() = static_cast<::cl_float>(sj.rad);
-      si.hi().lo().w() = static_cast<::cl_float>(sj.refl);
+      si.rad = static_cast<float>(sj.rad);
+      si.refl = sj.refl;
     }
   }
 
@@ -373,9 +380,7 @@ static void compute_sycl_gtx(void* dev, int w, int h, int samps, Ray cameraRay,
                            ? std::min(samps / 5 + 1, h / 10)
                            : 1;
 
-  uint16_t Xi[3] = {0, 0, 0};
   vector<buffer<float3>> colors;
-  vector<buffer<cl::sycl::cl_uint2>> seeds_tmp;
   vector<pair<int, int>> lineOffset;
   auto starts_tmp = buffer<int>(range<1>(numParts));
   {
@@ -390,22 +395,7 @@ static void compute_sycl_gtx(void* dev, int w, int h, int samps, Ray cameraRay,
 
       lineOffset.emplace_back(start, height);
       colors.emplace_back(length);
-      seeds_tmp.emplace_back(length);
       starts[k] = start;
-
-      auto seeds = seeds_tmp.back()
-                       .get_access<access::mode::discard_write,
-                                   access::target::host_buffer>();
-
-      for (int y = 0; y < height; ++y) {
-        Xi[2] = y * y * y;
-        for (int x = 0; x < w; ++x) {
-          cl::sycl::cl_uint2 seed;
-          seed.x() = static_cast<::cl_uint>(get_random(Xi));
-          seed.y() = static_cast<::cl_uint>(get_random(Xi));
-          seeds[y * w + x] = seed;
-        }
-      }
     }
   }
 
@@ -415,13 +405,9 @@ static void compute_sycl_gtx(void* dev, int w, int h, int samps, Ray cameraRay,
                    .get_access<access::mode::discard_read_write,
                                access::target::global_buffer>(cgh);
 
-      // TODO(progtx): constant_buffer
+      // Small enough to be promoted to constant memory by the runtime
       auto spheres = spheres_tmp.get_access<access::mode::read,
                                             access::target::global_buffer>(cgh);
-      auto seeds =
-          seeds_tmp[k]
-              .get_access<access::mode::read, access::target::global_buffer>(
-                  cgh);
       auto starts = starts_tmp.get_access<access::mode::read,
                                           access::target::global_buffer>(cgh);
 
@@ -431,9 +417,8 @@ static void compute_sycl_gtx(void* dev, int w, int h, int samps, Ray cameraRay,
             Vector cy(cyIn);
             Vector r(rIn);
             RaySycl cam(Vector(cameraRay.o), Vector(cameraRay.d));
-            uint2 randomSeed;
-            randomSeed.x() = seeds[i].x() * i[0] + i[0] + 1;
-            randomSeed.y() = seeds[i].y() * i[1] + i[1] + 1;
+            // Keyed by the pixel, no seeds need to be uploaded
+            Random rng(0u, (i[1] + starts[k]) * w + i[0]);
 
             c[i] = 0;  // Important to start at zero
 
@@ -443,8 +428,8 @@ static void compute_sycl_gtx(void* dev, int w, int h, int samps, Ray cameraRay,
               SYCL_FOR(int1 sx = 0, sx < 2, sx++) {
                 SYCL_FOR(int1 s = 0, s < samps, s++) {
                   float2 rnew;
-                  rnew.x() = 2 * getRandom(randomSeed);
-                  rnew.y() = 2 * getRandom(randomSeed);
+                  rnew.x() = 2 * getRandom(rng);
+                  rnew.y() = 2 * getRandom(rng);
 
                   float2 dd;
 
@@ -473,7 +458,7 @@ static void compute_sycl_gtx(void* dev, int w, int h, int samps, Ray cameraRay,
                   // TODO(progtx):
                   Vector rad;
                   radiance(rad, spheres, RaySycl(cam.o + d * 140, d.norm()),
-                           randomSeed);
+                           rng);
                   r = r + rad * (1.f / samps);
                 }  // Camera rays are pushed ^^^^^ forward to start in interior
                 SYCL_END;
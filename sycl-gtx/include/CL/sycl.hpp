@@ -9,14 +9,22 @@
 #include "SYCL/command_group.h"
 #include "SYCL/context.h"
 #include "SYCL/device.h"
+#include "SYCL/device_struct.h"
 #include "SYCL/functions/common.h"
+#include "SYCL/functions/geometric.h"
+#include "SYCL/functions/integer.h"
+#include "SYCL/functions/math.h"
+#include "SYCL/functions/relational.h"
 #include "SYCL/handler.h"
 #include "SYCL/info.h"
 #include "SYCL/kernel.h"
 #include "SYCL/platform.h"
 #include "SYCL/program.h"
 #include "SYCL/queue.h"
+#include "SYCL/random.h"
 #include "SYCL/ranges.h"
+#include "SYCL/streaming.h"
+#include "SYCL/tiling.h"
 #include "SYCL/vectors/swizzled_vec.h"
 #include "SYCL/vectors/vec.h"
 #include "SYCL/workitem_functions.h"
@@ -29,6 +37,9 @@
 
 #undef SYCL_ACCESSOR_CLASS
 #undef SYCL_ADD_ACCESSOR
+#undef SYCL_BUILTIN_ONE_ARG
+#undef SYCL_BUILTIN_THREE_ARG
+#undef SYCL_BUILTIN_TWO_ARG
 #undef SYCL_DEVICE_REF_SUBSCRIPT_OP
 #undef SYCL_DEVICE_REF_SUBSCRIPT_OPERATORS
 #undef SYCL_MOVE_INIT
@@ -36,6 +36,10 @@ SYCL_UTYPE_ONE(char)
 SYCL_UTYPE_ONE(short)
 SYCL_UTYPE_ONE(long)
 
+// Structs are used directly in kernels
+template <typename T>
+using device_struct = T;
+
 #undef SYCL_TYPE_ONE
 #undef SYCL_TYPE_VEC
 #undef SYCL_UTYPE_ONE
@@ -61,6 +65,8 @@ SYCL_UTYPE_ONE(long)
   for (init; condition; increment)           \
   SYCL_BEGIN
 
+#define SYCL_STRUCT(structT, fields)
+
 #define SYCL_BREAK break;
 #define SYCL_CONTINUE continue;
 #define SYCL_RETURN return;
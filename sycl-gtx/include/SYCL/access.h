@@ -30,58 +30,51 @@ enum class target {
   image_array,      // access an array of images on device
 };
 
-static debug& operator<<(debug& d, mode m) {
-  std::string str("mode::");
+static const char* log_name(mode m) {
   switch (m) {
     case mode::read:
-      str += "read";
-      break;
+      return "mode::read";
     case mode::write:
-      str += "write";
-      break;
+      return "mode::write";
     case mode::read_write:
-      str += "read_write";
-      break;
+      return "mode::read_write";
     case mode::discard_write:
-      str += "discard_write";
-      break;
+      return "mode::discard_write";
     case mode::discard_read_write:
-      str += "discard_read_write";
-      break;
+      return "mode::discard_read_write";
     case mode::atomic:
-      str += "atomic";
-      break;
+      return "mode::atomic";
   }
-  d << str;
+  return "mode::unknown";
+}
+
+static debug& operator<<(debug& d, mode m) {
+  d << log_name(m);
   return d;
 }
 
-static debug& operator<<(debug& d, target t) {
-  std::string str("target::");
+static const char* log_name(target t) {
   switch (t) {
     case target::global_buffer:
-      str += "global_buffer";
-      break;
+      return "target::global_buffer";
     case target::constant_buffer:
-      str += "constant_buffer";
-      break;
+      return "target::constant_buffer";
     case target::local:
-      str += "local";
-      break;
+      return "target::local";
     case target::image:
-      str += "image";
-      break;
+      return "target::image";
     case target::host_buffer:
-      str += "host_buffer";
-      break;
+      return "target::host_buffer";
     case target::host_image:
-      str += "host_image";
-      break;
+      return "target::host_image";
     case target::image_array:
-      str += "image_array";
-      break;
+      return "target::image_array";
   }
-  d << str;
+  return "target::unknown";
+}
+
+static debug& operator<<(debug& d, target t) {
+  d << log_name(t);
   return d;
 }
 
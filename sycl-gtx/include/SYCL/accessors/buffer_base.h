@@ -19,6 +19,8 @@ namespace detail {
 template <typename DataType, int dimensions>
 class accessor_buffer {
  protected:
+  friend class ::cl::sycl::handler;
+
   buffer<DataType, dimensions>* buf;
   handler* commandGroupHandler;
   range<dimensions> offset;
@@ -40,9 +42,16 @@ class accessor_buffer {
   ::size_t access_buffer_range(int n) const {
     return buf->rang.get(n);
   }
+  // Differs from the buffer range for sub-buffers
+  ::size_t access_host_range(int n) const {
+    return buf->host_range.get(n);
+  }
   typename base_host_data<DataType>::type* access_host_data() const {
     return buf->host_data.get();
   }
+  void host_changed() const {
+    buf->host_changed();
+  }
 };
 
 }  // namespace detail
@@ -64,9 +64,20 @@ SYCL_ACCESSOR_CLASS(target == access::target::constant_buffer ||
     return base_acc_buffer::get_buffer_object();
   }
 
+  // Multi-dimensional ids are linearized with the range of the buffer,
+  // which can differ from the range of the kernel
   return_t operator[](id<dimensions> index) const {
-    auto resource_name = kernel_ns::register_resource(*this);
-    return return_t(resource_name + "[" + data_ref::get_name(index) + "]");
+    if (dimensions == 1) {
+      auto resource_name = kernel_ns::register_resource(*this);
+      return element_ref<return_t>::get(resource_name,
+                                        data_ref::get_name(index));
+    }
+    vector_class<string_class> indices;
+    for (int i = 0; i < dimensions; ++i) {
+      indices.push_back(data_ref::get_name(index.get(i)));
+    }
+    return accessor_device_ref<1, DataType, dimensions, mode, target>(
+        this, std::move(indices))[index.get(dimensions - 1)];
   }
 
  private:
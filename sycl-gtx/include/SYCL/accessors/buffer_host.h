@@ -35,7 +35,7 @@ namespace detail {
 template <int level, typename DataType, int dimensions, access::mode mode>
 class accessor_host_ref {
  protected:
-  using Lower = accessor_host_ref<dimensions - 1, DataType, dimensions, mode>;
+  using Lower = accessor_host_ref<level - 1, DataType, dimensions, mode>;
   SYCL_ACCESSOR_HOST_REF_CONSTRUCTOR();
 
  public:
@@ -55,13 +55,14 @@ class accessor_host_ref<1, DataType, dimensions, mode> {
   typename base_host_data<DataType>::type& operator[](int index) {
     // http://stackoverflow.com/questions/7367770
     rang[dimensions - 1] = index;
-    index = 0;
-    int multiplier = 1;
+    // Elements of sub-buffers are spread over the rows of the parent
+    ::size_t offset = 0;
+    ::size_t multiplier = 1;
     for (int i = 0; i < dimensions; ++i) {
-      index += static_cast<int>(rang[i] * multiplier);
-      multiplier *= static_cast<int>(parent->access_buffer_range(i));
+      offset += rang[i] * multiplier;
+      multiplier *= parent->access_host_range(i);
     }
-    return parent->access_host_data()[index];
+    return parent->access_host_data()[offset];
   }
 };
 
@@ -112,6 +113,9 @@ SYCL_ACCESSOR_CLASS(target == access::target::host_buffer)
   }
 
   ~accessor_detail() {
+    if (mode != access::mode::read) {
+      base_acc_buffer::host_changed();
+    }
     synchronizer::remove(this, base_acc_buffer::buf);
   }
 };
@@ -21,6 +21,14 @@ struct acc_device_return {
   using type = data_ref;
 };
 
+// Kernel reference to an element of a buffer
+template <typename T>
+struct element_ref {
+  static T get(const string_class& resource_name, const string_class& index) {
+    return T(resource_name + "[" + index + "]");
+  }
+};
+
 template <int level, typename DataType, int dimensions, access::mode mode,
           access::target target>
 struct subscript_helper {
@@ -67,7 +75,7 @@ template <int level, typename DataType, int dimensions, access::mode mode,
 class accessor_device_ref {
  protected:
   using subscript_return_t =
-      typename subscript_helper<dimensions, DataType, dimensions, mode,
+      typename subscript_helper<level, DataType, dimensions, mode,
                                 target>::type;
   SYCL_ACCESSOR_DEVICE_REF_CONSTRUCTOR();
   template <class T>
@@ -95,14 +103,16 @@ class accessor_device_ref<1, DataType, dimensions, mode, target> {
     auto rang_copy = rang;
     rang_copy[dimensions - 1] = data_ref::get_name(index);
     string_class ind(std::move(rang_copy[0]));
+    auto resource_name = kernel_ns::register_resource(*parent);
+    // Long multipliers keep the index from overflowing in large buffers
+    auto suffix = kernel_ns::wide_indices() ? "L" : "";
     auto multiplier = parent->access_buffer_range(0);
     for (int i = 1; i < dimensions; ++i) {
       ind += string_class(" + ") + std::move(rang_copy[i]) + " * " +
-             get_string<decltype(multiplier)>::get(multiplier);
+             get_string<decltype(multiplier)>::get(multiplier) + suffix;
       multiplier *= parent->access_buffer_range(i);
     }
-    auto resource_name = kernel_ns::register_resource(*parent);
-    return subscript_return_t(resource_name + "[" + ind + "]");
+    return element_ref<subscript_return_t>::get(resource_name, ind);
   }
 
  public:
@@ -9,7 +9,6 @@
 #include "SYCL/buffer.h"
 #include "SYCL/command_group.h"
 #include "SYCL/detail/common.h"
-#include "SYCL/detail/counter.h"
 #include "SYCL/ranges.h"
 
 namespace cl {
@@ -18,8 +17,7 @@ namespace sycl {
 namespace detail {
 
 SYCL_ACCESSOR_CLASS(target == access::target::local)
-, protected counter<accessor_detail<DataType, dimensions, mode, target>>,
-    public accessor_device_ref<dimensions, DataType, dimensions, mode, target> {
+, public accessor_device_ref<dimensions, DataType, dimensions, mode, target> {
  private:
   using base_acc_device_ref =
       accessor_device_ref<dimensions, DataType, dimensions, mode, target>;
@@ -34,8 +32,10 @@ SYCL_ACCESSOR_CLASS(target == access::target::local)
     return allocationSize.get(n);
   }
 
+  // Only identifies the accessor while the kernel is traced,
+  // arguments are ordered by first use
   virtual void* resource() const override {
-    return reinterpret_cast<void*>(this->get_count_id());  // NOLINT
+    return const_cast<accessor_detail*>(this);  // NOLINT
   }
 
   virtual ::size_t argument_size() const override {
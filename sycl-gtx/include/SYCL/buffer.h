@@ -11,6 +11,7 @@
 #include "SYCL/error_handler.h"
 #include "SYCL/event.h"
 #include "SYCL/info.h"
+#include "SYCL/mapped_file.h"
 #include "SYCL/param_traits.h"
 #include "SYCL/ranges.h"
 #include "SYCL/refc.h"
@@ -19,6 +20,15 @@
 namespace cl {
 namespace sycl {
 
+// Not part of the SYCL specification
+// How the elements of a buffer of structs are stored on the device
+enum class buffer_layout {
+  // As on the host
+  array_of_structs,
+  // Every field of the structs in a separate array
+  struct_of_arrays,
+};
+
 // Forward declarations
 template <typename, int, access::mode, access::target>
 class accessor;
@@ -50,11 +60,13 @@ class buffer_detail : public buffer_base {
   using ptr_t = shared_ptr_class<DataType>;
 
   range<dimensions> rang;
+  // Range of the host memory the elements are in,
+  // which is the range of the parent for sub-buffers
+  range<dimensions> host_range = rang;
   ptr_t host_data;
 
   bool is_read_only = false;
   bool is_blocking = true;
-  bool is_initialized = false;
 
   friend class accessor_base;
   friend class accessor_buffer<DataType_t, dimensions>;
@@ -71,6 +83,15 @@ class buffer_detail : public buffer_base {
   buffer_detail(std::nullptr_t host_data, range<dimensions> range)
       : buffer_detail(nullptr, range, false) {}
 
+  // The mapping is kept alive by the host data
+  buffer_detail(shared_ptr_class<void> mapping, range<dimensions> range)
+      : host_data(ptr_t(mapping, static_cast<DataType*>(mapping.get()))),
+        rang(range),
+        is_read_only(true),
+        is_blocking(false) {
+    is_file_backed = true;
+  }
+
  public:
   // Creates a new buffer with associated host memory.
   // The memory is owned by the runtime during the lifetime of the object.
@@ -129,30 +150,37 @@ class buffer_detail : public buffer_base {
   buffer_detail(unique_ptr_class<void>&& hostData,
                 const range<dimensions>& bufferRange);
 
-  // TODO(progtx):
   // Create a new sub-buffer without allocation to have separate accessors
   // later.
   // b is the buffer with the real data.
   // baseIndex specifies the origin of the sub-buffer inside the buffer b.
   // subRange specifies the size of the sub-buffer.
+  // Unless the sub-buffer spans whole rows or slices of b,
+  // its elements are packed on the device
+  // and copied from and to the host memory of b as a rectangle.
   buffer_detail(buffer_detail& b, const id<dimensions>& baseIndex,
                 const range<dimensions>& subRange)
       : rang(subRange),
+        host_range(b.host_range),
         is_read_only(b.is_read_only),
         is_blocking(b.is_blocking) {
-    DataType* start = b.host_data.get();
-
-    if (dimensions == 1) {
-      start += static_cast<::size_t>(baseIndex.get(0));
-    } else if (dimensions == 2) {
-      start += static_cast<::size_t>(baseIndex.get(1)) *
-                   static_cast<::size_t>(rang.get(0)) +
-               static_cast<::size_t>(baseIndex.get(0));
-    } else if (dimensions == 3) {
-      // TODO(progtx):
+    ::size_t offset = 0;
+    ::size_t stride = 1;
+    for (int i = 0; i < dimensions; ++i) {
+      offset += static_cast<::size_t>(baseIndex.get(i)) * stride;
+      stride *= extent(host_range, i);
+    }
+    // Shares the ownership of the memory of b
+    host_data = ptr_t(b.host_data, b.host_data.get() + offset);
+    host_version = b.host_version;
+
+    if (!is_contiguous()) {
+      auto element_size = data_size<DataType_t>::get();
+      rect_region = {{extent(rang, 0) * element_size, extent(rang, 1),
+                      extent(rang, 2)}};
+      host_row_pitch = extent(host_range, 0) * element_size;
+      host_slice_pitch = host_row_pitch * extent(host_range, 1);
     }
-
-    host_data = ptr_t(start, [](DataType* ptr) {});
   }
 
   // Creates a buffer from an existing OpenCL memory object associated to a
@@ -164,13 +192,29 @@ class buffer_detail : public buffer_base {
   buffer_detail(cl_mem mem_object, queue& from_queue,
                 event available_event = {});
 
+  // Not part of the SYCL specification
+  // Creates a read-only buffer whose host memory is a mapping of the file.
+  // Nothing is read until the first use on a device,
+  // which uploads the file in chunks as its pages are read.
+  // The host memory is not taken up twice, as with reading the file first.
+  buffer_detail(const mapped_file& file, const range<dimensions>& range)
+      : buffer_detail(file.map(range.size() * data_size<DataType_t>::get()),
+                      range) {}
+
   buffer_detail(const buffer_detail&) = default;
   buffer_detail(buffer_detail&&) noexcept = default;  // NOLINT
   buffer_detail& operator=(const buffer_detail&) = default;
   buffer_detail& operator=(buffer_detail&&) = default;  // NOLINT
 
   ~buffer_detail() {
-    event::wait_and_throw(events);
+    synchronizer::remove(this);
+    release_memory();
+    vector_class<event> pending;
+    {
+      std::lock_guard<mutex_class> lock(events_lock);
+      pending = events;
+    }
+    event::wait_and_throw(pending);
   }
 
   // Return a range object representing the size of the buffer
@@ -180,6 +224,37 @@ class buffer_detail : public buffer_base {
     return rang;
   }
 
+  // Number of elements in the dimension, one beyond the last dimension
+  static ::size_t extent(const range<dimensions>& r, int dimension) {
+    return (dimension < dimensions) ? static_cast<::size_t>(r.get(dimension))
+                                    : 1;
+  }
+
+  // The elements follow each other in host memory,
+  // which is the case unless the buffer is a sub-buffer
+  // that does not span whole rows or slices of its parent
+  bool is_contiguous() const {
+    int i = 0;
+    while (i < dimensions && extent(rang, i) == extent(host_range, i)) {
+      ++i;
+    }
+    for (++i; i < dimensions; ++i) {
+      if (extent(rang, i) != 1) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // Bytes from the first to the end of the last element in host memory
+  ::size_t get_host_size() const {
+    if (!is_strided()) {
+      return get_size();
+    }
+    return (rect_region[2] - 1) * host_slice_pitch +
+           (rect_region[1] - 1) * host_row_pitch + rect_region[0];
+  }
+
   // Total number of elements in the buffer
   ::size_t get_count() const {
     ::size_t count = rang.get(0);
@@ -194,23 +269,81 @@ class buffer_detail : public buffer_base {
     return get_count() * data_size<DataType_t>::get();
   }
 
+  // Not part of the SYCL specification
+  // Stores every field of a struct registered with SYCL_STRUCT
+  // as a separate array on the device,
+  // so that work items accessing the same field of consecutive elements
+  // access consecutive memory.
+  // Host accessors and kernels still access the elements as structs.
+  // Has to be set before the buffer is first used on a device,
+  // and is not available for sub-buffers copied as rectangles.
+  void set_layout(buffer_layout layout) {
+    static_assert(struct_layout<DataType_t>::is_struct,
+                  "Only buffers of structs registered with SYCL_STRUCT "
+                  "can change their layout");
+    std::lock_guard<mutex_class> lock(events_lock);
+    if (is_initialized || is_strided()) {
+      detail::error::report(CL_INVALID_OPERATION);
+      return;
+    }
+    if (layout == buffer_layout::struct_of_arrays) {
+      set_soa_layout(struct_layout<DataType_t>::members(),
+                     data_size<DataType_t>::get(), get_count());
+    } else {
+      soa_arrays.clear();
+      soa_data.reset();
+    }
+  }
+
+  buffer_layout get_layout() const {
+    return soa_arrays.empty() ? buffer_layout::array_of_structs
+                              : buffer_layout::struct_of_arrays;
+  }
+
+  // Bytes taken by the buffer on the device
+  ::size_t get_device_size() const {
+    return soa_arrays.empty() ? get_size() : soa_size;
+  }
+
  private:
   static void create(queue* q, const vector_class<cl_event>& wait_events,
                      buffer_detail* buffer) {
+    std::lock_guard<mutex_class> lock(buffer->events_lock);
+    if (buffer->is_initialized) {
+      // Created by a command group traced at the same time
+      return;
+    }
     ::cl_int error_code;
+    // The device uses the transposed copy of the structs,
+    // the packed rows of a strided sub-buffer have no host memory
+    void* host_ptr = buffer->host_data.get();
+    if (!buffer->soa_arrays.empty()) {
+      host_ptr = buffer->soa_data.get();
+    } else if (buffer->is_strided()) {
+      host_ptr = nullptr;
+    }
     const cl_mem_flags all_flags =
-        ((buffer->host_data == nullptr) ? 0 : CL_MEM_USE_HOST_PTR) |
+        ((host_ptr == nullptr) ? 0 : CL_MEM_USE_HOST_PTR) |
         (buffer->is_read_only ? CL_MEM_READ_ONLY : CL_MEM_READ_WRITE);
-    buffer->device_data = buffer_base::cl_create_buffer(
-        q, all_flags, buffer->get_size(), buffer->host_data.get(), error_code);
+    // A strided sub-buffer is restored from the host memory of its parent,
+    // so it is accounted for and can be evicted like any other buffer
+    buffer->device_data = buffer->cl_create_buffer(
+        q, all_flags, buffer->get_device_size(), host_ptr,
+        buffer->host_data != nullptr, error_code);
     detail::error::report(error_code);
     buffer->device_data.release_one();
+    buffer->is_initialized = true;
   }
 
+  // Command groups traced concurrently may all schedule the creation,
+  // only the first one to be flushed allocates the device memory.
+  // Pinned under the lock used for evictions,
+  // so the memory stays allocated until the group is flushed.
   void init() {
+    std::lock_guard<mutex_class> lock(events_lock);
+    command::group_detail::add_buffer_pin(this);
     if (!is_initialized) {
       command::group_detail::add_buffer_init(create, __func__, this);
-      is_initialized = true;
     }
   }
 
@@ -265,7 +398,9 @@ class buffer_detail : public buffer_base {
     auto error_code = this->cl_enqueue_buffer(
         q, get_size(), host_data.get(), wait_events, evnt, clEnqueueBuffer);
     detail::error::report(error_code);
+    std::lock_guard<mutex_class> lock(events_lock);
     events.emplace_back(evnt);
+    set_transferred(clEnqueueBuffer == &clEnqueueWriteBuffer);
   }
 
  protected:
@@ -301,7 +436,9 @@ class buffer_detail : public buffer_base {
          const range<dimensions>& subRange)                                \
       : Base(b, baseIndex, subRange) {}                                    \
   buffer(cl_mem mem_object, queue& from_queue, event available_event = {}) \
-      : Base(mem_object, from_queue, available_event) {}
+      : Base(mem_object, from_queue, available_event) {}                   \
+  buffer(const mapped_file& file, const range<dimensions>& range)          \
+      : Base(file, range) {}
 #endif
 
 template <typename DataType_t>
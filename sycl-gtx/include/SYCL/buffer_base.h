@@ -2,7 +2,10 @@
 
 #include "SYCL/detail/common.h"
 #include "SYCL/detail/debug.h"
+#include "SYCL/detail/logger.h"
 #include "SYCL/event.h"
+#include <array>
+#include <set>
 
 namespace cl {
 namespace sycl {
@@ -14,25 +17,118 @@ namespace detail {
 
 // Forward declarations
 class issue_command;
+class memory_manager;
 namespace command {
 class group_detail;
 }
 
+// Field of a struct buffer stored as a separate array on the device
+struct soa_array {
+  field_info field;
+  // Start of the array in the device memory
+  ::size_t offset;
+};
+
 class buffer_base {
  protected:
   friend class issue_command;
   friend class ::cl::sycl::queue;
   friend class command::group_detail;
+  friend class buffer_pins;
+  friend class memory_manager;
+
+  using clEnqueueBuffer_f = decltype(&clEnqueueWriteBuffer);
+
+  // Names the buffer in the profile, unlike its address it is never reused.
+  // Copies of the buffer share it.
+  ::size_t buffer_id = next_id();
+  static ::size_t next_id();
 
   detail::refc<cl_mem, clRetainMemObject, clReleaseMemObject> device_data;
   vector_class<event> events;
+  // Guards device_data creation and events,
+  // because a buffer can be used by several queues at once.
+  member_mutex events_lock;
+  bool is_initialized = false;
+  // The host memory is a mapped file that never changes,
+  // so it is uploaded only once after each allocation
+  bool is_file_backed = false;
+  // Completes when the file is on the device
+  event uploaded;
+
+  // Counts the changes of the host memory,
+  // shared with the copies and sub-buffers using the same memory
+  shared_ptr_class<std::atomic<unsigned int>> host_version =
+      std::make_shared<std::atomic<unsigned int>>(1);
+  // Version of the host memory the device memory holds,
+  // zero while the device memory differs from it.
+  // Guarded by events_lock.
+  unsigned int device_version = 0;
+
+  bool is_device_current() const {
+    return device_version == *host_version;
+  }
+  // A readback changes the host memory to the device memory.
+  // Called with events_lock held after the transfer is enqueued.
+  void set_transferred(bool is_upload) {
+    device_version = is_upload ? host_version->load() : ++*host_version;
+  }
+  // Called once a host accessor that could write is done
+  void host_changed() {
+    ++*host_version;
+  }
+
+  // Command groups using the buffer that were not flushed yet
+  member_atomic<unsigned int> pins;
+  // Stamped by the memory manager on every use
+  member_atomic<cl_ulong> last_use;
+  // Set while the device memory is accounted for
+  shared_ptr_class<memory_manager> memory;
+
+  // With the struct of arrays layout,
+  // every field of the structs is stored as a separate array on the device.
+  // Transfers go through a copy of the device memory on the host,
+  // transposed from and into the host structs.
+  vector_class<soa_array> soa_arrays;
+  shared_ptr_class<char> soa_data;
+  ::size_t soa_size = 0;
+  ::size_t soa_count = 0;
+  ::size_t soa_element_size = 0;
+
+  // A sub-buffer of a multi-dimensional buffer
+  // whose rows or slices are not contiguous in the host memory of its parent.
+  // Its device memory is compact, transfers copy the rectangle,
+  // rect_region being its size in bytes, rows and slices.
+  std::array<::size_t, 3> rect_region = {{0, 0, 0}};
+  ::size_t host_row_pitch = 0;
+  ::size_t host_slice_pitch = 0;
+
+  bool is_strided() const {
+    return host_row_pitch != 0;
+  }
+  ::cl_int cl_enqueue_rect(queue* q, void* host_ptr,
+                           const vector_class<cl_event>& wait_events,
+                           cl_event& evnt, clEnqueueBuffer_f clEnqueueBuffer);
+
+  void set_soa_layout(const vector_class<field_info>& fields,
+                      ::size_t element_size, ::size_t count);
+  void to_soa(const void* host_ptr);
+  void from_soa(void* host_ptr);
+  ::cl_int cl_enqueue_soa(queue* q, void* host_ptr,
+                          const vector_class<cl_event>& wait_events,
+                          cl_event& evnt, clEnqueueBuffer_f clEnqueueBuffer);
+
+  // Releases the device memory once the pending commands finish,
+  // the next use creates it again.
+  // Called by the memory manager with events_lock held.
+  void evict();
+  void release_memory();
 
   void create_accessor_command();
 
-  using clEnqueueBuffer_f = decltype(&clEnqueueWriteBuffer);
   virtual void enqueue(queue* q, const vector_class<cl_event>& wait_events,
                        clEnqueueBuffer_f clEnqueueBuffer) {
-    DSELF() << "not implemented";
+    SYCL_LOG(warning, buffer, "not implemented");
   }
   static void enqueue_command(queue* q,
                               const vector_class<cl_event>& wait_events,
@@ -43,10 +139,34 @@ class buffer_base {
   ::cl_int cl_enqueue_buffer(queue* q, ::size_t size, void* host_ptr,
                              const vector_class<cl_event>& wait_events,
                              cl_event& evnt, clEnqueueBuffer_f clEnqueueBuffer);
+  ::cl_int cl_upload_once(queue* q, ::size_t size, void* host_ptr,
+                          const vector_class<cl_event>& wait_events,
+                          cl_event& evnt);
+
+  // Only buffers with host data count against the memory budget,
+  // the data of others could not be restored after an eviction
+  cl_mem cl_create_buffer(queue* q, const cl_mem_flags& flags, ::size_t size,
+                          void* host_ptr, bool has_host_data,
+                          ::cl_int& error_code);
+};
+
+// Pins buffers while a command group uses them,
+// so that the memory manager does not evict them before the group is flushed.
+// A copy of a command group pins the buffers again.
+class buffer_pins {
+ private:
+  std::set<buffer_base*> buffers;
+
+ public:
+  buffer_pins() = default;
+  buffer_pins(const buffer_pins& copy);
+  buffer_pins(buffer_pins&& move) noexcept;
+  buffer_pins& operator=(buffer_pins other) noexcept;
+  ~buffer_pins();
 
-  static cl_mem cl_create_buffer(queue* q, const cl_mem_flags& flags,
-                                 ::size_t size, void* host_ptr,
-                                 ::cl_int& error_code);
+  // Also marks the buffer as used
+  void add(buffer_base* buf);
+  void clear();
 };
 
 }  // namespace detail
@@ -6,6 +6,7 @@
 #include "SYCL/buffer_base.h"
 #include "SYCL/detail/common.h"
 #include "SYCL/detail/debug.h"
+#include "SYCL/handler_event.h"
 #include "SYCL/ranges.h"
 #include <set>
 
@@ -21,7 +22,9 @@ class queue;
 namespace detail {
 
 // Forward declarations
-static inline unique_ptr_class<handler> get_handler(queue* q);
+class build_result;
+static inline unique_ptr_class<handler> get_handler(
+    queue* q, const handler_event& events);
 template <typename, int>
 class buffer_detail;
 
@@ -30,26 +33,33 @@ namespace command {
 // Forward declaration
 class group_detail;
 
-enum class type_t { unspecified, get_accessor, copy_data, kernel };
+enum class type_t {
+  unspecified,
+  get_accessor,
+  copy_data,
+  kernel,
+  // Fill or copy done by the device, writes the buffer in the metadata
+  device_write
+};
 
-static debug& operator<<(debug& d, type_t t) {
-  string_class str("command::type::");
+static const char* log_name(type_t t) {
   switch (t) {
     case type_t::get_accessor:
-      str += "get_accessor";
-      break;
+      return "command::type::get_accessor";
     case type_t::copy_data:
-      str += "copy_data";
-      break;
+      return "command::type::copy_data";
     case type_t::kernel:
-      str += "kernel";
-      break;
+      return "command::type::kernel";
+    case type_t::device_write:
+      return "command::type::device_write";
     case type_t::unspecified:
     default:
-      str += "unspecified";
-      break;
+      return "command::type::unspecified";
   }
-  d << str;
+}
+
+static debug& operator<<(debug& d, type_t t) {
+  d << log_name(t);
   return d;
 }
 
@@ -96,6 +106,10 @@ class command_group {
   vector_class<command_t> commands;
   std::set<buffer_base*> read_buffers;
   std::set<buffer_base*> write_buffers;
+  // Released once the commands are enqueued
+  buffer_pins pins;
+  vector_class<shared_ptr_class<build_result>> builds;
+  handler_event events;
   queue* q;
 
   void enter();
@@ -107,7 +121,7 @@ class command_group {
   template <typename functorT>
   command_group(functorT lambda) : q(nullptr) {
     enter();
-    auto cgh = get_handler(q);
+    auto cgh = get_handler(q, events);
     lambda(*cgh);
     exit();
   }
@@ -119,7 +133,7 @@ class command_group {
   template <typename functorT>
   command_group(queue& primaryQueue, functorT lambda) : q(&primaryQueue) {
     enter();
-    auto cgh = get_handler(q);
+    auto cgh = get_handler(q, events);
     lambda(*cgh);
     exit();
   }
@@ -135,6 +149,17 @@ class command_group {
   template <typename functorT>
   command_group(queue& primaryQueue, queue& secondaryQueue, functorT lambda);
 
+  // True when all kernel programs of the group are done building,
+  // successfully or not
+  bool is_build_done() const;
+
+  // Blocks until all kernel programs of the group are built.
+  // Returns the error of the first failed build without throwing.
+  ::cl_int wait_for_builds() const;
+
+  // Discards the commands of a group whose kernels failed to build
+  void drop();
+
   void optimize();
   void flush(vector_class<cl_event> wait_events);
 };
@@ -145,7 +170,7 @@ class group_detail {
  private:
   friend class ::cl::sycl::detail::command_group;
 
-  // TODO(progtx): Need to deal better with threads
+  // Each host thread traces its own command group
   SYCL_THREAD_LOCAL static command_group* last;
 
   template <class... Args>
@@ -193,12 +218,23 @@ class group_detail {
 
   static void add_buffer_access(buffer_access buf_acc, string_class name);
 
+  // Keeps the device memory of the buffer until the group is flushed
+  static void add_buffer_pin(buffer_base* buf);
+
+  static void add_build(shared_ptr_class<build_result> build);
+
   static void add_buffer_copy(
       buffer_access buf_acc, access::mode copy_mode,
       fn<buffer_base*, buffer_base::clEnqueueBuffer_f> function,
       string_class name, buffer_base* buffer,
       buffer_base::clEnqueueBuffer_f enqueue_function);
 
+  // The command writes the buffer on the device,
+  // so it has to wait for everything enqueued before on the buffer
+  static void add_device_write(buffer_access buf_acc,
+                               info::command_f function,
+                               string_class name);
+
   static bool in_scope();
   static void check_scope();
 
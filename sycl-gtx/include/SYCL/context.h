@@ -3,7 +3,9 @@
 // 3.3.3 Context class
 
 #include "SYCL/detail/common.h"
+#include "SYCL/detail/counters.h"
 #include "SYCL/detail/debug.h"
+#include "SYCL/detail/memory_manager.h"
 #include "SYCL/device.h"
 #include "SYCL/device_selector.h"
 #include "SYCL/error_handler.h"
@@ -31,7 +33,11 @@ class context {
   detail::refc<cl_context, clRetainContext, clReleaseContext> ctx;
   vector_class<device> target_devices;
   async_handler asyncHandler;
+  shared_ptr_class<detail::counters> stats;
+  shared_ptr_class<detail::memory_manager> memory;
   friend struct detail::error::thrower;
+  friend class detail::counters;
+  friend class detail::memory_manager;
 
   // Master constructor
   context(cl_context c, const async_handler& asyncHandler,
@@ -75,12 +81,16 @@ class context {
   context(context&& move)
       : SYCL_MOVE_INIT(ctx),
         SYCL_MOVE_INIT(target_devices),
-        SYCL_MOVE_INIT(asyncHandler) {}
+        SYCL_MOVE_INIT(asyncHandler),
+        SYCL_MOVE_INIT(stats),
+        SYCL_MOVE_INIT(memory) {}
   friend void swap(context& first, context& second) {
     using std::swap;
     SYCL_SWAP(ctx);
     SYCL_SWAP(target_devices);
     SYCL_SWAP(asyncHandler);
+    SYCL_SWAP(stats);
+    SYCL_SWAP(memory);
   }
 #else
   context(context&&) = default;             // NOLINT
@@ -101,6 +111,32 @@ class context {
   // Returns the set of devices that are part of this context.
   vector_class<device> get_devices() const;
 
+  // Not part of the SYCL specification
+  // Returns a runtime counter, shared by all context objects
+  // that use the same cl_context.
+  template <info::counter param>
+  typename param_traits<info::counter, param>::type get_counter() const {
+    return stats->get(param);
+  }
+
+  // Not part of the SYCL specification
+  // Sets all runtime counters of the context to zero
+  void reset_counters();
+
+  // Not part of the SYCL specification
+  // Limits the device memory used by the buffers of the context,
+  // shared by all context objects that use the same cl_context.
+  // Least recently used buffers are evicted on the next allocation
+  // that exceeds the budget.
+  // Zero restores the default, which is the SYCL_GTX_MEMORY_BUDGET
+  // environment variable or the global memory size of the device.
+  void set_memory_budget(::size_t bytes);
+  ::size_t get_memory_budget() const;
+
+  // Not part of the SYCL specification
+  // Bytes of device memory currently allocated for buffers of the context
+  ::size_t get_memory_usage() const;
+
  private:
   template <class Contained_t, info::context param,
             ::size_t BufferSize_v =
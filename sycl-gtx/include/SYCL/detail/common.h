@@ -8,6 +8,7 @@
 #endif
 #include "SYCL/detail/msvc_version.h"
 
+#include <atomic>
 #include <cstdio>
 #include <sstream>
 
@@ -102,6 +103,30 @@ using weak_ptr_class = ::std::weak_ptr<T>;
 
 namespace detail {
 
+// Mutex that can be a member of copyable and movable classes.
+// Every copy gets its own lock, which is never transferred.
+class member_mutex : public mutex_class {
+ public:
+  member_mutex() = default;
+  member_mutex(const member_mutex&) : mutex_class() {}
+  member_mutex& operator=(const member_mutex&) {
+    return *this;
+  }
+};
+
+// Atomic that can be a member of copyable and movable classes.
+// Like with member_mutex, every copy starts from the default value.
+template <class T>
+class member_atomic : public std::atomic<T> {
+ public:
+  member_atomic() : std::atomic<T>(T()) {}
+  member_atomic(const member_atomic&) : member_atomic() {}
+  member_atomic& operator=(const member_atomic&) {
+    return *this;
+  }
+  using std::atomic<T>::operator=;
+};
+
 // http://stackoverflow.com/a/3418285
 static bool string_replace_one(string_class& str, const string_class& from,
                                const string_class& to) {
@@ -179,6 +204,25 @@ struct data_size {
   }
 };
 
+// Field of a struct registered with SYCL_STRUCT
+struct field_info {
+  string_class name;
+  string_class type_name;
+  ::size_t size;
+  // Offset in the host struct
+  ::size_t offset;
+};
+
+// Layout of a type in kernels, specialized by SYCL_STRUCT
+template <typename T>
+struct struct_layout {
+  static const bool is_struct = false;
+  // Scalars and vectors are aligned to their size
+  static const ::size_t alignment = sizeof(T);
+  // Adds the definitions the type needs to the kernel
+  static void declare() {}
+};
+
 template <typename DataType>
 struct base_host_data {
   using type = DataType;
@@ -0,0 +1,101 @@
+#pragma once
+
+// Background compilation of kernel programs
+
+#include "SYCL/context.h"
+#include "SYCL/detail/common.h"
+#include "SYCL/detail/counters.h"
+#include "SYCL/detail/kernel_binding.h"
+#include "SYCL/device.h"
+#include "SYCL/refc.h"
+#include <condition_variable>
+#include <map>
+#include <tuple>
+
+namespace cl {
+namespace sycl {
+namespace detail {
+
+// Forward declaration
+class compiler;
+
+// State of a program build, shared by all kernels with the same source
+class build_result {
+ private:
+  friend class compiler;
+  using listener_f = function_class<void()>;
+
+  mutable mutex_class lock;
+  mutable std::condition_variable finished;
+  bool done = false;
+  ::cl_int error_code = CL_SUCCESS;
+  refc<cl_program, clRetainProgram, clReleaseProgram> prog;
+  vector_class<device> devices;
+  vector_class<listener_f> listeners;
+  // Kernel objects are created once and reused by every launch
+  std::map<string_class, shared_ptr_class<kernel_binding>> kernels;
+  // Only kept in extraction mode
+  string_class code;
+  // Host time when the build started
+  cl_ulong start_time = 0;
+  shared_ptr_class<counters> stats;
+
+  void finish(::cl_int build_error_code);
+  void finish_from_status();
+  void report_build_log() const;
+
+ public:
+  // True once the build has finished, successfully or not
+  bool is_done() const;
+
+  // True once the program was built without errors
+  bool is_built() const;
+
+  // Blocks until the build is done and returns its error code.
+  // Never throws, so it is safe to call while a queue is destroyed.
+  ::cl_int wait() const;
+
+  // Blocks until the build is done.
+  // Build errors are thrown from here.
+  cl_program get() const;
+
+  // Calls the listener on a background thread after the build is done.
+  // Returns false without registering the listener if it is done already.
+  bool on_done(listener_f listener);
+
+  // Blocks until the build is done,
+  // then returns the kernel object with the given name.
+  shared_ptr_class<kernel_binding> get_kernel(const string_class& name);
+};
+
+// Builds programs on a pool of background threads.
+// Programs are cached by context, devices, options and source,
+// so each distinct kernel is built only once.
+// Failed builds are cached too, the same source would fail again.
+class compiler {
+ private:
+  using key_t = std::tuple<cl_context, vector_class<cl_device_id>,
+                           string_class, string_class>;
+
+  static std::map<key_t, shared_ptr_class<build_result>> programs;
+  static mutex_class programs_lock;
+
+  static void run(build_result* result, context ctx, string_class code,
+                  string_class options);
+  static cl_program create_program(build_result* result, const context& ctx,
+                                   const string_class& code);
+  static void CL_CALLBACK notify(cl_program prog, void* user_data);
+  static void notify_listeners(vector_class<build_result::listener_f> list);
+
+  friend class build_result;
+
+ public:
+  // Returns immediately, the build continues in the background
+  static shared_ptr_class<build_result> build(
+      const context& ctx, const vector_class<device>& devices,
+      const string_class& code, const string_class& options);
+};
+
+}  // namespace detail
+}  // namespace sycl
+}  // namespace cl
@@ -0,0 +1,44 @@
+#pragma once
+
+// Runtime state shared per OpenCL context
+
+#include "SYCL/detail/common.h"
+#include <map>
+
+namespace cl {
+namespace sycl {
+namespace detail {
+
+// Maps each cl_context to an object shared by all context objects wrapping it.
+// The object lives as long as one of those context objects holds it.
+template <class T>
+class context_registry {
+ private:
+  std::map<cl_context, weak_ptr_class<T>> entries;
+  mutex_class lock;
+
+ public:
+  shared_ptr_class<T> find(cl_context ctx) {
+    std::lock_guard<mutex_class> guard(lock);
+    auto& entry = entries[ctx];
+    auto object = entry.lock();
+    if (object == nullptr) {
+      object = std::make_shared<T>();
+      entry = object;
+    }
+
+    // Drops the entries of destroyed contexts
+    for (auto it = entries.begin(); it != entries.end();) {
+      if (it->second.expired()) {
+        it = entries.erase(it);
+      } else {
+        ++it;
+      }
+    }
+    return object;
+  }
+};
+
+}  // namespace detail
+}  // namespace sycl
+}  // namespace cl
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "SYCL/detail/common.h"
+#include <atomic>
 
 namespace cl {
 namespace sycl {
@@ -11,7 +12,7 @@ using counter_t = unsigned int;
 template <class T, counter_t start = 0>
 class counter {
  private:
-  static counter_t internal_count;
+  static std::atomic<counter_t> internal_count;
   counter_t counter_id;
 
  public:
@@ -38,7 +39,7 @@ class counter {
 };
 
 template <class T, counter_t start>
-counter_t counter<T, start>::internal_count = start;
+std::atomic<counter_t> counter<T, start>::internal_count(start);
 
 }  // namespace detail
 }  // namespace sycl
@@ -0,0 +1,70 @@
+#pragma once
+
+// Always-on runtime counters
+
+#include "SYCL/detail/common.h"
+#include "SYCL/detail/context_registry.h"
+#include "SYCL/info.h"
+#include <atomic>
+
+namespace cl {
+namespace sycl {
+
+// Forward declarations
+class context;
+class queue;
+
+namespace detail {
+
+// Counts what the runtime does in a context:
+// transfers, allocations, program builds, kernel launches and waits.
+// All context objects wrapping the same cl_context share the counters.
+// They are updated with relaxed atomics and read one by one,
+// so counters read while commands are being enqueued may not add up.
+class counters {
+ private:
+  static const ::size_t num_counters =
+      static_cast<::size_t>(info::counter::wait_time) + 1;
+
+  std::atomic<cl_ulong> values[num_counters];
+
+  static context_registry<counters> registry;
+
+ public:
+  // Adds the elapsed host time to a counter when going out of scope,
+  // does nothing without counters
+  class timer {
+   private:
+    counters* stats;
+    info::counter param;
+    cl_ulong start;
+
+   public:
+    timer(counters* stats, info::counter param);
+    ~timer();
+  };
+
+  counters();
+
+  // Returns the counters shared by all contexts wrapping the cl_context
+  static shared_ptr_class<counters> find(cl_context ctx);
+
+  static const shared_ptr_class<counters>& get(const context& ctx);
+  static const shared_ptr_class<counters>& get(queue* q);
+
+  void add(info::counter param, cl_ulong value = 1) {
+    values[static_cast<::size_t>(param)].fetch_add(value,
+                                                   std::memory_order_relaxed);
+  }
+
+  cl_ulong get(info::counter param) const {
+    return values[static_cast<::size_t>(param)].load(
+        std::memory_order_relaxed);
+  }
+
+  void reset();
+};
+
+}  // namespace detail
+}  // namespace sycl
+}  // namespace cl
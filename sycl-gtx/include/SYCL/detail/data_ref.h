@@ -1,6 +1,7 @@
 #pragma once
 
 #include "SYCL/detail/common.h"
+#include "SYCL/detail/counter.h"
 #include "SYCL/detail/debug.h"
 #include <type_traits>
 
@@ -15,8 +16,9 @@ struct id;
 
 namespace detail {
 
-// Forward declaration
+// Forward declarations
 void kernel_add(string_class line);
+counter_t kernel_temporary_id();
 
 class data_ref {
  public:
@@ -38,11 +40,13 @@ class data_ref {
     return dref.name;
   }
 
+  // Unsigned literals need a suffix, large values would otherwise be a long
   template <
       typename T,
       typename std::enable_if<std::is_arithmetic<T>::value>::type* = nullptr>
   static string_class get_name(const T& n) {
-    return get_string<T>::get(n);
+    return get_string<T>::get(n) +
+           (std::is_same<T, unsigned int>::value ? "u" : "");
   }
 
   template <typename T,
@@ -171,6 +175,17 @@ class data_ref {
   data_ref operator!() const {
     return data_ref(open_parenthesis + '!' + name + ')');
   }
+  data_ref operator~() const {
+    return data_ref(open_parenthesis + '~' + name + ')');
+  }
+  data_ref operator-() const {
+    // Negative literals would otherwise become a decrement
+    return data_ref(open_parenthesis + (name[0] == '-' ? "- " : "-") + name +
+                    ')');
+  }
+  data_ref operator+() const {
+    return data_ref(name);
+  }
 };
 
 }  // namespace detail
@@ -99,7 +99,8 @@ struct code {
     NOT_IN_COMMAND_GROUP_SCOPE,
     TRYING_TO_WRITE_READ_ONLY_BUFFER,
     BUFFER_NOT_INITIALIZED,
-    NOT_IN_KERNEL_SCOPE
+    NOT_IN_KERNEL_SCOPE,
+    FILE_MAPPING_FAILURE
   };
 };
 
@@ -112,6 +113,7 @@ static const std::map<code::value_t, string_class> codes = {
     SYCL_ADD_ERROR(code::TRYING_TO_WRITE_READ_ONLY_BUFFER),
     SYCL_ADD_ERROR(code::BUFFER_NOT_INITIALIZED),
     SYCL_ADD_ERROR(code::NOT_IN_KERNEL_SCOPE),
+    SYCL_ADD_ERROR(code::FILE_MAPPING_FAILURE),
 };
 
 }  // namespace error
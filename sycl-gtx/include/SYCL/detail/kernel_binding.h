@@ -0,0 +1,45 @@
+#pragma once
+
+// Shadow copy of the arguments bound to an OpenCL kernel object
+
+#include "SYCL/detail/common.h"
+#include "SYCL/refc.h"
+
+namespace cl {
+namespace sycl {
+namespace detail {
+
+// OpenCL kernel object together with the argument values last bound to it.
+// Kernels with the same source share one kernel object,
+// so only the arguments that changed since the previous launch are set.
+class kernel_binding {
+ private:
+  struct argument {
+    bool is_set = false;
+    ::size_t size = 0;
+    // Empty for local memory arguments
+    vector_class<char> value;
+  };
+
+  refc<cl_kernel, clRetainKernel, clReleaseKernel> kern;
+  vector_class<argument> args;
+
+ public:
+  // Held from setting the arguments until the kernel is enqueued,
+  // the kernel object can be launched from multiple threads
+  mutex_class lock;
+
+  explicit kernel_binding(cl_kernel k) : kern(k) {}
+
+  cl_kernel get() const {
+    return kern.get();
+  }
+
+  // Calls clSetKernelArg unless the same value is already bound.
+  // A null value allocates local memory of the given size.
+  void set_arg(::cl_uint index, ::size_t size, const void* value);
+};
+
+}  // namespace detail
+}  // namespace sycl
+}  // namespace cl
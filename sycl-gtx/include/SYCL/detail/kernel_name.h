@@ -1,6 +1,9 @@
 #pragma once
 
+#include "SYCL/detail/common.h"
+#include <atomic>
 #include <cstddef>
+#include <typeinfo>
 
 namespace cl {
 namespace sycl {
@@ -9,32 +12,27 @@ namespace detail {
 
 class kernel_name {
  private:
-  static ::size_t current_count;
+  static std::atomic<::size_t> current_count;
 
-  template <class T>
-  struct namer {
-    static ::size_t id;
-    static bool is_set;
-    static void set() {
-      if (!is_set) {
-        id = ++current_count;
-        is_set = true;
-      }
-    }
-  };
+  static string_class demangle_pointer(const char* name);
 
  public:
+  // Each kernel type is named exactly once,
+  // even when first seen by several threads at the same time.
   template <class T>
   static ::size_t get() {
-    namer<T>::set();
-    return namer<T>::id;
+    static const ::size_t id = ++current_count;
+    return id;
   }
-};
 
-template <class T>
-::size_t kernel_name::namer<T>::id = 0;
-template <class T>
-bool kernel_name::namer<T>::is_set = false;
+  // Readable name of the kernel type, used for profiling.
+  // Kernel names are usually incomplete types, only pointers to them
+  // can be passed to typeid.
+  template <class T>
+  static string_class display() {
+    return demangle_pointer(typeid(T*).name());
+  }
+};
 
 }  // namespace detail
 
@@ -0,0 +1,101 @@
+#pragma once
+
+// Ahead-of-time kernel extraction and embedded kernel artifacts
+
+#include "SYCL/detail/common.h"
+#include <initializer_list>
+#include <map>
+
+namespace cl {
+namespace sycl {
+
+// Forward declarations
+class context;
+class device;
+class program;
+
+namespace detail {
+
+// Kernels are only known after the host program traced them.
+// In extraction mode the runtime writes every kernel it builds
+// to a directory, as <hash>.cl and optionally <hash>.<device>.bin files.
+// The add_kernel_extraction CMake function embeds these files
+// into another executable, which registers them at startup.
+// Programs with the same source are then created from the embedded binary
+// instead of being compiled again.
+class kernel_store {
+ public:
+  using extract_f = function_class<void(program&)>;
+
+  struct binary {
+    const char* device_name;
+    const unsigned char* data;
+    ::size_t size;
+  };
+
+  // Registers an embedded kernel, used by the generated source
+  struct registrar {
+    registrar(const unsigned char* code, ::size_t size,
+              std::initializer_list<binary> binaries);
+  };
+
+  // Registers a kernel functor that is compiled in extraction mode,
+  // see SYCL_EXTRACT_KERNEL
+  struct functor_registrar {
+    explicit functor_registrar(extract_f extract);
+  };
+
+ private:
+  struct artifact {
+    std::map<string_class, binary> binaries;
+  };
+
+  static std::map<string_class, artifact>& artifacts();
+  static vector_class<extract_f>& functors();
+  static string_class& directory();
+  static bool& with_binaries();
+
+ public:
+  // Extraction mode is enabled by the SYCL_GTX_EXTRACT_DIR environment
+  // variable, binaries are also written if SYCL_GTX_EXTRACT_BINARIES is set.
+  static void extract_to(string_class dir, bool binaries = false);
+  static bool is_extracting();
+
+  // Builds the registered kernel functors and waits for them,
+  // once per process
+  static void extract_registered(const context& ctx);
+
+  // Called by the runtime for each kernel it compiles
+  static void extract(const string_class& code);
+  static void extract(const string_class& code, cl_program prog);
+
+  // Returns the embedded binaries of the kernel for all the devices,
+  // or an empty list if any of them is missing.
+  static vector_class<binary> find(const string_class& code,
+                                   const vector_class<device>& devices);
+
+  // Stable name of the kernel source, used for the extracted files
+  static string_class hash(const string_class& code);
+
+  // Device name reduced to characters allowed in file names
+  static string_class device_name(const device& dev);
+};
+
+}  // namespace detail
+}  // namespace sycl
+}  // namespace cl
+
+#define SYCL_EXTRACT_KERNEL_CONCAT(a, b) a##b
+#define SYCL_EXTRACT_KERNEL_NAME(line) \
+  SYCL_EXTRACT_KERNEL_CONCAT(sycl_extract_kernel_, line)
+
+// Registers a kernel functor with a public default constructor
+// for ahead-of-time extraction at namespace scope.
+// The functor is built like a submitted kernel,
+// so its binaries are extracted as well.
+#define SYCL_EXTRACT_KERNEL(kernelT)                               \
+  static const ::cl::sycl::detail::kernel_store::functor_registrar \
+  SYCL_EXTRACT_KERNEL_NAME(__LINE__)([](::cl::sycl::program& p) {  \
+    p.build_from_kernel_name_async<kernelT>();                     \
+    p.get_kernel<kernelT>();                                       \
+  })
@@ -0,0 +1,219 @@
+#pragma once
+
+// Leveled and categorized logging into a ring buffer
+
+#include "SYCL/detail/common.h"
+#include "SYCL/detail/debug.h"
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <iosfwd>
+#include <type_traits>
+
+// Records the arguments if the level is enabled for the category.
+// When it isn't, the arguments are not evaluated
+// and the cost is a single branch.
+#define SYCL_LOG(level, category, ...)                                  \
+  do {                                                                  \
+    if (SYCL_LOG_ENABLED(level, category)) {                            \
+      ::cl::sycl::detail::logger::write(                                \
+          ::cl::sycl::detail::logger::level_t::level,                   \
+          ::cl::sycl::detail::logger::category_t::category, __func__,   \
+          __VA_ARGS__);                                                 \
+    }                                                                   \
+  } while (false)
+
+#define SYCL_LOG_ENABLED(level, category)         \
+  ::cl::sycl::detail::logger::is_enabled(         \
+      ::cl::sycl::detail::logger::level_t::level, \
+      ::cl::sycl::detail::logger::category_t::category)
+
+namespace cl {
+namespace sycl {
+namespace detail {
+
+// Log records are kept in a fixed size ring buffer that writers never block.
+// Arguments are copied as they are and only formatted when the log is dumped.
+// The SYCL_GTX_LOG environment variable sets the level
+// and optionally the categories, e.g. "trace" or "info:sync,command".
+// When it is set, the log is written to the standard error at exit.
+// By default, errors and warnings are recorded in all categories.
+class logger {
+ public:
+  enum class level_t : unsigned int { error, warning, info, trace };
+  enum class category_t : unsigned int {
+    general,
+    sync,
+    command,
+    kernel,
+    build,
+    buffer,
+    queue
+  };
+
+  static const unsigned int num_categories = 8;
+  static const std::uint32_t all_categories = (1u << num_categories) - 1;
+
+  // Argument stored without formatting
+  struct argument {
+    enum class kind_t : unsigned char {
+      signed_int,
+      unsigned_int,
+      floating,
+      pointer,
+      // Static string, e.g. the name of an enum value
+      name,
+      // Copied string, truncated to fit
+      text
+    };
+    static const ::size_t text_size = 40;
+
+    kind_t kind;
+    union {
+      long long i;
+      unsigned long long u;
+      double d;
+      const void* p;
+      const char* name;
+      char text[text_size];
+    } value;
+  };
+
+  static const ::size_t max_arguments = 6;
+
+  struct entry {
+    // Odd while the entry is written, even once it is complete
+    std::atomic<std::uint64_t> sequence;
+    cl_ulong time;
+    level_t level;
+    category_t category;
+    const char* function;
+    unsigned int num_arguments;
+    argument arguments[max_arguments];
+  };
+
+ private:
+  static std::atomic<std::uint32_t> mask;
+
+  static constexpr std::uint32_t flag(level_t level, category_t category) {
+    return 1u << (static_cast<unsigned int>(level) * num_categories +
+                  static_cast<unsigned int>(category));
+  }
+
+  static entry& begin_entry(level_t level, category_t category,
+                            const char* function);
+  static void end_entry(entry& e);
+
+  static void capture(argument& arg, const char* text) {
+    arg.kind = argument::kind_t::text;
+    if (text == nullptr) {
+      text = "(null)";
+    }
+    std::strncpy(arg.value.text, text, argument::text_size - 1);
+    arg.value.text[argument::text_size - 1] = '\0';
+  }
+  static void capture(argument& arg, char* text) {
+    capture(arg, static_cast<const char*>(text));
+  }
+  static void capture(argument& arg, const string_class& text) {
+    capture(arg, text.c_str());
+  }
+  static void capture(argument& arg, bool value) {
+    arg.kind = argument::kind_t::name;
+    arg.value.name = (value ? "true" : "false");
+  }
+  static void capture(argument& arg, double value) {
+    arg.kind = argument::kind_t::floating;
+    arg.value.d = value;
+  }
+  static void capture(argument& arg, const void* pointer) {
+    arg.kind = argument::kind_t::pointer;
+    arg.value.p = pointer;
+  }
+
+  template <class T>
+  static
+      typename std::enable_if<std::is_integral<T>::value &&
+                              std::is_signed<T>::value>::type
+      capture(argument& arg, T value) {
+    arg.kind = argument::kind_t::signed_int;
+    arg.value.i = value;
+  }
+  template <class T>
+  static
+      typename std::enable_if<std::is_integral<T>::value &&
+                              std::is_unsigned<T>::value>::type
+      capture(argument& arg, T value) {
+    arg.kind = argument::kind_t::unsigned_int;
+    arg.value.u = value;
+  }
+  template <class T>
+  static typename std::enable_if<std::is_floating_point<T>::value>::type
+  capture(argument& arg, T value) {
+    capture(arg, static_cast<double>(value));
+  }
+  template <class T>
+  static typename std::enable_if<std::is_enum<T>::value>::type capture(
+      argument& arg, T value) {
+    capture_enum(arg, value, 0);
+  }
+  template <class T>
+  static void capture(argument& arg, T* pointer) {
+    capture(arg, static_cast<const void*>(pointer));
+  }
+
+  // Enums with a log_name function are stored as a name
+  template <class T>
+  static auto capture_enum(argument& arg, T value, int)
+      -> decltype(log_name(value), void()) {
+    arg.kind = argument::kind_t::name;
+    arg.value.name = log_name(value);
+  }
+  template <class T>
+  static void capture_enum(argument& arg, T value, long) {
+    capture(arg, static_cast<typename std::underlying_type<T>::type>(value));
+  }
+
+  static void capture_all(argument* args) {}
+  template <class First, class... Rest>
+  static void capture_all(argument* args, const First& first,
+                          const Rest&... rest) {
+    capture(*args, first);
+    capture_all(args + 1, rest...);
+  }
+
+ public:
+  static bool is_enabled(level_t level, category_t category) {
+    return (mask.load(std::memory_order_relaxed) & flag(level, category)) != 0;
+  }
+
+  // Enables the level and all levels below it for the categories,
+  // given as a bit mask of category_t values, and disables the rest
+  static void set_level(level_t level,
+                        std::uint32_t categories = all_categories);
+
+  // Disables all logging
+  static void disable();
+
+  template <class... Args>
+  static void write(level_t level, category_t category, const char* function,
+                    const Args&... args) {
+    static_assert(sizeof...(Args) <= max_arguments,
+                  "Too many arguments for a log record");
+    auto& e = begin_entry(level, category, function);
+    e.num_arguments = sizeof...(Args);
+    capture_all(e.arguments, args...);
+    end_entry(e);
+  }
+
+  // Formats the records still in the ring buffer, oldest first.
+  // Records that are overwritten while dumping are skipped.
+  static void dump(std::ostream& os);
+
+  static const char* level_name(level_t level);
+  static const char* category_name(category_t category);
+};
+
+}  // namespace detail
+}  // namespace sycl
+}  // namespace cl
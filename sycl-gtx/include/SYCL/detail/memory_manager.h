@@ -0,0 +1,101 @@
+#pragma once
+
+// Device memory accounting and eviction
+
+#include "SYCL/detail/common.h"
+#include "SYCL/detail/context_registry.h"
+#include <map>
+
+namespace cl {
+namespace sycl {
+
+// Forward declarations
+class context;
+class device;
+class queue;
+
+namespace detail {
+
+// Forward declarations
+class buffer_base;
+class counters;
+
+// Accounts for the device memory of the buffers in a context
+// and keeps it within a budget.
+// When a new allocation would exceed the budget,
+// the least recently used buffers are evicted:
+// their device memory is released once their pending commands finish.
+// The manager lock is not held while waiting for them.
+// The host copy of a buffer is always up to date after its readbacks,
+// so an evicted buffer is simply created and uploaded again on its next use.
+// Buffers used by command groups that were not flushed yet are never evicted,
+// neither are buffers without host memory.
+// All context objects wrapping the same cl_context share the manager.
+class memory_manager {
+ public:
+  struct constant_limits {
+    cl_ulong max_size;
+    cl_uint max_args;
+  };
+
+ private:
+  mutex_class lock;
+  // Zero until set or until the first allocation,
+  // when it defaults to SYCL_GTX_MEMORY_BUDGET or the device memory size
+  ::size_t budget = 0;
+  ::size_t used = 0;
+  std::map<buffer_base*, ::size_t> allocations;
+  // Queried once per device
+  std::map<cl_device_id, constant_limits> device_limits;
+
+  static context_registry<memory_manager> registry;
+  static std::atomic<cl_ulong> clock;
+
+  // A buffer removed from the accounting, but not evicted yet.
+  // Its events_lock is held until it is.
+  struct victim {
+    buffer_base* buf;
+    ::size_t size;
+    std::unique_lock<mutex_class> buf_lock;
+  };
+
+  // Chooses the least recently used buffers until enough bytes are freed,
+  // called with the lock held
+  vector_class<victim> choose_victims(::size_t bytes, buffer_base* keep);
+  // Waits for the pending commands of the victims,
+  // without holding the lock so other buffers of the context can be used
+  static ::size_t evict(vector_class<victim>& victims, counters* stats);
+
+ public:
+  // Returns the manager shared by all contexts wrapping the cl_context
+  static shared_ptr_class<memory_manager> find(cl_context ctx);
+
+  static const shared_ptr_class<memory_manager>& get(const context& ctx);
+  static const shared_ptr_class<memory_manager>& get(queue* q);
+
+  // Marks the buffer as the most recently used one
+  static void touch(buffer_base* buf);
+
+  // Accounts for a new allocation of the buffer on the queue,
+  // first evicting other buffers if it would exceed the budget.
+  // Called with the events_lock of the buffer held.
+  void allocate(queue* q, buffer_base* buf, ::size_t size);
+
+  // Evicts all buffers that can be evicted except the given one,
+  // returns the number of bytes freed
+  ::size_t evict_all(queue* q, buffer_base* keep);
+
+  // Removes the buffer from the accounting without evicting it
+  void release(buffer_base* buf);
+
+  // Constant memory limits common to all the devices
+  constant_limits get_constant_limits(const vector_class<device>& devices);
+
+  void set_budget(::size_t bytes);
+  ::size_t get_budget();
+  ::size_t get_used();
+};
+
+}  // namespace detail
+}  // namespace sycl
+}  // namespace cl
@@ -0,0 +1,104 @@
+#pragma once
+
+// Profiling of the commands enqueued by the runtime
+
+#include "SYCL/detail/common.h"
+#include "SYCL/event.h"
+#include <iosfwd>
+
+namespace cl {
+namespace sycl {
+
+// Forward declaration
+class queue;
+
+namespace detail {
+
+// Log of the commands the runtime enqueues on a queue with profiling enabled:
+// buffer creation, uploads, kernel launches and readbacks.
+// Subqueues share the log of their master queue.
+// Timestamps are read from the events once the statistics are requested,
+// by then the queue has finished all its commands.
+class profiler {
+ public:
+  enum class command_t { create_buffer, upload, download, kernel };
+
+  struct record {
+    command_t type;
+    // Kernel type name or buffer id
+    string_class name;
+    ::size_t bytes;
+    // Null for commands timed on the host
+    event evnt;
+    // Nanoseconds, as reported by CL_PROFILING_COMMAND_*
+    cl_ulong queued;
+    cl_ulong submit;
+    cl_ulong start;
+    cl_ulong end;
+  };
+
+  // Aggregated over all commands of one type with the same name
+  struct stats {
+    command_t type;
+    string_class name;
+    ::size_t count;
+    // Device time in nanoseconds
+    cl_ulong total;
+    cl_ulong median;
+    cl_ulong p90;
+    cl_ulong p99;
+    ::size_t bytes;
+    // Bytes per second of device time, zero for kernels
+    double bandwidth;
+  };
+
+ private:
+  mutex_class lock;
+  vector_class<record> records;
+  // Records before this one already have their timestamps
+  ::size_t num_resolved = 0;
+  // False if profiling is only enabled for tracing,
+  // then nothing is recorded
+  bool requested;
+
+  static profiler* get(queue* q);
+  void add(record rec);
+  void resolve();
+  vector_class<stats> aggregate(bool kernels);
+
+ public:
+  explicit profiler(bool requested);
+
+  // Profiling is enabled for all queues
+  // if the SYCL_GTX_PROFILE environment variable is set
+  static bool is_enabled_by_default();
+
+  // Host clock in nanoseconds
+  static cl_ulong host_time();
+
+  static bool is_enabled(queue* q);
+
+  // These do nothing if profiling is not enabled on the queue.
+  // The commands are also passed on to the tracer.
+  static void add_kernel(queue* q, const string_class& name, cl_event evnt,
+                         const vector_class<cl_event>& wait_events);
+  static void add_buffer(queue* q, command_t type, ::size_t buffer_id,
+                         ::size_t bytes, cl_event evnt,
+                         const vector_class<cl_event>& wait_events);
+  static void add_buffer(queue* q, command_t type, ::size_t buffer_id,
+                         ::size_t bytes, cl_ulong start, cl_ulong end);
+
+  vector_class<record> get_log();
+  vector_class<stats> kernel_stats();
+  vector_class<stats> buffer_stats();
+
+  // Writes the aggregated statistics in a table
+  void report(std::ostream& os);
+
+  // Whether the queue prints the report when it is destroyed
+  bool is_requested() const;
+};
+
+}  // namespace detail
+}  // namespace sycl
+}  // namespace cl
@@ -39,25 +39,30 @@ struct identifier_code {
   static void generate(typename point<dimensions>::type_t type) {
     string_class name = point<dimensions>::name_from_type(type);
     string_class function_name = get_function_name(type);
+    // Ids fit in an int unless the range has more than INT_MAX elements
+    auto declaration = "const " + source::index_type() + " ";
 
     for (int i = 0; i < dimensions; ++i) {
       auto id_s = get_string<int>::get(i);
-      source::add(string_class("const int ") + name + id_s + " = " +
-                  function_name + "(" + id_s + ")");
+      source::add(declaration + name + id_s + " = " + function_name + "(" +
+                  id_s + ")");
     }
 
     if (is_id) {
       string_replace_one(function_name, "id", "size");
 
       if (dimensions == 1) {
-        source::add(string_class("const int ") + name + " = " + name + "0");
+        source::add(declaration + name + " = " + name + "0");
       }
       if (dimensions == 2) {
-        source::add(string_class("const int ") + name + " = " + name + "1 * " +
+        source::add(declaration + name + " = " + name + "1 * " +
+                    function_name + "(0) + " + name + "0");
+      }
+      if (dimensions == 3) {
+        source::add(declaration + name + " = (" + name + "2 * " +
+                    function_name + "(1) + " + name + "1) * " +
                     function_name + "(0) + " + name + "0");
       }
-
-      // TODO(progtx): 3d
     }
   }
 };
@@ -94,9 +99,9 @@ struct constructor;
 // Single task invoke
 template <>
 struct constructor<void> {
-  static source get(function_class<void(void)> kern) {
+  static source get(function_class<void(void)> kern, bool wide_indices) {
     source src;
-    source::enter(src);
+    source::enter(src, wide_indices);
 
     kern();
 
@@ -107,9 +112,10 @@ struct constructor<void> {
 // Parallel For with range and kernel parameter id
 template <int dimensions>
 struct constructor<id<dimensions>> {
-  static source get(function_class<void(id<dimensions>)> kern) {
+  static source get(function_class<void(id<dimensions>)> kern,
+                    bool wide_indices) {
     source src;
-    source::enter(src);
+    source::enter(src, wide_indices);
 
     // TODO(progtx): num_work_items, work_item_offset
     generate_id_refs<dimensions>::global();
@@ -122,9 +128,10 @@ struct constructor<id<dimensions>> {
 // Parallel For with range and kernel parameter item
 template <int dimensions>
 struct constructor<item<dimensions>> {
-  static source get(function_class<void(item<dimensions>)> kern) {
+  static source get(function_class<void(item<dimensions>)> kern,
+                    bool wide_indices) {
     source src;
-    source::enter(src);
+    source::enter(src, wide_indices);
 
     generate_id_refs<dimensions>::global();
     auto index = get_special_id<dimensions>::global();
@@ -140,9 +147,10 @@ struct constructor<item<dimensions>> {
 // Parallel For with nd_range
 template <int dimensions>
 struct constructor<nd_item<dimensions>> {
-  static source get(function_class<void(nd_item<dimensions>)> kern) {
+  static source get(function_class<void(nd_item<dimensions>)> kern,
+                    bool wide_indices) {
     source src;
-    source::enter(src);
+    source::enter(src, wide_indices);
 
     generate_id_refs<dimensions>::global();
     generate_id_refs<dimensions>::local();
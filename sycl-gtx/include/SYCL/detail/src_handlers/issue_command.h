@@ -3,6 +3,7 @@
 #include "SYCL/detail/common.h"
 #include "SYCL/detail/src_handlers/kernel_source.h"
 #include "SYCL/kernel.h"
+#include <array>
 
 namespace cl {
 namespace sycl {
@@ -19,7 +20,10 @@ class issue_command {
                               const vector_class<cl_event>& wait_events,
                               kernel_ns::source src,
                               shared_ptr_class<kernel> kern);
-  static void prepare_kernel(shared_ptr_class<kernel> kern);
+  // Binds the kernel arguments, the returned lock
+  // has to be held until the kernel is enqueued
+  static std::unique_lock<mutex_class> prepare_kernel(
+      shared_ptr_class<kernel> kern);
 
   static void enqueue_task_command(queue* q,
                                    const vector_class<cl_event>& wait_events,
@@ -31,7 +35,7 @@ class issue_command {
                                     shared_ptr_class<kernel> kern, event* evnt,
                                     range<dimensions> num_work_items,
                                     id<dimensions> offset) {
-    prepare_kernel(kern);
+    auto lock = prepare_kernel(kern);
     kern->enqueue_range(q, wait_events, evnt, num_work_items, offset);
   }
 
@@ -40,14 +44,43 @@ class issue_command {
       queue* q, const vector_class<cl_event>& wait_events,
       shared_ptr_class<kernel> kern, event* evnt,
       nd_range<dimensions> execution_range) {
-    prepare_kernel(kern);
+    auto lock = prepare_kernel(kern);
     kern->enqueue_nd_range(q, wait_events, evnt, execution_range);
   }
 
+  static void upload(buffer_access acc);
+  // Skipped when the device memory already holds the host memory
+  static void upload_changed(buffer_access acc);
+  static void upload_changed_command(queue* q,
+                                     const vector_class<cl_event>& wait_events,
+                                     buffer_base* buf,
+                                     buffer_base::clEnqueueBuffer_f);
+  static void read_back(buffer_access acc);
+
+  static void fill_command(queue* q, const vector_class<cl_event>& wait_events,
+                           buffer_base* buf, const vector_class<char>& pattern,
+                           ::size_t size);
+  static void copy_command(queue* q, const vector_class<cl_event>& wait_events,
+                           buffer_base* src, buffer_base* dest,
+                           std::array<::size_t, 3> src_range,
+                           std::array<::size_t, 3> dest_range,
+                           ::size_t element_size);
+
  public:
   static void write_buffers_to_device(shared_ptr_class<kernel> kern);
   static void read_buffers_from_device(shared_ptr_class<kernel> kern);
 
+  // Done by the device without a kernel,
+  // the destination is read back to the host afterwards.
+  // The copy source is only uploaded if its host memory changed
+  // since it was last transferred.
+  static void fill(buffer_access dest, vector_class<char> pattern,
+                   ::size_t size);
+  // Ranges are in elements, unused dimensions are one
+  static void copy(buffer_access src, buffer_access dest,
+                   std::array<::size_t, 3> src_range,
+                   std::array<::size_t, 3> dest_range, ::size_t element_size);
+
   static void enqueue_task(shared_ptr_class<kernel> kern, event* evnt);
 
   template <int dimensions>
@@ -5,12 +5,15 @@
 #include "SYCL/detail/common.h"
 #include "SYCL/detail/counter.h"
 #include "SYCL/detail/debug.h"
+#include <limits>
 #include <map>
 
 namespace cl {
 namespace sycl {
 
 // Forward declarations
+class context;
+class device;
 class kernel;
 class program;
 class queue;
@@ -26,25 +29,50 @@ namespace kernel_ns {
 template <class Input>
 struct constructor;
 
-class source : protected counter<source> {
+class source {
  private:
   struct buf_info {
     buffer_access acc;
     string_class resource_name;
     string_class type_name;
     ::size_t size;
+    // Bytes of the buffer on the device, zero for local memory.
+    // Struct of arrays buffers pad each array.
+    ::size_t buffer_size;
+    // Host memory of the buffer, used to find buffers that may alias
+    const void* host_data;
+    ::size_t host_size;
+    // Read-only buffer declared as __constant instead of __global
+    bool is_constant;
+    // Arrays of the fields of a struct of arrays buffer,
+    // passed as bytes and accessed through a pointer for each field
+    vector_class<soa_array> soa_arrays;
   };
 
   static const string_class resource_name_root;
+  static const string_class kernel_name_root;
   SYCL_THREAD_LOCAL static int num_resources;
+  SYCL_THREAD_LOCAL static counter_t num_temporaries;
 
   string_class tab_offset;
 
+  // Derived from the code, identical kernels get identical names
   string_class kernel_name;
   vector_class<string_class> lines;
-  std::map<void*, buf_info> resources;
-
-  // TODO(progtx): Multithreading support
+  // Type definitions preceding the kernel, in the order they are needed
+  vector_class<std::pair<string_class, string_class>> definitions;
+  // Kernel arguments, in the order of first use
+  vector_class<buf_info> resources;
+  std::map<void*, ::size_t> resource_ids;
+  // No two arguments share memory, so they can be declared restrict
+  bool is_restrict = false;
+  // Ids and buffer indices are long instead of int,
+  // for ranges and buffers of more than INT_MAX elements
+  bool is_wide = false;
+  // A buffer of the kernel has more than INT_MAX elements
+  bool has_large_buffer = false;
+
+  // Kernels are traced on the submitting thread
   SYCL_THREAD_LOCAL static source* scope;
 
   template <class Input>
@@ -52,22 +80,60 @@ class source : protected counter<source> {
   friend class ::cl::sycl::detail::issue_command;
 
   string_class generate_accessor_list() const;
-
-  static void enter(source& src);
+  string_class generate_soa_pointers() const;
+  void set_kernel_name();
+  bool may_alias() const;
+  const buf_info* find_resource(const string_class& name) const;
+  bool vectorize_line(const string_class& line, const string_class& type,
+                      int width, string_class& vectorized) const;
+  bool vectorize_expression(const string_class& expression,
+                            const string_class& type, int width,
+                            string_class& vectorized) const;
+
+  static void enter(source& src, bool wide_indices);
   static source exit(source& src);
 
  public:
-  source()
-      : tab_offset("\t"),
-        kernel_name(string_class("_sycl_kernel_") +
-                    get_string<counter_t>::get(get_count_id())) {}
+  source() : tab_offset("\t") {}
 
   static bool in_scope();
 
   string_class get_code() const;
   string_class get_kernel_name() const;
 
-  void init_kernel(program& p, shared_ptr_class<kernel> kern);
+  // Traced with int indices, but a buffer needs them to be long,
+  // so the kernel has to be traced again with wide indices
+  bool requires_wide_indices() const {
+    return has_large_buffer && !is_wide;
+  }
+
+  // Type of ids and buffer indices in the kernel being traced
+  static string_class index_type();
+  static bool has_wide_indices();
+
+  // Numbers temporaries in the order they are created in the kernel
+  static counter_t next_temporary_id();
+
+  void init_kernel(program& p, kernel& kern);
+
+  // Declares read-only global buffers as __constant,
+  // as long as they fit within the constant memory limits of all devices.
+  // The smallest buffers are promoted first,
+  // the others stay in __global memory.
+  void promote_to_constant(const context& ctx,
+                           const vector_class<device>& devices);
+
+  // The element type shared by all buffers of the kernel,
+  // empty if they differ or if any of them cannot be loaded as a vector
+  string_class vector_element_type() const;
+
+  // Creates a variant of a one-dimensional kernel
+  // in which each work item processes width consecutive elements
+  // with vloadN and vstoreN, starting at width times its global id.
+  // Only possible if every statement assigns an element-wise expression
+  // of buffer elements at the global id, literals and unary math functions
+  // to a buffer element at the global id.
+  bool vectorize(int width, source& vectorized) const;
 
   template <typename DataType, int dimensions, access::mode mode,
             access::target target>
@@ -80,17 +146,35 @@ class source : protected counter<source> {
 
     string_class resource_name;
     auto buf = static_cast<buffer<DataType, dimensions>*>(acc.resource());
-    auto it = scope->resources.find(buf);
-
-    if (it == scope->resources.end()) {
+    auto it = scope->resource_ids.find(buf);
+
+    if (it == scope->resource_ids.end()) {
+      struct_layout<DataType>::declare();
+      bool is_local = (target == access::target::local);
+      vector_class<soa_array> soa_arrays;
+      if (!is_local) {
+        soa_arrays = buf->soa_arrays;
+        if (buf->get_count() >
+            static_cast<::size_t>(std::numeric_limits<int>::max())) {
+          scope->has_large_buffer = true;
+        }
+      }
       resource_name = resource_name_root +
                       get_string<decltype(num_resources)>::get(++num_resources);
-      scope->resources[buf] = {{buf, mode, target},
-                               resource_name,
-                               type_string<DataType>::get() + '*',
-                               acc.argument_size()};
+      scope->resources.push_back(
+          {{buf, mode, target},
+           resource_name,
+           soa_arrays.empty() ? type_string<DataType>::get() + '*'
+                              : string_class("char*"),
+           acc.argument_size(),
+           is_local ? 0 : buf->get_device_size(),
+           is_local ? nullptr : buf->host_data.get(),
+           is_local ? 0 : buf->get_host_size(),
+           false,
+           std::move(soa_arrays)});
+      scope->resource_ids[buf] = scope->resources.size() - 1;
     } else {
-      resource_name = it->second.resource_name;
+      resource_name = scope->resources[it->second].resource_name;
     }
 
     return resource_name;
@@ -101,6 +185,13 @@ class source : protected counter<source> {
     scope->lines.push_back(scope->tab_offset + line + (auto_end ? ';' : ' '));
   }
 
+  // Whether the resource is a buffer with the struct of arrays layout
+  static bool is_soa(const string_class& resource_name);
+
+  // Adds the definition of a type before the kernel, once per name
+  static void add_definition(const string_class& name,
+                             const string_class& definition);
+
   static void add_curlies() {
     add<false>("{");
     scope->tab_offset.push_back('\t');
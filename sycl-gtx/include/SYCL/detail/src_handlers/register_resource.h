@@ -11,6 +11,9 @@ template <typename DataType, int dimensions, access::mode mode,
 static string_class register_resource(
     const accessor_core<DataType, dimensions, mode, target>& acc);
 
+// Whether buffer indices of the kernel being traced are 64-bit
+bool wide_indices();
+
 }  // namespace kernel_
 }  // namespace detail
 }  // namespace sycl
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "SYCL/detail/common.h"
+#include <condition_variable>
 #include <map>
 #include <set>
 
@@ -16,20 +17,61 @@ namespace detail {
 class accessor_base;
 class buffer_base;
 
+// The registries have separate locks,
+// neither is held while calling into a queue.
+// Queues are used outside the lock, so a removed queue stays registered
+// until no other thread uses it anymore.
 class synchronizer {
  private:
-  static std::set<queue*> queues;
+  struct queue_entry {
+    unsigned int users = 0;
+    bool is_removed = false;
+  };
+
+  // Queues used by the calling thread, released on destruction
+  class queue_refs {
+   private:
+    vector_class<queue*> list;
+
+   public:
+    // All registered queues, or only the given one if it is registered
+    explicit queue_refs(queue* only = nullptr);
+    ~queue_refs();
+    queue_refs(const queue_refs&) = delete;
+    queue_refs& operator=(const queue_refs&) = delete;
+
+    vector_class<queue*>::const_iterator begin() const {
+      return list.begin();
+    }
+    vector_class<queue*>::const_iterator end() const {
+      return list.end();
+    }
+  };
+
+  static std::map<queue*, queue_entry> queues;
   static std::map<accessor_base*, buffer_base*> host_accessors;
+  static mutex_class queues_lock;
+  static std::condition_variable queue_released;
+  static mutex_class accessors_lock;
 
   static void wait_on_queues(buffer_base* buf);
   static void flush_queues(buffer_base* buf);
 
  public:
   static void add(queue* q);
+  // Blocks while another thread is waiting on or flushing the queue
   static void remove(queue* q);
+
+  // Called from a background thread after a kernel build is done.
+  // Does nothing if the queue was destroyed in the meantime.
+  static void flush_built(queue* q);
   static void add(accessor_base* acc, buffer_base* buf);
   static void remove(accessor_base* acc, buffer_base* buf);
 
+  // Called when a buffer is destroyed,
+  // enqueues the command groups still waiting on a kernel build.
+  static void remove(buffer_base* buf);
+
   static bool can_flush(const std::set<detail::buffer_base*>& buffers_in_use);
 };
 
@@ -0,0 +1,42 @@
+#pragma once
+
+#include "SYCL/detail/common.h"
+#include <condition_variable>
+#include <deque>
+#include <thread>
+
+namespace cl {
+namespace sycl {
+namespace detail {
+
+// Fixed number of worker threads, jobs are started in the order they are added.
+// All pending jobs are finished before the pool is destroyed.
+class thread_pool {
+ public:
+  using job_f = function_class<void()>;
+
+ private:
+  mutex_class lock;
+  std::condition_variable has_jobs;
+  std::deque<job_f> jobs;
+  vector_class<std::thread> workers;
+  bool stopping = false;
+
+  void work();
+
+ public:
+  explicit thread_pool(unsigned int num_threads);
+  ~thread_pool();
+
+  thread_pool(const thread_pool&) = delete;
+  thread_pool& operator=(const thread_pool&) = delete;
+
+  void add(job_f job);
+
+  // Number of workers to use when all hardware threads can be occupied
+  static unsigned int hardware_threads();
+};
+
+}  // namespace detail
+}  // namespace sycl
+}  // namespace cl
@@ -0,0 +1,54 @@
+#pragma once
+
+// Timeline export in the Chrome trace event format
+
+#include "SYCL/detail/common.h"
+
+namespace cl {
+namespace sycl {
+
+// Forward declaration
+class queue;
+
+namespace detail {
+
+// Records a timeline of the runtime that can be opened in chrome://tracing
+// or Perfetto. Enabled by setting the SYCL_GTX_TRACE environment variable
+// to the output file, which is written when the program exits.
+// Host spans are recorded per thread. Device commands come from
+// OpenCL event profiling, which is enabled on all queues while tracing.
+// They are shown on one track per OpenCL command queue,
+// each command group runs on its own,
+// with flow arrows from each command to the commands that waited for it.
+class tracer {
+ public:
+  // Records a host span on the calling thread while in scope
+  class span {
+   private:
+    const char* name;
+    cl_ulong start;
+
+   public:
+    explicit span(const char* name);
+    ~span();
+  };
+
+  static bool is_enabled();
+
+  // Host span with known start and end times, on the calling thread
+  static void add_span(const char* name, cl_ulong start, cl_ulong end);
+
+  // Device command on the track of the command queue it was enqueued on.
+  // The timestamps are read once the queue finishes.
+  static void add_command(cl_command_queue track, const string_class& name,
+                          const char* category, cl_event evnt,
+                          const vector_class<cl_event>& wait_events);
+
+  // Reads the timestamps of the finished commands of a command queue,
+  // which is about to be released
+  static void finish(cl_command_queue track);
+};
+
+}  // namespace detail
+}  // namespace sycl
+}  // namespace cl
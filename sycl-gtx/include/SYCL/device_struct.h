@@ -0,0 +1,235 @@
+#pragma once
+
+// User-defined struct types in buffers
+// Not part of the SYCL specification
+
+#include "SYCL/access.h"
+#include "SYCL/accessors/device_reference.h"
+#include "SYCL/detail/common.h"
+#include "SYCL/detail/counter.h"
+#include "SYCL/detail/data_ref.h"
+#include "SYCL/detail/src_handlers/kernel_source.h"
+#include "SYCL/vectors/type_string.h"
+#include "SYCL/vectors/vec.h"
+#include <cstddef>
+#include <type_traits>
+
+namespace cl {
+namespace sycl {
+
+// Kernel view of a struct registered with SYCL_STRUCT,
+// with a member of the same name for each field.
+// Accessing an element of a buffer of structs refers to the element,
+// copying it creates a new kernel variable.
+template <typename T>
+class device_struct;
+
+namespace detail {
+
+// Kernel type of a struct field
+template <typename T, bool = std::is_arithmetic<T>::value>
+struct struct_field {
+  using type = typename acc_device_return<T>::type;
+};
+template <typename T>
+struct struct_field<T, true> {
+  using type = vec<T, 1>;
+};
+
+template <::size_t fieldOffset, ::size_t fieldSize, ::size_t fieldAlignment>
+struct field_layout {
+  static const ::size_t offset = fieldOffset;
+  static const ::size_t size = fieldSize;
+  static const ::size_t alignment = fieldAlignment;
+};
+
+struct end_of_fields {};
+
+constexpr ::size_t align_up(::size_t offset, ::size_t alignment) {
+  return (offset + alignment - 1) / alignment * alignment;
+}
+
+// Checks that every field of the host struct starts where OpenCL C puts it,
+// at the end of the previous field rounded up to its own alignment
+template <::size_t start, class... fields>
+struct layout_check;
+
+template <::size_t start>
+struct layout_check<start, end_of_fields> {
+  static const bool matches = true;
+  static const ::size_t end = start;
+  static const ::size_t alignment = 1;
+};
+
+template <::size_t start, class field, class... rest>
+struct layout_check<start, field, rest...> {
+ private:
+  using next = layout_check<field::offset + field::size, rest...>;
+
+ public:
+  static const bool matches =
+      field::offset == align_up(start, field::alignment) && next::matches;
+  static const ::size_t end = next::end;
+  static const ::size_t alignment =
+      (field::alignment > next::alignment) ? field::alignment : next::alignment;
+};
+
+// Elements of struct of arrays buffers refer to the arrays of the fields
+template <typename T>
+struct element_ref<device_struct<T>> {
+  static device_struct<T> get(const string_class& resource_name,
+                              const string_class& index) {
+    auto name = resource_name + "[" + index + "]";
+    if (kernel_ns::source::is_soa(resource_name)) {
+      return device_struct<T>(name, resource_name, index);
+    }
+    return device_struct<T>(name);
+  }
+};
+
+}  // namespace detail
+
+}  // namespace sycl
+}  // namespace cl
+
+// Used with the field list of SYCL_STRUCT
+#define SYCL_STRUCT_FIELD_TYPE(field) decltype(host_t::field)
+
+#define SYCL_STRUCT_LAYOUT(field)                                \
+  field_layout<offsetof(host_t, field),                          \
+               sizeof(SYCL_STRUCT_FIELD_TYPE(field)),            \
+               struct_layout<SYCL_STRUCT_FIELD_TYPE(field)>::alignment>,
+
+#define SYCL_STRUCT_DECLARE(field) \
+  struct_layout<SYCL_STRUCT_FIELD_TYPE(field)>::declare();
+
+#define SYCL_STRUCT_DEFINE(field)                                       \
+  +'\t' + type_string<SYCL_STRUCT_FIELD_TYPE(field)>::get() + " " #field \
+      ";\n"
+
+#define SYCL_STRUCT_MEMBER(field) \
+  typename detail::struct_field<SYCL_STRUCT_FIELD_TYPE(field)>::type field;
+
+#define SYCL_STRUCT_INFO(field)                                        \
+  {#field, type_string<SYCL_STRUCT_FIELD_TYPE(field)>::get(),          \
+   sizeof(SYCL_STRUCT_FIELD_TYPE(field)), offsetof(host_t, field)},
+
+#define SYCL_STRUCT_INIT(field) , field(member_name(#field))
+
+#define SYCL_STRUCT_ASSIGN(field) field = copy.field;
+
+// Registers a standard layout struct at global scope,
+// so that it can be used as the element type of buffers.
+// The fields are given as a macro that applies its argument to each of them,
+// all fields have to be listed, e.g.
+//   #define SPHERE_FIELDS(field) field(position) field(radius)
+//   SYCL_STRUCT(sphere, SPHERE_FIELDS)
+// A typedef of the struct with the same name is added to kernels that use it.
+// The host layout has to match the OpenCL C layout,
+// where vectors are aligned to their size, so some fields may need padding.
+#define SYCL_STRUCT(structT, fields)                                          \
+  namespace cl {                                                              \
+  namespace sycl {                                                            \
+  namespace detail {                                                          \
+  template <>                                                                 \
+  struct type_string<::structT> {                                             \
+    static string_class get() {                                               \
+      return #structT;                                                        \
+    }                                                                         \
+  };                                                                          \
+  template <>                                                                 \
+  struct acc_device_return<::structT> {                                       \
+    using type = device_struct<::structT>;                                    \
+  };                                                                          \
+  template <>                                                                 \
+  struct struct_layout<::structT> {                                           \
+   private:                                                                   \
+    using host_t = ::structT;                                                 \
+    using layout = layout_check<0, fields(SYCL_STRUCT_LAYOUT) end_of_fields>; \
+    static_assert(std::is_standard_layout<host_t>::value,                     \
+                  "SYCL_STRUCT requires a standard layout struct");           \
+    static_assert(layout::matches,                                            \
+                  "A field of the struct is not where OpenCL C expects it, "  \
+                  "fields may be missing or need padding");                   \
+    static_assert(sizeof(host_t) == align_up(layout::end, layout::alignment), \
+                  "The size of the struct differs from OpenCL C, "            \
+                  "it may need padding at the end");                          \
+                                                                              \
+   public:                                                                    \
+    static const bool is_struct = true;                                       \
+    static const ::size_t alignment = layout::alignment;                      \
+    static vector_class<field_info> members() {                               \
+      return {fields(SYCL_STRUCT_INFO)};                                      \
+    }                                                                         \
+    static void declare() {                                                   \
+      fields(SYCL_STRUCT_DECLARE) kernel_ns::source::add_definition(          \
+          #structT, string_class("typedef struct {\n")                        \
+                        fields(SYCL_STRUCT_DEFINE) + "} " #structT ";");      \
+    }                                                                         \
+  };                                                                          \
+  }                                                                           \
+                                                                              \
+  template <>                                                                 \
+  class device_struct<::structT> {                                            \
+   private:                                                                   \
+    template <typename>                                                       \
+    friend struct detail::element_ref;                                        \
+    template <typename>                                                       \
+    friend class device_struct;                                               \
+                                                                              \
+    using host_t = ::structT;                                                 \
+    string_class self_name;                                                   \
+    /* Set for an element of a struct of arrays buffer, */                    \
+    /* whose fields are elements of separate arrays */                        \
+    string_class soa_resource;                                                \
+    string_class soa_index;                                                   \
+                                                                              \
+    bool is_soa() const {                                                     \
+      return !soa_resource.empty();                                           \
+    }                                                                         \
+    string_class member_name(const char* field) const {                       \
+      return is_soa() ? soa_resource + '_' + field + '[' + soa_index + ']'    \
+                      : self_name + '.' + field;                              \
+    }                                                                         \
+                                                                              \
+    device_struct(string_class name, string_class resource = "",              \
+                  string_class index = "")                                    \
+        : self_name(std::move(name)),                                         \
+          soa_resource(std::move(resource)),                                  \
+          soa_index(std::move(index)) fields(SYCL_STRUCT_INIT) {}             \
+                                                                              \
+    static string_class declare_variable(const string_class& init) {          \
+      detail::struct_layout<host_t>::declare();                               \
+      auto variable = string_class("_" #structT "_") +                        \
+                      detail::get_string<detail::counter_t>::get(             \
+                          detail::kernel_temporary_id());                     \
+      detail::kernel_add(#structT " " + variable + init);                     \
+      return variable;                                                        \
+    }                                                                         \
+                                                                              \
+   public:                                                                    \
+    fields(SYCL_STRUCT_MEMBER)                                                \
+                                                                              \
+    device_struct() : device_struct(declare_variable("")) {}                  \
+    device_struct(const device_struct& copy)                                  \
+        : device_struct(                                                      \
+              declare_variable(copy.is_soa() ? "" : " = " + copy.self_name)) {\
+      if (copy.is_soa()) {                                                    \
+        fields(SYCL_STRUCT_ASSIGN)                                            \
+      }                                                                       \
+    }                                                                         \
+    device_struct(device_struct&& move) noexcept                              \
+        : device_struct(std::move(move.self_name),                            \
+                        std::move(move.soa_resource),                         \
+                        std::move(move.soa_index)) {}                         \
+    device_struct& operator=(const device_struct& copy) {                     \
+      if (is_soa() || copy.is_soa()) {                                        \
+        fields(SYCL_STRUCT_ASSIGN)                                            \
+      } else {                                                                \
+        detail::kernel_add(self_name + " = " + copy.self_name);               \
+      }                                                                       \
+      return *this;                                                           \
+    }                                                                         \
+  };                                                                          \
+  }                                                                           \
+  }
@@ -36,20 +36,29 @@ static const async_handler default_async_handler =
 namespace error {
 
 struct thrower {
-  static unique_ptr_class<exception> get(::cl_int error_code,
-                                         context* thrower) {
-    return unique_ptr_class<exception>(new cl_exception(error_code, thrower));
+  static unique_ptr_class<cl_exception> get(::cl_int error_code,
+                                            context* thrower) {
+    return unique_ptr_class<cl_exception>(
+        new cl_exception(error_code, thrower));
   }
   static unique_ptr_class<exception> get(code::value_t error_code,
                                          context* thrower) {
     return unique_ptr_class<exception>(
         new exception((*error::codes.find(error_code)).second, thrower));
   }
-  static void report(exception& error) {
+  // Throws the exact exception type, so that the OpenCL error code is kept
+  template <class Exception>
+  static void report(Exception& error) {
     debug displayError("SYCL_ERROR::", error.what());
     throw error;
   }
   static void report_async(context* thrower, exception_list& list);
+  // Stores the error, so it can be passed to the async handler later
+  static void add_async(exception_list& list, ::cl_int error_code,
+                        context* thrower) {
+    list.list.push_back(
+        async_exception(detail::error_string(error_code), thrower));
+  }
 };
 
 // Synchronous error reporting
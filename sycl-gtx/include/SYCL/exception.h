@@ -61,6 +61,14 @@ struct cl_exception : exception {
 
 struct async_exception : exception {
   // stored in an exception_list for asynchronous errors
+ private:
+  friend struct detail::error::thrower;
+
+  async_exception(string_class description, context* thrower)
+      : exception(description, thrower) {}
+
+ public:
+  async_exception() = default;
 };
 
 using exception_ptr = std::exception_ptr;
@@ -68,6 +76,7 @@ using exception_ptr = std::exception_ptr;
 // TODO(progtx): Used as a container for a list of asynchronous exceptions
 class exception_list {
  private:
+  friend struct detail::error::thrower;
   using list_t = vector_class<async_exception>;
   list_t list;
 
@@ -0,0 +1,108 @@
+#pragma once
+
+// Helpers for built-in functions,
+// which generate calls to the OpenCL built-in functions of the same name
+
+#include "SYCL/detail/common.h"
+#include "SYCL/detail/data_ref.h"
+#include "SYCL/vectors/helpers.h"
+#include "SYCL/vectors/swizzled_vec.h"
+#include "SYCL/vectors/vec.h"
+#include <type_traits>
+
+namespace cl {
+namespace sycl {
+
+namespace detail {
+
+// Result of a built-in function that has the type of its first argument.
+// Vectors stay vectors so that their members can still be used.
+template <typename T>
+struct builtin_return {
+  using type = data_ref;
+  static type get(string_class code) {
+    return data_ref(std::move(code));
+  }
+};
+template <typename dataT, int numElements>
+struct builtin_return<vec<dataT, numElements>> {
+  using type = vec<dataT, numElements>;
+  static type get(string_class code) {
+    return vectors::expression<type>::get(std::move(code));
+  }
+};
+
+// Result of geometric functions that reduce a vector to a scalar
+template <typename T>
+struct builtin_scalar_return : builtin_return<T> {};
+template <typename dataT, int numElements>
+struct builtin_scalar_return<vec<dataT, numElements>>
+    : builtin_return<vec<dataT, 1>> {};
+
+// Result of relational functions, an integer of the same size per element
+template <typename T>
+struct builtin_rel_return : builtin_return<T> {};
+template <typename dataT, int numElements>
+struct builtin_rel_return<vec<dataT, numElements>>
+    : builtin_return<
+          vec<typename vectors::rel_type<dataT>::type, numElements>> {};
+
+// Result of integer functions that return an unsigned type, e.g. abs
+template <typename T>
+struct builtin_unsigned_return : builtin_return<T> {};
+template <typename dataT, int numElements>
+struct builtin_unsigned_return<vec<dataT, numElements>>
+    : builtin_return<
+          vec<typename std::make_unsigned<dataT>::type, numElements>> {};
+
+// Result of functions that return an int for any argument, e.g. any
+template <typename T>
+struct builtin_int_return : builtin_return<data_ref> {};
+
+// Swizzles are vectors of their own size
+template <typename T>
+struct builtin_arg {
+  using type = T;
+};
+template <typename dataT, int... indices>
+struct builtin_arg<vectors::swizzled<dataT, indices...>> {
+  using type = vec<dataT, sizeof...(indices)>;
+};
+
+template <template <typename> class Return, typename T>
+using builtin_result = Return<typename builtin_arg<T>::type>;
+
+}  // namespace detail
+
+#define SYCL_BUILTIN_ONE_ARG(NAME, RETURN)                                \
+  template <class First,                                                  \
+            class Result = detail::builtin_result<detail::RETURN, First>> \
+  static typename Result::type NAME(const First& first) {                 \
+    using detail::data_ref;                                               \
+    return Result::get(string_class(#NAME "(") +                          \
+                       data_ref::get_name(first) + ')');                  \
+  }
+
+#define SYCL_BUILTIN_TWO_ARG(NAME, RETURN)                                   \
+  template <class First, class Second,                                       \
+            class Result = detail::builtin_result<detail::RETURN, First>>    \
+  static typename Result::type NAME(const First& first,                      \
+                                    const Second& second) {                  \
+    using detail::data_ref;                                                  \
+    return Result::get(string_class(#NAME "(") + data_ref::get_name(first) + \
+                       ", " + data_ref::get_name(second) + ')');             \
+  }
+
+#define SYCL_BUILTIN_THREE_ARG(NAME, RETURN)                                  \
+  template <class First, class Second, class Third,                           \
+            class Result = detail::builtin_result<detail::RETURN, First>>     \
+  static typename Result::type NAME(const First& first, const Second& second, \
+                                    const Third& third) {                     \
+    using detail::data_ref;                                                   \
+    return Result::get(string_class(#NAME "(") + data_ref::get_name(first) +  \
+                       ", " + data_ref::get_name(second) + ", " +             \
+                       data_ref::get_name(third) + ')');                      \
+  }
+
+}  // namespace sycl
+}  // namespace cl
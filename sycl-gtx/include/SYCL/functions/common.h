@@ -1,40 +1,47 @@
 #pragma once
 
-// 3.9.5 Common Functions
+// 3.10.5 Common functions
 
-#include "SYCL/detail/data_ref.h"
-#include "SYCL/vectors/vec.h"
+#include "SYCL/functions/builtin.h"
 
 namespace cl {
 namespace sycl {
 
-#define SYCL_ONE_ARG(NAME)                                                \
-  template <class First>                                                  \
-  static detail::data_ref NAME(const First& first) {                      \
-    using detail::data_ref;                                               \
-    return data_ref(string_class(#NAME "(") + data_ref::get_name(first) + \
-                    ')');                                                 \
-  }
-
-SYCL_ONE_ARG(cos);
-SYCL_ONE_ARG(fabs);
-SYCL_ONE_ARG(sin);
-SYCL_ONE_ARG(sqrt);
-
-#undef SYCL_ONE_ARG
-
-#define SYCL_TWO_ARG(NAME)                                                 \
-  template <class First, class Second>                                     \
-  static detail::data_ref NAME(const First& first, const Second& second) { \
-    using detail::data_ref;                                                \
-    return data_ref(string_class(#NAME "(") + data_ref::get_name(first) +  \
-                    ", " + data_ref::get_name(second) + ")");              \
-  }
+#define SYCL_ONE_ARG(NAME) SYCL_BUILTIN_ONE_ARG(NAME, builtin_return)
+#define SYCL_TWO_ARG(NAME) SYCL_BUILTIN_TWO_ARG(NAME, builtin_return)
+#define SYCL_THREE_ARG(NAME) SYCL_BUILTIN_THREE_ARG(NAME, builtin_return)
 
+SYCL_THREE_ARG(clamp);
+SYCL_ONE_ARG(degrees);
+SYCL_TWO_ARG(max);
 SYCL_TWO_ARG(min);
-SYCL_TWO_ARG(pow);
+SYCL_THREE_ARG(mix);
+SYCL_ONE_ARG(radians);
+SYCL_ONE_ARG(sign);
 
+#undef SYCL_ONE_ARG
 #undef SYCL_TWO_ARG
+#undef SYCL_THREE_ARG
+
+// The edges can be scalars, the result has the type of x
+
+template <class Edge, class X,
+          class Result = detail::builtin_result<detail::builtin_return, X>>
+static typename Result::type step(const Edge& edge, const X& x) {
+  using detail::data_ref;
+  return Result::get("step(" + data_ref::get_name(edge) + ", " +
+                     data_ref::get_name(x) + ')');
+}
+
+template <class Edge0, class Edge1, class X,
+          class Result = detail::builtin_result<detail::builtin_return, X>>
+static typename Result::type smoothstep(const Edge0& edge0, const Edge1& edge1,
+                                        const X& x) {
+  using detail::data_ref;
+  return Result::get("smoothstep(" + data_ref::get_name(edge0) + ", " +
+                     data_ref::get_name(edge1) + ", " + data_ref::get_name(x) +
+                     ')');
+}
 
 }  // namespace sycl
 }  // namespace cl
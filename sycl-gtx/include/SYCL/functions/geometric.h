@@ -0,0 +1,20 @@
+#pragma once
+
+// 3.10.6 Geometric functions
+
+#include "SYCL/functions/builtin.h"
+
+namespace cl {
+namespace sycl {
+
+SYCL_BUILTIN_TWO_ARG(cross, builtin_return);
+SYCL_BUILTIN_TWO_ARG(dot, builtin_scalar_return);
+SYCL_BUILTIN_TWO_ARG(distance, builtin_scalar_return);
+SYCL_BUILTIN_ONE_ARG(length, builtin_scalar_return);
+SYCL_BUILTIN_ONE_ARG(normalize, builtin_return);
+SYCL_BUILTIN_TWO_ARG(fast_distance, builtin_scalar_return);
+SYCL_BUILTIN_ONE_ARG(fast_length, builtin_scalar_return);
+SYCL_BUILTIN_ONE_ARG(fast_normalize, builtin_return);
+
+}  // namespace sycl
+}  // namespace cl
@@ -0,0 +1,34 @@
+#pragma once
+
+// 3.10.4 Integer functions
+
+#include "SYCL/functions/builtin.h"
+
+namespace cl {
+namespace sycl {
+
+#define SYCL_ONE_ARG(NAME) SYCL_BUILTIN_ONE_ARG(NAME, builtin_return)
+#define SYCL_TWO_ARG(NAME) SYCL_BUILTIN_TWO_ARG(NAME, builtin_return)
+#define SYCL_THREE_ARG(NAME) SYCL_BUILTIN_THREE_ARG(NAME, builtin_return)
+
+SYCL_BUILTIN_ONE_ARG(abs, builtin_unsigned_return);
+SYCL_BUILTIN_TWO_ARG(abs_diff, builtin_unsigned_return);
+SYCL_TWO_ARG(add_sat);
+SYCL_TWO_ARG(hadd);
+SYCL_TWO_ARG(rhadd);
+SYCL_ONE_ARG(clz);
+SYCL_THREE_ARG(mad_hi);
+SYCL_THREE_ARG(mad_sat);
+SYCL_TWO_ARG(mul_hi);
+SYCL_TWO_ARG(rotate);
+SYCL_TWO_ARG(sub_sat);
+SYCL_ONE_ARG(popcount);
+SYCL_THREE_ARG(mad24);
+SYCL_TWO_ARG(mul24);
+
+#undef SYCL_ONE_ARG
+#undef SYCL_TWO_ARG
+#undef SYCL_THREE_ARG
+
+}  // namespace sycl
+}  // namespace cl
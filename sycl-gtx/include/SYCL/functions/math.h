@@ -0,0 +1,94 @@
+#pragma once
+
+// 3.10.3 Math functions
+
+#include "SYCL/functions/builtin.h"
+
+namespace cl {
+namespace sycl {
+
+#define SYCL_ONE_ARG(NAME) SYCL_BUILTIN_ONE_ARG(NAME, builtin_return)
+#define SYCL_TWO_ARG(NAME) SYCL_BUILTIN_TWO_ARG(NAME, builtin_return)
+#define SYCL_THREE_ARG(NAME) SYCL_BUILTIN_THREE_ARG(NAME, builtin_return)
+
+SYCL_ONE_ARG(acos);
+SYCL_ONE_ARG(acosh);
+SYCL_ONE_ARG(acospi);
+SYCL_ONE_ARG(asin);
+SYCL_ONE_ARG(asinh);
+SYCL_ONE_ARG(asinpi);
+SYCL_ONE_ARG(atan);
+SYCL_TWO_ARG(atan2);
+SYCL_ONE_ARG(atanh);
+SYCL_ONE_ARG(atanpi);
+SYCL_TWO_ARG(atan2pi);
+SYCL_ONE_ARG(cbrt);
+SYCL_ONE_ARG(ceil);
+SYCL_TWO_ARG(copysign);
+SYCL_ONE_ARG(cos);
+SYCL_ONE_ARG(cosh);
+SYCL_ONE_ARG(cospi);
+SYCL_ONE_ARG(erfc);
+SYCL_ONE_ARG(erf);
+SYCL_ONE_ARG(exp);
+SYCL_ONE_ARG(exp2);
+SYCL_ONE_ARG(exp10);
+SYCL_ONE_ARG(expm1);
+SYCL_ONE_ARG(fabs);
+SYCL_TWO_ARG(fdim);
+SYCL_ONE_ARG(floor);
+SYCL_THREE_ARG(fma);
+SYCL_TWO_ARG(fmax);
+SYCL_TWO_ARG(fmin);
+SYCL_TWO_ARG(fmod);
+SYCL_TWO_ARG(hypot);
+SYCL_ONE_ARG(lgamma);
+SYCL_ONE_ARG(log);
+SYCL_ONE_ARG(log2);
+SYCL_ONE_ARG(log10);
+SYCL_ONE_ARG(log1p);
+SYCL_ONE_ARG(logb);
+SYCL_THREE_ARG(mad);
+SYCL_TWO_ARG(maxmag);
+SYCL_TWO_ARG(minmag);
+SYCL_TWO_ARG(nextafter);
+SYCL_TWO_ARG(pow);
+SYCL_TWO_ARG(pown);
+SYCL_TWO_ARG(powr);
+SYCL_TWO_ARG(remainder);
+SYCL_ONE_ARG(rint);
+SYCL_TWO_ARG(rootn);
+SYCL_ONE_ARG(round);
+SYCL_ONE_ARG(rsqrt);
+SYCL_ONE_ARG(sin);
+SYCL_ONE_ARG(sinh);
+SYCL_ONE_ARG(sinpi);
+SYCL_ONE_ARG(sqrt);
+SYCL_ONE_ARG(tan);
+SYCL_ONE_ARG(tanh);
+SYCL_ONE_ARG(tanpi);
+SYCL_ONE_ARG(tgamma);
+SYCL_ONE_ARG(trunc);
+
+// Implementation-defined precision, usually a single instruction
+SYCL_ONE_ARG(native_cos);
+SYCL_TWO_ARG(native_divide);
+SYCL_ONE_ARG(native_exp);
+SYCL_ONE_ARG(native_exp2);
+SYCL_ONE_ARG(native_exp10);
+SYCL_ONE_ARG(native_log);
+SYCL_ONE_ARG(native_log2);
+SYCL_ONE_ARG(native_log10);
+SYCL_TWO_ARG(native_powr);
+SYCL_ONE_ARG(native_recip);
+SYCL_ONE_ARG(native_rsqrt);
+SYCL_ONE_ARG(native_sin);
+SYCL_ONE_ARG(native_sqrt);
+SYCL_ONE_ARG(native_tan);
+
+#undef SYCL_ONE_ARG
+#undef SYCL_TWO_ARG
+#undef SYCL_THREE_ARG
+
+}  // namespace sycl
+}  // namespace cl
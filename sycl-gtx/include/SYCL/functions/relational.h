@@ -0,0 +1,39 @@
+#pragma once
+
+// 3.10.7 Relational functions
+
+#include "SYCL/functions/builtin.h"
+
+namespace cl {
+namespace sycl {
+
+#define SYCL_ONE_ARG(NAME) SYCL_BUILTIN_ONE_ARG(NAME, builtin_rel_return)
+#define SYCL_TWO_ARG(NAME) SYCL_BUILTIN_TWO_ARG(NAME, builtin_rel_return)
+
+SYCL_TWO_ARG(isequal);
+SYCL_TWO_ARG(isnotequal);
+SYCL_TWO_ARG(isgreater);
+SYCL_TWO_ARG(isgreaterequal);
+SYCL_TWO_ARG(isless);
+SYCL_TWO_ARG(islessequal);
+SYCL_TWO_ARG(islessgreater);
+SYCL_ONE_ARG(isfinite);
+SYCL_ONE_ARG(isinf);
+SYCL_ONE_ARG(isnan);
+SYCL_ONE_ARG(isnormal);
+SYCL_TWO_ARG(isordered);
+SYCL_TWO_ARG(isunordered);
+SYCL_ONE_ARG(signbit);
+
+#undef SYCL_ONE_ARG
+#undef SYCL_TWO_ARG
+
+// Whether any or all of the elements have the most significant bit set
+SYCL_BUILTIN_ONE_ARG(any, builtin_int_return);
+SYCL_BUILTIN_ONE_ARG(all, builtin_int_return);
+
+SYCL_BUILTIN_THREE_ARG(bitselect, builtin_return);
+SYCL_BUILTIN_THREE_ARG(select, builtin_return);
+
+}  // namespace sycl
+}  // namespace cl
@@ -3,30 +3,37 @@
 // 3.5.3 SYCL functions for invoking kernels
 
 #include "SYCL/access.h"
+#include "SYCL/buffer.h"
 #include "SYCL/detail/common.h"
 #include "SYCL/detail/function_traits.h"
 #include "SYCL/detail/src_handlers/issue_command.h"
+#include "SYCL/detail/tracer.h"
 #include "SYCL/handler_event.h"
 #include "SYCL/program.h"
 #include "SYCL/ranges.h"
+#include <limits>
 
 namespace cl {
 namespace sycl {
 
 // Forward declarations
+template <typename, int, access::mode, access::target>
+class accessor;
 class kernel;
 class queue;
 
 class handler;
 namespace detail {
-static unique_ptr_class<handler> get_handler(queue* q);
+static unique_ptr_class<handler> get_handler(queue* q,
+                                             const handler_event& events);
 }
 
 // 3.5.3.4 Command group handler class
 class handler {
  private:
   friend class detail::command_group;
-  friend unique_ptr_class<handler> detail::get_handler(queue* q);
+  friend unique_ptr_class<handler> detail::get_handler(
+      queue* q, const handler_event& events);
 
   queue* q;
   handler_event events;
@@ -36,14 +43,44 @@ class handler {
 
   static context get_context(queue* q);
 
-  template <class KernelType>
-  shared_ptr_class<kernel> build(KernelType kernFunctor) {
+  template <typename KernelName, class KernelType>
+  shared_ptr_class<kernel> trace(KernelType kernFunctor,
+                                 bool wide_indices = false) {
     detail::command::group_detail::check_scope();
-    program prog(get_context(q));
-    prog.build(kernFunctor, "");
+    auto kern = program::trace(kernFunctor, wide_indices);
+    kern->type_name = detail::kernel_name::display<KernelName>();
+    return kern;
+  }
 
-    // We know here the program only contains one kernel
-    return prog.kernels.begin()->second;
+  template <typename KernelName, class KernelType>
+  shared_ptr_class<kernel> build(KernelType kernFunctor,
+                                 bool wide_indices = false) {
+    detail::tracer::span span("handler::build");
+    auto kern = trace<KernelName>(kernFunctor, wide_indices);
+    build(kern, detail::kernel_name::get<KernelType>());
+    return kern;
+  }
+
+  // Builds a traced kernel in the background
+  void build(shared_ptr_class<kernel> kern, ::size_t kernel_name_id);
+
+  // Returns the vector variant of the kernel, or null if it has none.
+  // A zero width is replaced by the preferred width of the device.
+  shared_ptr_class<kernel> vectorize(const kernel& kern, int& width);
+
+  // Global ids, or the linear id, would not fit in an int.
+  // Such kernels compute ids and buffer indices as long,
+  // all others keep the faster int arithmetic.
+  template <int dimensions>
+  static bool needs_wide_indices(const range<dimensions>& numWorkItems,
+                                 const id<dimensions>& workItemOffset) {
+    ::size_t count = 1;
+    for (int i = 0; i < dimensions; ++i) {
+      ::size_t size = numWorkItems.get(i);
+      ::size_t offset = workItemOffset.get(i);
+      count *= size + offset;
+    }
+    return count > static_cast<::size_t>(std::numeric_limits<int>::max());
   }
 
   using issue = detail::issue_command;
@@ -54,7 +91,7 @@ class handler {
                                              Args...),
                      Args... params) {
     issue::write_buffers_to_device(kern);
-    issue_enqueue_f(kern, &events.kernelEvent, params...);
+    issue_enqueue_f(kern, &events.events->kernelEvent, params...);
     issue::read_buffers_from_device(kern);
   }
 
@@ -62,7 +99,8 @@ class handler {
   void parallel_for_range(range<dimensions> numWorkItems,
                           id<dimensions> workItemOffset,
                           KernelType kernFunctor) {
-    auto kern = build(kernFunctor);
+    auto kern = build<KernelName>(
+        kernFunctor, needs_wide_indices(numWorkItems, workItemOffset));
     issue_enqueue(kern, &issue::enqueue_range, numWorkItems, workItemOffset);
   }
   // TODO(progtx): Why is the offset needed? It's already contained in the
@@ -71,7 +109,9 @@ class handler {
   void parallel_for_nd_range(nd_range<dimensions> executionRange,
                              id<dimensions> workItemOffset,
                              KernelType kernFunctor) {
-    auto kern = build(kernFunctor);
+    auto kern = build<KernelName>(
+        kernFunctor, needs_wide_indices(executionRange.get_global(),
+                                        executionRange.get_offset()));
     issue_enqueue(kern, &issue::enqueue_nd_range, executionRange);
   }
 
@@ -89,7 +129,7 @@ class handler {
 
   template <typename KernelName, class KernelType>
   void single_task(KernelType kernFunctor) {
-    auto kern = build(kernFunctor);
+    auto kern = build<KernelName>(kernFunctor);
     issue_enqueue(kern, &issue::enqueue_task);
   }
 
@@ -121,6 +161,56 @@ class handler {
                                       kernFunctor);
   }
 
+  // Not part of the SYCL specification
+  // Same as parallel_for over a range with an id,
+  // but each work item processes width consecutive elements
+  // with vector loads and stores,
+  // which CPU devices in particular run a lot faster.
+  // The width defaults to the preferred vector width of the device
+  // for the element type of the buffers.
+  // Applies only to element-wise kernels, which access all buffers
+  // at the id and have no control flow, temporaries or comparisons,
+  // and whose buffers all have the same scalar element type.
+  // Other kernels are run as with parallel_for.
+  template <typename KernelName, class KernelType>
+  void parallel_for_vectorized(range<1> numWorkItems, KernelType kernFunctor,
+                               int width = 0) {
+    shared_ptr_class<kernel> kern;
+    shared_ptr_class<kernel> vectorized;
+    auto kernel_name_id = detail::kernel_name::get<KernelType>();
+    ::size_t count = numWorkItems.get(0);
+    ::size_t vector_count = 0;
+    {
+      detail::tracer::span span("handler::build");
+      kern = trace<KernelName>(kernFunctor,
+                               needs_wide_indices(numWorkItems, id<1>()));
+      vectorized = vectorize(*kern, width);
+      if (vectorized != nullptr) {
+        vector_count = count / static_cast<::size_t>(width);
+      }
+      if (vector_count > 0) {
+        build(vectorized, kernel_name_id);
+      }
+      // The scalar kernel processes the elements left over
+      if (vector_count * width < count) {
+        build(kern, kernel_name_id);
+      }
+    }
+
+    if (vector_count == 0) {
+      issue_enqueue(kern, &issue::enqueue_range, numWorkItems, id<1>());
+      return;
+    }
+    auto evnt = &events.events->kernelEvent;
+    ::size_t done = vector_count * width;
+    issue::write_buffers_to_device(kern);
+    issue::enqueue_range(vectorized, evnt, range<1>(vector_count), id<1>());
+    if (done < count) {
+      issue::enqueue_range(kern, evnt, range<1>(count - done), id<1>(done));
+    }
+    issue::read_buffers_from_device(kern);
+  }
+
   // TODO(progtx): 3.5.3.3 Parallel For hierarchical invoke
 
   template <typename KernelName, class WorkgroupFunctionType, int dimensions>
@@ -188,6 +278,59 @@ class handler {
                                         kernFunctor);
   }
 
+  // Not part of the SYCL 1.2 specification
+  // Sets all elements of the buffer to the value on the device,
+  // without tracing and compiling a kernel
+  template <typename DataType, int dimensions, access::mode mode,
+            access::target target>
+  void fill(accessor<DataType, dimensions, mode, target>& dest,
+            const typename detail::base_host_data<DataType>::type& value) {
+    static_assert(mode != access::mode::read,
+                  "Cannot fill through a read accessor");
+    detail::command::group_detail::check_scope();
+    auto bytes = reinterpret_cast<const char*>(&value);
+    issue::fill(detail::buffer_access{dest.buf, mode, target},
+                vector_class<char>(bytes, bytes + sizeof(value)),
+                dest.buf->get_size());
+  }
+
+  // Not part of the SYCL 1.2 specification
+  // Copies the source buffer on the device,
+  // into the start of a destination at least as large in every dimension
+  template <typename DataType, int dimensions, access::mode src_mode,
+            access::target src_target, access::mode dest_mode,
+            access::target dest_target>
+  void copy(accessor<DataType, dimensions, src_mode, src_target>& src,
+            accessor<DataType, dimensions, dest_mode, dest_target>& dest) {
+    static_assert(src_mode == access::mode::read ||
+                      src_mode == access::mode::read_write,
+                  "The source accessor has to read the buffer");
+    static_assert(dest_mode != access::mode::read,
+                  "Cannot copy through a read accessor");
+    detail::command::group_detail::check_scope();
+    // With the struct of arrays layout,
+    // the arrays of the fields would have to be rearranged otherwise
+    bool is_soa =
+        (src.buf->get_layout() == buffer_layout::struct_of_arrays);
+    if (is_soa !=
+        (dest.buf->get_layout() == buffer_layout::struct_of_arrays)) {
+      detail::error::report(CL_INVALID_VALUE);
+    }
+    std::array<::size_t, 3> src_range = {{1, 1, 1}};
+    std::array<::size_t, 3> dest_range = {{1, 1, 1}};
+    for (int i = 0; i < dimensions; ++i) {
+      src_range[i] = src.buf->get_range().get(i);
+      dest_range[i] = dest.buf->get_range().get(i);
+      if (dest_range[i] < src_range[i] ||
+          (is_soa && dest_range[i] != src_range[i])) {
+        detail::error::report(CL_INVALID_VALUE);
+      }
+    }
+    issue::copy(detail::buffer_access{src.buf, src_mode, src_target},
+                detail::buffer_access{dest.buf, dest_mode, dest_target},
+                src_range, dest_range, detail::data_size<DataType>::get());
+  }
+
   // OpenCL interoperability invoke
 
   template <bool = true>
@@ -210,9 +353,14 @@ class handler {
 };
 
 namespace detail {
-// Required for Clang
-static unique_ptr_class<handler> get_handler(queue* q) {
-  return unique_ptr_class<handler>(new handler(q));
+// Required for Clang.
+// The handler is still incomplete where command groups are defined,
+// so its events are set here.
+static unique_ptr_class<handler> get_handler(queue* q,
+                                             const handler_event& events) {
+  unique_ptr_class<handler> cgh(new handler(q));
+  cgh->events = events;
+  return cgh;
 }
 }
 
@@ -1,31 +1,54 @@
 #pragma once
 
 #include "SYCL/event.h"
+#include <atomic>
 
 namespace cl {
 namespace sycl {
 
-// Forward declaration
+// Forward declarations
 class handler;
+class queue;
+namespace detail {
+class command_group;
+}
 
-// TODO(progtx):
 class handler_event {
  private:
   friend class handler;
+  friend class queue;
+  friend class detail::command_group;
 
-  event kernelEvent;
-  event completeEvent;
-  event endEvent;
+  struct events_t {
+    event kernelEvent;
+    event completeEvent;
+    event endEvent;
+    // Set after the events, once the command group is enqueued
+    std::atomic<bool> is_enqueued{false};
+  };
+
+  // Shared with the command group, which fills in the events
+  shared_ptr_class<events_t> events = shared_ptr_class<events_t>(new events_t);
+
+  event get(const event events_t::*member) const {
+    return (events->is_enqueued ? (*events).*member : event());
+  }
 
  public:
+  // The events are null until the command group is enqueued,
+  // which is delayed until the kernels of the group are built.
+
+  // Event of the kernel launch
   event get_kernel() const {
-    return kernelEvent;
+    return get(&events_t::kernelEvent);
   }
+  // Completes together with all commands of the command group,
+  // including copying the results back to the host
   event get_complete() const {
-    return completeEvent;
+    return get(&events_t::completeEvent);
   }
   event get_end() const {
-    return endEvent;
+    return get(&events_t::endEvent);
   }
 };
 
@@ -240,6 +240,30 @@ enum class event_profiling : cl_profiling_info {
   command_end = CL_PROFILING_COMMAND_END,
 };
 
+// Not part of the SYCL specification
+// Runtime counters of a context, see context::get_counter.
+// Times are in nanoseconds of host time.
+enum class counter : unsigned int {
+  bytes_uploaded,
+  bytes_downloaded,
+  buffers_created,
+  bytes_allocated,
+  // Buffers whose device memory was released to stay within the budget
+  buffers_evicted,
+  bytes_evicted,
+  // clBuildProgram counts as both a compile and a link
+  programs_compiled,
+  programs_linked,
+  compile_time,
+  program_cache_hits,
+  program_cache_misses,
+  // Programs created from embedded binaries instead of the source
+  programs_loaded,
+  kernel_launches,
+  // Includes waits for host accessors
+  wait_time
+};
+
 namespace detail {
 
 // https://www.khronos.org/registry/cl/sdk/1.2/docs/man/xhtml/clGetMemObjectInfo.html
@@ -5,6 +5,7 @@
 #include "SYCL/context.h"
 #include "SYCL/detail/common.h"
 #include "SYCL/detail/debug.h"
+#include "SYCL/detail/kernel_binding.h"
 #include "SYCL/detail/src_handlers/kernel_source.h"
 #include "SYCL/error_handler.h"
 #include "SYCL/info.h"
@@ -19,25 +20,40 @@ namespace sycl {
 // Forward declarations
 class context;
 class event;
+class handler;
 class queue;
 class program;
+namespace detail {
+class build_result;
+}
 
 class kernel {
  private:
+  friend class handler;
   friend class program;
   friend class detail::issue_command;
   friend class detail::kernel_ns::source;
 
   detail::refc<cl_kernel, clRetainKernel, clReleaseKernel> kern;
+  // Shared by all kernels that use the same OpenCL kernel object
+  shared_ptr_class<detail::kernel_binding> binding;
   context ctx;
   shared_ptr_class<program> prog;
   detail::kernel_ns::source src;
+  // Kernel type name, used for profiling
+  string_class type_name;
+  // Set while the program is built in the background
+  shared_ptr_class<detail::build_result> build;
 
   // These are meant only for program class
   kernel(bool);
   void set(cl_kernel openclKernelObject);
   void set(const context& context, cl_program validProgram);
 
+  // Creates the OpenCL kernel after the background build is done,
+  // blocking if it is still in progress
+  void finish_build();
+
  public:
   // The default object is not valid
   // because there is no program or cl_kernel associated with it
@@ -80,8 +96,11 @@ class kernel {
   }
 
  private:
-  static cl_event get_cl_event(event* evnt);
   static cl_command_queue get_cl_queue(queue* q);
+  // Stores the event of the enqueued kernel, counts the launch
+  // and records it for profiling
+  void set_event(queue* q, const vector_class<cl_event>& wait_events,
+                 event* evnt, cl_event ev) const;
 
   static const cl_event* get_events_ptr(
       const vector_class<cl_event>& wait_events) {
@@ -97,13 +116,13 @@ class kernel {
                      id<dimensions> offset) const {
     ::size_t* global_work_size = &num_work_items[0];
     ::size_t* offst = &static_cast<::size_t&>(offset[0]);
-    auto ev = get_cl_event(evnt);
-
+    cl_event ev;
     auto error_code = clEnqueueNDRangeKernel(
         get_cl_queue(q), kern.get(), dimensions, offst, global_work_size,
         nullptr, static_cast<::cl_uint>(wait_events.size()),
         get_events_ptr(wait_events), &ev);
     detail::error::report(error_code);
+    set_event(q, wait_events, evnt, ev);
   }
 
   template <int dimensions>
@@ -125,13 +144,13 @@ class kernel {
       }
     }
 
-    auto ev = get_cl_event(evnt);
-
+    cl_event ev;
     auto error_code = clEnqueueNDRangeKernel(
         get_cl_queue(q), kern.get(), dimensions, offst, global_work_size,
         local_work_size, static_cast<::cl_uint>(wait_events.size()),
         get_events_ptr(wait_events), &ev);
     detail::error::report(error_code);
+    set_event(q, wait_events, evnt, ev);
   }
 };
 
@@ -0,0 +1,35 @@
+#pragma once
+
+// Memory-mapped files as buffer host memory
+// Not part of the SYCL specification
+
+#include "SYCL/detail/common.h"
+
+namespace cl {
+namespace sycl {
+
+// A file to be used as the host memory of a read-only buffer.
+// The buffer maps the file into memory instead of reading it,
+// so its pages are only read as the data is uploaded to the device.
+class mapped_file {
+ private:
+  string_class path;
+  int fd;
+  ::size_t offset;
+
+ public:
+  // Uses the file starting offset bytes into it
+  explicit mapped_file(string_class path, ::size_t offset = 0);
+
+  // The descriptor has to be open for reading,
+  // it can be closed as soon as the buffer is created
+  explicit mapped_file(int fd, ::size_t offset = 0);
+
+  // Maps size bytes of the file,
+  // the mapping is released with the last copy of the pointer.
+  // Pages are copied on write, the file is never modified.
+  shared_ptr_class<void> map(::size_t size) const;
+};
+
+}  // namespace sycl
+}  // namespace cl
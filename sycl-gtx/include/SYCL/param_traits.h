@@ -133,6 +133,28 @@ SYCL_ADD_CONTEXT_TRAIT(info::context::gl_interop, info::gl_context_interop)
 
 #undef SYCL_ADD_CONTEXT_TRAIT
 
+// Runtime counters, not part of the SYCL specification
+
+#define SYCL_ADD_COUNTER_TRAIT(Value) \
+  SYCL_ADD_TRAIT(info::counter, Value, cl_ulong, unsigned int)
+
+SYCL_ADD_COUNTER_TRAIT(info::counter::bytes_uploaded)
+SYCL_ADD_COUNTER_TRAIT(info::counter::bytes_downloaded)
+SYCL_ADD_COUNTER_TRAIT(info::counter::buffers_created)
+SYCL_ADD_COUNTER_TRAIT(info::counter::bytes_allocated)
+SYCL_ADD_COUNTER_TRAIT(info::counter::buffers_evicted)
+SYCL_ADD_COUNTER_TRAIT(info::counter::bytes_evicted)
+SYCL_ADD_COUNTER_TRAIT(info::counter::programs_compiled)
+SYCL_ADD_COUNTER_TRAIT(info::counter::programs_linked)
+SYCL_ADD_COUNTER_TRAIT(info::counter::compile_time)
+SYCL_ADD_COUNTER_TRAIT(info::counter::program_cache_hits)
+SYCL_ADD_COUNTER_TRAIT(info::counter::program_cache_misses)
+SYCL_ADD_COUNTER_TRAIT(info::counter::programs_loaded)
+SYCL_ADD_COUNTER_TRAIT(info::counter::kernel_launches)
+SYCL_ADD_COUNTER_TRAIT(info::counter::wait_time)
+
+#undef SYCL_ADD_COUNTER_TRAIT
+
 // 3.3.2.1 Platform information descriptors
 // https://www.khronos.org/registry/cl/sdk/1.2/docs/man/xhtml/clGetPlatformInfo.html
 
@@ -4,8 +4,10 @@
 
 #include "SYCL/context.h"
 #include "SYCL/detail/common.h"
+#include "SYCL/detail/compiler.h"
 #include "SYCL/detail/function_traits.h"
 #include "SYCL/detail/kernel_name.h"
+#include "SYCL/detail/kernel_store.h"
 #include "SYCL/detail/src_handlers/invoke_source.h"
 #include "SYCL/detail/src_handlers/kernel_source.h"
 #include "SYCL/device.h"
@@ -27,6 +29,7 @@ class program {
  protected:
   friend class handler;
   friend class kernel;
+  friend class detail::build_result;
   friend class detail::kernel_ns::source;
 
   detail::refc<cl_program, clRetainProgram, clReleaseProgram> prog;
@@ -44,22 +47,39 @@ class program {
 
   void compile(string_class compile_options, ::size_t kernel_name_id,
                shared_ptr_class<kernel> kern);
-  void report_compile_error(shared_ptr_class<kernel> kern, device& dev) const;
+  static void report_compile_error(cl_program prog, device& dev);
 
+  // Ids and buffer indices are int unless wide_indices is set
+  // or a buffer of the kernel has more than INT_MAX elements
   template <class KernelType>
-  void compile(KernelType kernFunctor, string_class compile_options = "") {
-    auto src = detail::kernel_ns::constructor<
-        typename detail::first_arg<KernelType>::type>::get(kernFunctor);
+  static shared_ptr_class<kernel> trace(KernelType kernFunctor,
+                                        bool wide_indices = false) {
+    using constructor = detail::kernel_ns::constructor<
+        typename detail::first_arg<KernelType>::type>;
+    auto src = constructor::get(kernFunctor, wide_indices);
+    if (src.requires_wide_indices()) {
+      src = constructor::get(kernFunctor, true);
+    }
     auto kern = shared_ptr_class<kernel>(new kernel(true));
     kern->src = std::move(src);
-    compile(compile_options, detail::kernel_name::get<KernelType>(), kern);
+    return kern;
   }
 
   template <class KernelType>
-  void build(KernelType kernFunctor, string_class compile_options = "") {
-    compile(kernFunctor, compile_options);
-    link();
+  void compile(KernelType kernFunctor, string_class compile_options = "") {
+    compile(compile_options, detail::kernel_name::get<KernelType>(),
+            trace(kernFunctor));
+  }
+
+  // Hands the traced kernel to the background compiler and returns.
+  // The kernel object is completed once its program is built.
+  template <class KernelType>
+  void build_async(KernelType kernFunctor, string_class build_options = "") {
+    build_async(trace(kernFunctor), detail::kernel_name::get<KernelType>(),
+                build_options);
   }
+  void build_async(shared_ptr_class<kernel> kern, ::size_t kernel_name_id,
+                   string_class build_options);
 
  public:
   // Creates an empty program object for all devices associated with context
@@ -93,13 +113,26 @@ class program {
     link();
   }
 
+  // Same as build_from_kernel_name, but the program is built in the
+  // background. Can be used to warm up kernels before they are submitted,
+  // get_kernel blocks until the build is done.
+  // TODO(progtx): Can only build well-defined functors with a public default
+  // constructor
+  template <typename kernelT>
+  void build_from_kernel_name_async(string_class build_options = "") {
+    kernelT functor;
+    build_async(functor, build_options);
+  }
+
   // Link all compiled programs that are added in the program class
   void link(string_class linking_options = "");
 
   // Gets a kernel from a given name (Functor)
   template <typename kernelT>
   kernel get_kernel() const {
-    return *(kernels.at(detail::kernel_name::get<kernelT>()));
+    auto& kern = kernels.at(detail::kernel_name::get<kernelT>());
+    kern->finish_build();
+    return *kern;
   }
 
   bool is_linked() const {
@@ -6,6 +6,7 @@
 #include "SYCL/context.h"
 #include "SYCL/detail/common.h"
 #include "SYCL/detail/debug.h"
+#include "SYCL/detail/profiler.h"
 #include "SYCL/detail/synchronizer.h"
 #include "SYCL/device.h"
 #include "SYCL/error_handler.h"
@@ -20,24 +21,40 @@ namespace sycl {
 // Encapsulation of an OpenCL cl_command_queue
 class queue {
  private:
+  friend class detail::counters;
+  friend class detail::memory_manager;
+  friend class detail::profiler;
   friend class detail::synchronizer;
 
   using buffer_set = std::set<detail::buffer_base*>;
 
   context ctx;
   device dev;
+  // Null if profiling is disabled
+  shared_ptr_class<detail::profiler> prof;
   detail::refc<cl_command_queue, clRetainCommandQueue, clReleaseCommandQueue>
       command_q;
   exception_list ex_list;
   detail::command_group command_group;
   buffer_set buffers_in_use;
   bool is_flushed = true;
+  // Subqueues are never registered with the synchronizer
+  bool is_registered = false;
+  // First failed kernel build of a dropped command group,
+  // thrown by the next submit or wait
+  ::cl_int build_error = CL_SUCCESS;
   vector_class<queue> subqueues;
+  // Guards subqueues and buffers_in_use
+  detail::member_mutex queue_lock;
 
   void display_device_info() const;
   cl_command_queue create_queue(bool display_info = true,
-                                bool register_with_synchronizer = true,
                                 info::queue_profiling enable_profiling = false);
+  // Called from the constructor body of master queues,
+  // once every member has been initialized.
+  // Tracing enables profiling on all queues,
+  // the profile is only reported if it was requested.
+  void register_queue(info::queue_profiling profiling_requested = false);
 
  public:
   // Creates a queue for a device it chooses
@@ -76,7 +93,8 @@ class queue {
   queue(queue* master, T cgf)
       : ctx(master->ctx),
         dev(master->dev),
-        command_q(create_queue(false, false)),
+        prof(master->prof),
+        command_q(create_queue(false, prof != nullptr)),
         command_group(*this, cgf),
         is_flushed(false) {}
 
@@ -92,11 +110,14 @@ class queue {
   queue(queue&& move) noexcept
       : SYCL_MOVE_INIT(ctx),
         SYCL_MOVE_INIT(dev),
+        SYCL_MOVE_INIT(prof),
         SYCL_MOVE_INIT(command_q),
         SYCL_MOVE_INIT(ex_list),
         SYCL_MOVE_INIT(command_group),
         SYCL_MOVE_INIT(buffers_in_use),
         SYCL_MOVE_INIT(is_flushed),
+        SYCL_MOVE_INIT(is_registered),
+        SYCL_MOVE_INIT(build_error),
         SYCL_MOVE_INIT(subqueues) {
     move.command_q = nullptr;
     command_group.q = this;
@@ -109,11 +130,14 @@ class queue {
     using std::swap;
     SYCL_SWAP(ctx);
     SYCL_SWAP(dev);
+    SYCL_SWAP(prof);
     SYCL_SWAP(command_q);
     SYCL_SWAP(ex_list);
     SYCL_SWAP(command_group);
     SYCL_SWAP(buffers_in_use);
     SYCL_SWAP(is_flushed);
+    SYCL_SWAP(is_registered);
+    SYCL_SWAP(build_error);
     SYCL_SWAP(subqueues);
   }
 
@@ -154,18 +178,48 @@ class queue {
   // TODO(progtx):
   template <typename T>
   handler_event submit(T cgf) {
-    subqueues.push_back({this, cgf});
-    return subqueues.back().process(buffers_in_use);
+    // The command group is traced before taking the lock,
+    // so threads submitting to the same queue only serialize on enqueueing.
+    // Its kernels are built in the background, the group is enqueued
+    // once they are ready.
+    // A kernel build error is thrown by the next submit or wait,
+    // the command group of the kernel is dropped.
+    return add_subqueue(queue(this, cgf));
   }
 
   // TODO(progtx):
   template <typename T>
   handler_event submit(T cgf, queue& secondaryQueue);
 
+  // Profiling extension.
+  // Commands are recorded if the queue was created with profiling enabled,
+  // or for all queues if the SYCL_GTX_PROFILE environment variable is set.
+  // The statistics are also written to the standard error
+  // when the queue is destroyed.
+  // All of these wait for the queue to finish first.
+
+  bool is_profiling() const;
+
+  // Returns every recorded command in the order it was enqueued
+  vector_class<detail::profiler::record> get_profiling_log();
+
+  // Aggregated device time per kernel name
+  vector_class<detail::profiler::stats> get_kernel_stats();
+
+  // Aggregated device time, bytes and bandwidth per buffer and command type
+  vector_class<detail::profiler::stats> get_buffer_stats();
+
  private:
+  bool is_using(detail::buffer_base* buf);
+  handler_event add_subqueue(queue&& subqueue);
+  void process_subqueues(bool wait_for_builds);
   void flush();
+  void flush_built();
   void finish();
+  void wait_all(bool and_throw);
   void wait_subqueues(bool and_throw);
+  void report_build_error();
+  detail::counters* wait_counters();
   handler_event process(buffer_set& buffers_in_use_master);
   static vector_class<cl_event> get_wait_events(const buffer_set& dependencies,
                                                 buffer_set& buffers_in_use);
@@ -0,0 +1,225 @@
+#pragma once
+
+// Counter-based random number generators
+// Not part of the SYCL specification
+
+#include "SYCL/detail/common.h"
+#include "SYCL/functions/integer.h"
+#include "SYCL/functions/math.h"
+#include "SYCL/vectors/vec.h"
+#include <cmath>
+#include <cstring>
+
+namespace cl {
+namespace sycl {
+
+namespace detail {
+namespace random {
+
+// Operations needed by the generators,
+// on unsigned int on the host and on uint1 in a kernel
+template <typename Uint>
+struct ops;
+
+template <>
+struct ops<unsigned int> {
+  using real_type = float;
+
+  static unsigned int mul_hi(unsigned int a, unsigned int b) {
+    return static_cast<unsigned int>(
+        (static_cast<unsigned long long>(a) * b) >> 32);
+  }
+  static unsigned int rotate(unsigned int x, unsigned int n) {
+    return (x << n) | (x >> (32 - n));
+  }
+  // Uniform in [0, 1) from the upper 23 bits, exactly as in the kernel
+  static float to_float(unsigned int bits) {
+    unsigned int one_to_two = (bits >> 9) | 0x3f800000u;
+    float f;
+    std::memcpy(&f, &one_to_two, sizeof(f));
+    return f - 1.0f;
+  }
+  static float log(float x) {
+    return std::log(x);
+  }
+  static float sqrt(float x) {
+    return std::sqrt(x);
+  }
+  static float cospi(float x) {
+    return static_cast<float>(std::cos(3.14159265358979323846 * x));
+  }
+};
+
+template <>
+struct ops<uint1> {
+  using real_type = float1;
+
+  static uint1 mul_hi(const uint1& a, unsigned int b) {
+    return ::cl::sycl::mul_hi(a, b);
+  }
+  static uint1 rotate(const uint1& x, unsigned int n) {
+    return ::cl::sycl::rotate(x, n);
+  }
+  static float1 to_float(const uint1& bits) {
+    return ((bits >> 9u) | 0x3f800000u).as<float1>() - 1.0f;
+  }
+  static float1 log(const float1& x) {
+    return ::cl::sycl::log(x);
+  }
+  static float1 sqrt(const float1& x) {
+    return ::cl::sycl::sqrt(x);
+  }
+  static float1 cospi(const float1& x) {
+    return ::cl::sycl::cospi(x);
+  }
+};
+
+// Philox4x32-10 bijection from Random123,
+// Salmon et al., Parallel Random Numbers: As Easy as 1, 2, 3
+template <typename Uint>
+struct philox4x32_10 {
+  static const int size = 4;
+
+  static void apply(Uint (&x)[size], Uint (&key)[2]) {
+    using ops = detail::random::ops<Uint>;
+    Uint hi0, lo0, hi1, lo1;
+    for (int round = 0; round < 10; ++round) {
+      if (round > 0) {
+        key[0] += 0x9E3779B9u;
+        key[1] += 0xBB67AE85u;
+      }
+      hi0 = ops::mul_hi(x[0], 0xD2511F53u);
+      lo0 = x[0] * 0xD2511F53u;
+      hi1 = ops::mul_hi(x[2], 0xCD9E8D57u);
+      lo1 = x[2] * 0xCD9E8D57u;
+      x[0] = hi1 ^ x[1] ^ key[0];
+      x[1] = lo1;
+      x[2] = hi0 ^ x[3] ^ key[1];
+      x[3] = lo0;
+    }
+  }
+};
+
+// Threefry2x32-20 bijection from Random123
+template <typename Uint>
+struct threefry2x32_20 {
+  static const int size = 2;
+
+  static void apply(Uint (&x)[size], Uint (&key)[2]) {
+    using ops = detail::random::ops<Uint>;
+    static const unsigned int rotations[] = {13, 15, 26, 6, 17, 29, 16, 24};
+
+    Uint schedule[3] = {key[0], key[1], 0x1BD11BDAu};
+    schedule[2] ^= key[0];
+    schedule[2] ^= key[1];
+
+    x[0] += schedule[0];
+    x[1] += schedule[1];
+    for (int round = 0; round < 20; ++round) {
+      x[0] += x[1];
+      x[1] = ops::rotate(x[1], rotations[round % 8]);
+      x[1] ^= x[0];
+      // Key injection after every four rounds
+      if (round % 4 == 3) {
+        unsigned int injection = round / 4 + 1;
+        x[0] += schedule[injection % 3];
+        x[1] += schedule[(injection + 1) % 3];
+        x[1] += injection;
+      }
+    }
+  }
+};
+
+// Generator that encrypts a counter and the id of the work item,
+// using the seed as the key.
+// The random numbers are a function of (seed, id, counter) only,
+// so work items need no stored state or seeds of their own.
+template <typename Uint, template <typename> class Block>
+class counter_based {
+ public:
+  using uint_type = Uint;
+  using real_type = typename ops<Uint>::real_type;
+  static const int block_size = Block<Uint>::size;
+
+ private:
+  Uint seed;
+  Uint id;
+  Uint counter;
+
+ public:
+  counter_based(const Uint& seed, const Uint& id)
+      : counter_based(seed, id, 0u) {}
+  counter_based(const Uint& seed, const Uint& id, const Uint& counter)
+      : seed(seed), id(id), counter(counter) {}
+
+  // Encrypts the words with the key, as in Random123
+  static void block(Uint (&words)[block_size], Uint (&key)[2]) {
+    Block<Uint>::apply(words, key);
+  }
+
+  // Generates the next block of random words
+  void generate(Uint (&words)[block_size]) {
+    words[0] = counter;
+    words[1] = id;
+    for (int i = 2; i < block_size; ++i) {
+      words[i] = 0u;
+    }
+    Uint key[2] = {seed, 0u};
+    block(words, key);
+    counter += 1u;
+  }
+
+  // Next random word, the rest of the block is discarded
+  Uint operator()() {
+    Uint words[block_size];
+    generate(words);
+    return words[0];
+  }
+};
+
+}  // namespace random
+}  // namespace detail
+
+namespace random {
+
+// Not part of the SYCL specification
+// Counter-based generators, keyed by (seed, id, counter),
+// e.g. philox4x32<> rng(seed, i) in a kernel.
+// With unsigned int instead of uint1 they run on the host
+// and generate exactly the same words.
+template <typename Uint = uint1>
+using philox4x32 =
+    detail::random::counter_based<Uint, detail::random::philox4x32_10>;
+template <typename Uint = uint1>
+using threefry2x32 =
+    detail::random::counter_based<Uint, detail::random::threefry2x32_20>;
+
+// Uniformly distributed in [0, 1)
+template <typename Engine>
+typename Engine::real_type uniform(Engine& engine) {
+  using ops = detail::random::ops<typename Engine::uint_type>;
+  return ops::to_float(engine());
+}
+
+// Exponentially distributed with the given rate
+template <typename Engine>
+typename Engine::real_type exponential(Engine& engine, float rate = 1) {
+  using ops = detail::random::ops<typename Engine::uint_type>;
+  return -ops::log(1.0f - uniform(engine)) / rate;
+}
+
+// Normally distributed, using the Box-Muller transform on one block
+template <typename Engine>
+typename Engine::real_type normal(Engine& engine, float mean = 0,
+                                  float stddev = 1) {
+  using ops = detail::random::ops<typename Engine::uint_type>;
+  typename Engine::uint_type words[Engine::block_size];
+  engine.generate(words);
+  auto radius = ops::sqrt(-2.0f * ops::log(1.0f - ops::to_float(words[0])));
+  return mean + stddev * radius * ops::cospi(2.0f * ops::to_float(words[1]));
+}
+
+}  // namespace random
+
+}  // namespace sycl
+}  // namespace cl
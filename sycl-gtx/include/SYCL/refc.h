@@ -58,6 +58,9 @@ class refc : public refc_ptr<CL_Type> {
   }
   ~refc() = default;
 
+  // Drops the reference without a replacement
+  using Base::reset;
+
   void reset(CL_Type data) {
     Base::reset(data, release);
     call_retain(data);
@@ -0,0 +1,116 @@
+#pragma once
+
+// Streaming of host data through a kernel in chunks
+// Not part of the SYCL specification
+
+#include "SYCL/access.h"
+#include "SYCL/accessor.h"
+#include "SYCL/buffer.h"
+#include "SYCL/detail/common.h"
+#include "SYCL/handler.h"
+#include "SYCL/queue.h"
+#include "SYCL/ranges.h"
+#include <algorithm>
+
+namespace cl {
+namespace sycl {
+
+namespace detail {
+
+// One device buffer of the rotation, with its own in-order queue,
+// so that the commands of different slots can overlap.
+// The buffer uses the staging memory as its host memory,
+// which holds one chunk on its way to and from the device.
+template <typename DataType>
+class stream_slot {
+ private:
+  queue q;
+  vector_class<DataType> staging;
+  buffer<DataType> buf;
+  // Chunk in flight, none if the count is zero
+  ::size_t offset = 0;
+  ::size_t count = 0;
+
+ public:
+  stream_slot(queue& master, ::size_t chunk_size)
+      : q(master.get_context(), master.get_device()),
+        staging(chunk_size),
+        buf(staging.data(), range<1>(chunk_size)) {}
+
+  stream_slot(const stream_slot&) = delete;
+  stream_slot& operator=(const stream_slot&) = delete;
+
+  template <typename KernelName, typename KernelType>
+  void start(const DataType* input, ::size_t chunk_offset,
+             ::size_t chunk_count, KernelType kernel) {
+    offset = chunk_offset;
+    count = chunk_count;
+    std::copy(input + offset, input + offset + count, staging.begin());
+
+    auto& chunk_buffer = buf;
+    auto num_items = count;
+    q.submit([&](handler& cgh) {
+      auto chunk =
+          chunk_buffer.template get_access<access::mode::read_write>(cgh);
+      cgh.parallel_for<KernelName>(range<1>(num_items),
+                                   [=](id<1> i) { kernel(chunk, i); });
+    });
+  }
+
+  // Waits for the chunk in flight and copies it to the output
+  void finish(DataType* output) {
+    if (count == 0) {
+      return;
+    }
+    q.wait_and_throw();
+    std::copy(staging.begin(), staging.begin() + count, output + offset);
+    count = 0;
+  }
+};
+
+}  // namespace detail
+
+// Not part of the SYCL specification
+// Runs a kernel over count elements of host data, chunk_size at a time,
+// for data sets larger than the device memory.
+// Each chunk is copied to one of num_buffers device buffers,
+// which are used in rotation, each with its own queue on the device of q.
+// While the host prepares the next chunk, the upload of one chunk,
+// the kernel on the previous one and the download of the one before that
+// can all run at the same time.
+// The kernel is called as kernel(chunk, i) for each index in the chunk,
+// where chunk is a read_write accessor to the buffer of the chunk.
+// The results are written to output, which can be the same as input.
+template <typename KernelName, typename DataType, typename KernelType>
+void stream_chunks(queue& q, const DataType* input, DataType* output,
+                   ::size_t count, ::size_t chunk_size, KernelType kernel,
+                   ::size_t num_buffers = 3) {
+  using slot_t = detail::stream_slot<DataType>;
+  if (count == 0) {
+    return;
+  }
+  auto num_chunks = (count + chunk_size - 1) / chunk_size;
+  num_buffers = std::max<::size_t>(std::min(num_buffers, num_chunks), 1);
+
+  vector_class<unique_ptr_class<slot_t>> slots;
+  slots.reserve(num_buffers);
+  for (::size_t i = 0; i < num_buffers; ++i) {
+    slots.emplace_back(new slot_t(q, chunk_size));
+  }
+
+  for (::size_t k = 0; k < num_chunks; ++k) {
+    auto& slot = *slots[k % num_buffers];
+    // The slot is reused once its previous chunk is done
+    slot.finish(output);
+    auto offset = k * chunk_size;
+    slot.template start<KernelName>(
+        input, offset, std::min(chunk_size, count - offset), kernel);
+  }
+
+  for (::size_t k = num_chunks; k < num_chunks + num_buffers; ++k) {
+    slots[k % num_buffers]->finish(output);
+  }
+}
+
+}  // namespace sycl
+}  // namespace cl
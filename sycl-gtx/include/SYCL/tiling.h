@@ -0,0 +1,100 @@
+#pragma once
+
+// Tiling of three-dimensional buffers in local memory
+// Not part of the SYCL specification
+
+#include "SYCL/access.h"
+#include "SYCL/accessors/local.h"
+#include "SYCL/detail/common.h"
+#include "SYCL/detail/flow_control.h"
+#include "SYCL/functions/common.h"
+#include "SYCL/ranges.h"
+#include "SYCL/ranges/nd_item.h"
+#include "SYCL/vectors/vec.h"
+
+namespace cl {
+namespace sycl {
+
+// Forward declaration
+class handler;
+
+// Not part of the SYCL specification
+// Block of a three-dimensional buffer in the local memory of a work group,
+// surrounded by a halo of neighbouring elements,
+// so that stencils read every element once from global memory
+// instead of once for every neighbour that uses it.
+// Created in the command group for work groups of the given size, e.g.
+//   local_tile_3d<float> tile(range<3>(8, 4, 4), 1, cgh);
+// and used by all work items of an nd_range kernel with that local range
+//   tile.load(it, in, range<3>(nx, ny, nz));
+//   out[it.get_global()] = tile(it, 0, 0, 0) - tile(it, -1, 0, 0);
+template <typename DataType>
+class local_tile_3d {
+ private:
+  using local_t =
+      accessor<DataType, 3, access::mode::read_write, access::target::local>;
+  using element_t = typename detail::acc_device_return<DataType>::type;
+
+  range<3> group_size;
+  int halo;
+  local_t tile;
+
+  static range<3> tile_range(const range<3>& group_size, int halo) {
+    return range<3>(group_size.get(0) + 2 * halo,
+                    group_size.get(1) + 2 * halo,
+                    group_size.get(2) + 2 * halo);
+  }
+  int extent(int dimension) const {
+    return static_cast<int>(group_size.get(dimension)) + 2 * halo;
+  }
+
+ public:
+  local_tile_3d(range<3> group_size, int halo, handler& cgh)
+      : group_size(group_size),
+        halo(halo),
+        tile(tile_range(group_size, halo), cgh) {}
+
+  // Loads the block of the work group and its halo from the buffer,
+  // elements beyond the edges of the buffer are those at the edges.
+  // The work items of the group load the tile together,
+  // so all of them have to call this, and it ends with a barrier.
+  template <class Accessor>
+  void load(const nd_item<3>& it, const Accessor& source,
+            const range<3>& source_range) const {
+    const int size_x = static_cast<int>(group_size.get(0));
+    const int size_y = static_cast<int>(group_size.get(1));
+    const int count = extent(0) * extent(1) * extent(2);
+
+    int1 t = it.get_local(0) + it.get_local(1) * size_x +
+             it.get_local(2) * (size_x * size_y);
+    SYCL_WHILE(t < count) {
+      int1 x = t % extent(0);
+      int1 y = (t / extent(0)) % extent(1);
+      int1 z = t / (extent(0) * extent(1));
+
+      // Relative to the first element of the block of the group
+      int1 gx = (it.get_global(0) - it.get_local(0)) + x - halo;
+      int1 gy = (it.get_global(1) - it.get_local(1)) + y - halo;
+      int1 gz = (it.get_global(2) - it.get_local(2)) + z - halo;
+      gx = clamp(gx, 0, static_cast<int>(source_range.get(0)) - 1);
+      gy = clamp(gy, 0, static_cast<int>(source_range.get(1)) - 1);
+      gz = clamp(gz, 0, static_cast<int>(source_range.get(2)) - 1);
+
+      tile[x][y][z] = source[gx][gy][gz];
+      t += static_cast<int>(group_size.size());
+    }
+    SYCL_END;
+
+    it.barrier(access::fence_space::local_space);
+  }
+
+  // Element of the tile at the local id of the work item,
+  // shifted by the offsets, which are at most the halo
+  element_t operator()(const nd_item<3>& it, int dx, int dy, int dz) const {
+    return tile[it.get_local(0) + (halo + dx)][it.get_local(1) + (halo + dy)]
+               [it.get_local(2) + (halo + dz)];
+  }
+};
+
+}  // namespace sycl
+}  // namespace cl
@@ -4,7 +4,6 @@
 // B.5 vec class base
 
 #include "SYCL/detail/common.h"
-#include "SYCL/detail/counter.h"
 #include "SYCL/detail/data_ref.h"
 #include "SYCL/vectors/cl_vec.h"
 #include "SYCL/vectors/helpers.h"
@@ -19,18 +18,27 @@ class vec;
 template <typename dataT, int numElements>
 using swizzled_vec = vec<dataT, numElements>;
 
+// Rounding of vector conversions, see vec::convert
+enum class rounding_mode { automatic, rte, rtz, rtp, rtn };
+
 namespace detail {
 namespace vectors {
 
-// Forward declaration
-template <int, int, int...>
-struct swizzled;
+// Forward declarations
+template <typename dataT, int... indices>
+class swizzled;
+template <int... indices>
+struct swizzle_name;
+template <int numElements, int... indices>
+struct indices_in_range;
+template <typename dataT, int count, int first, int step, int... indices>
+struct strided_swizzle;
 
 #define SYCL_ENABLE_IF_DIM(dim) \
   typename std::enable_if<num == dim>::type* = nullptr
 
 template <typename dataT, int numElements>
-class base : protected counter<base<dataT, numElements>>, public data_ref {
+class base : public data_ref {
  private:
   template <typename>
   friend struct ::cl::sycl::detail::type_string;
@@ -45,14 +53,54 @@ class base : protected counter<base<dataT, numElements>>, public data_ref {
 
   string_class generate_name() const {
     return '_' + type_name() + '_' +
-           get_string<counter_t>::get(this->get_count_id());
+           get_string<counter_t>::get(kernel_temporary_id());
   }
 
   string_class this_name() const {
     return type_name() + ' ' + this->name;
   }
 
+  // Stores an expression into a new variable,
+  // so that its elements can be assigned to
+  void store_expression() const {
+    if (this->type == type_t::expression) {
+      auto self = const_cast<base*>(this);  // NOLINT
+      auto variable = generate_name();
+      kernel_add(type_name() + ' ' + variable + " = " + this->name);
+      self->name = std::move(variable);
+      self->type = type_t::general;
+    }
+  }
+
+  static string_class rounding_suffix(rounding_mode mode) {
+    switch (mode) {
+      case rounding_mode::rte:
+        return "_rte";
+      case rounding_mode::rtz:
+        return "_rtz";
+      case rounding_mode::rtp:
+        return "_rtp";
+      case rounding_mode::rtn:
+        return "_rtn";
+      default:
+        return "";
+    }
+  }
+
  protected:
+  // Vector literal of a host value
+  static string_class literal(const cl_base<dataT, numElements, 0>& v) {
+    auto code = open_parenthesis + type_name() + ")(";
+    for (int i = 0; i < numElements; ++i) {
+      if (i > 0) {
+        code += ", ";
+      }
+      // Promotes chars so that they are not printed as characters
+      code += get_name(+v.elems[i]);
+    }
+    return code + ')';
+  }
+
   base(string_class assign, bool generate_new = false)
       : data_ref(generate_new ? generate_name() : assign) {
     if (generate_new) {
@@ -141,32 +189,70 @@ class base : protected counter<base<dataT, numElements>>, public data_ref {
     return numElements * sizeof(typename cl_type<dataT, numElements>::type);
   }
 
-  template <int... indices>
-  swizzled_vec<dataT, sizeof...(indices)> swizzle() const {
-    static const auto size = sizeof...(indices);
-    static_assert(size > 0, "Cannot swizzle to zero elements");
+  // Element-wise conversion, generates convert_destType
+  template <typename convertT,
+            rounding_mode roundingMode = rounding_mode::automatic>
+  vec<convertT, numElements> convert() const {
+    return expression<vec<convertT, numElements>>::get(
+        "convert_" + cl_base<convertT, numElements, 0>::type_name() +
+        rounding_suffix(roundingMode) + '(' + this->name + ')');
+  }
+
+  // Reinterprets the bits as another type of the same size, generates as_type
+  template <typename asT>
+  asT as() const {
+    static_assert(sizeof(typename vector_t::type) ==
+                      sizeof(typename asT::vector_t::type),
+                  "Can only reinterpret a vector as a type of the same size");
+    return expression<asT>::get("as_" + type_string<asT>::get() + '(' +
+                                this->name + ')');
+  }
 
-    // One extra for final null char
-    char access_name[size + 1];
-    swizzled<0, indices...>::get(access_name);
-    access_name[size] = 0;
+  // Generates a single OpenCL swizzle of the given elements
+  template <int... indices>
+  swizzled<dataT, indices...> swizzle() const {
+    static const int size = sizeof...(indices);
+    static_assert(size == 1 || size == 2 || size == 3 || size == 4 ||
+                      size == 8 || size == 16,
+                  "Swizzle must result in a valid vector size");
+    static_assert(indices_in_range<numElements, indices...>::value,
+                  "Swizzle index out of range");
+    static_assert(numElements > 1 || size == 1,
+                  "A scalar can only be swizzled to itself");
 
-    return swizzled_vec<dataT, size>(this->name + ".s" + access_name);
+    if (numElements == 1) {
+      return swizzled<dataT, indices...>(this->name);
+    }
+    store_expression();
+    return swizzled<dataT, indices...>(
+        this->name + '.' + swizzle_name<indices...>::get(numElements));
   }
 
-  swizzled_vec<dataT, half_size> lo() const {
-    return swizzled_vec<dataT, half_size>(this->name + ".lo");
+  // Halves of the vector, as in OpenCL
+  using lo_t = typename strided_swizzle<dataT, half_size, 0, 1>::type;
+  using hi_t = typename strided_swizzle<dataT, half_size, half_size, 1>::type;
+  using even_t = typename strided_swizzle<dataT, half_size, 0, 2>::type;
+  using odd_t = typename strided_swizzle<dataT, half_size, 1, 2>::type;
+
+  lo_t lo() const {
+    return half<lo_t>("lo");
+  }
+  hi_t hi() const {
+    return half<hi_t>("hi");
+  }
+  even_t even() const {
+    return half<even_t>("even");
   }
-  swizzled_vec<dataT, half_size> hi() const {
-    return swizzled_vec<dataT, half_size>(this->name + ".hi");
+  odd_t odd() const {
+    return half<odd_t>("odd");
   }
 
-// TODO(progtx): Swizzle methods
-// swizzled_vec<T, out_dims> swizzle<int s1, ...>();
-#ifdef SYCL_SIMPLE_SWIZZLES
-// swizzled_vec<T, 4> xyzw();
-//...
-#endif  // #ifdef SYCL_SIMPLE_SWIZZLES
+ private:
+  template <typename swizzleT>
+  swizzleT half(const char* part) const {
+    store_expression();
+    return swizzleT(this->name + '.' + part);
+  }
 };
 
 }  // namespace vectors
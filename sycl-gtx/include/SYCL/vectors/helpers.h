@@ -1,6 +1,7 @@
 #pragma once
 
 #include "SYCL/detail/common.h"
+#include "SYCL/detail/data_ref.h"
 #include "SYCL/vectors/cl_vec.h"
 
 namespace cl {
@@ -35,6 +36,49 @@ struct acc_device_return<vectors::cl_base<dataT, numElements, numElements>> {
   using type = vec<dataT, numElements>;
 };
 
+namespace vectors {
+
+// Element type of the result of relational operators and functions,
+// a signed integer of the same size
+template <typename dataT>
+struct rel_type {
+  using type = dataT;
+};
+template <>
+struct rel_type<float> {
+  using type = int;
+};
+template <>
+struct rel_type<double> {
+  using type = long;
+};
+template <>
+struct rel_type<unsigned char> {
+  using type = char;
+};
+template <>
+struct rel_type<unsigned short> {
+  using type = short;
+};
+template <>
+struct rel_type<unsigned int> {
+  using type = int;
+};
+template <>
+struct rel_type<unsigned long> {
+  using type = long;
+};
+
+// Creates a vector that names generated code instead of a variable
+template <typename vec_t>
+struct expression {
+  static vec_t get(string_class code) {
+    return vec_t(std::move(code), data_ref::type_t::expression);
+  }
+};
+
+}  // namespace vectors
+
 }  // namespace detail
 
 }  // namespace sycl
@@ -3,32 +3,96 @@
 // 3.7.2 Vector types
 // Swizzled intermediate vectors
 
+#include "SYCL/detail/common.h"
+#include "SYCL/vectors/vec.h"
+#include <type_traits>
+
 namespace cl {
 namespace sycl {
 
 namespace detail {
 namespace vectors {
 
-template <int index, int current>
-static void to_char(char* name) {
-  name[index] = static_cast<char>(current) + '0';
-}
+template <int value, int... others>
+struct contains_index : std::false_type {};
+
+template <int value, int first, int... others>
+struct contains_index<value, first, others...>
+    : std::integral_constant<bool, value == first ||
+                                       contains_index<value, others...>::value> {
+};
+
+template <int... indices>
+struct unique_indices : std::true_type {};
 
-template <int index, int current, int... others>
-struct swizzled;
+template <int first, int... others>
+struct unique_indices<first, others...>
+    : std::integral_constant<bool, !contains_index<first, others...>::value &&
+                                       unique_indices<others...>::value> {};
 
-template <int index, int current>
-struct swizzled<index, current> {
-  static void get(char* name) {
-    to_char<index, current>(name);
+template <int numElements, int... indices>
+struct indices_in_range : std::true_type {};
+
+template <int numElements, int first, int... others>
+struct indices_in_range<numElements, first, others...>
+    : std::integral_constant<
+          bool, first >= 0 && first < numElements &&
+                    indices_in_range<numElements, others...>::value> {};
+
+// OpenCL name of the swizzled elements.
+// Vectors of up to four elements use xyzw, the larger ones use indices.
+template <int... indices>
+struct swizzle_name {
+  static string_class get(int parentElems) {
+    static const int list[] = {indices...};
+    const bool xyzw = parentElems <= 4;
+    string_class name(xyzw ? "" : "s");
+    for (int i : list) {
+      name += xyzw ? "xyzw"[i] : "0123456789abcdef"[i];
+    }
+    return name;
   }
 };
 
-template <int index, int current, int... others>
-struct swizzled {
-  static void get(char* name) {
-    to_char<index, current>(name);
-    swizzled<index + 1, others...>::get(name);
+// Swizzle of the elements first, first + step, ...
+template <typename dataT, int count, int first, int step, int... indices>
+struct strided_swizzle
+    : strided_swizzle<dataT, count - 1, first, step,
+                      first + step * (count - 1), indices...> {};
+
+template <typename dataT, int first, int step, int... indices>
+struct strided_swizzle<dataT, 0, first, step, indices...> {
+  using type = swizzled<dataT, indices...>;
+};
+
+// A vector that refers to elements of another vector,
+// generated as a single OpenCL swizzle, e.g. v.xzy.
+// Assigning to it assigns to those elements of the original vector,
+// while a vector constructed from it is a copy.
+template <typename dataT, int... indices>
+class swizzled : public vec<dataT, sizeof...(indices)> {
+ private:
+  template <typename, int>
+  friend class base;
+
+  using Base = vec<dataT, sizeof...(indices)>;
+  using Ref = base<dataT, sizeof...(indices)>;
+
+  swizzled(string_class name) : Base(std::move(name)) {}
+
+ public:
+  swizzled(const swizzled& copy) = default;
+  swizzled(swizzled&& move) noexcept = default;
+
+  template <typename T>
+  swizzled& operator=(const T& value) {
+    static_assert(unique_indices<indices...>::value,
+                  "Cannot assign to a swizzle that repeats an element");
+    Ref::operator=(value);
+    return *this;
+  }
+  swizzled& operator=(const swizzled& copy) {
+    return operator=<Ref>(copy);
   }
 };
 
@@ -9,6 +9,14 @@ namespace sycl {
 
 namespace detail {
 
+// Scalars of the host vector types
+template <typename dataT>
+struct type_string<vectors::cl_base<dataT, 1, 1>> {
+  static string_class get() {
+    return type_string<dataT>::get();
+  }
+};
+
 // Cannot be joined with vector declarations
 // because a vector of 3 is a typedef of a vector of 4
 #define SYCL_CL_TYPE_STRING(nummedType)             \
@@ -15,6 +15,98 @@
 namespace cl {
 namespace sycl {
 
+// Forward declarations
+template <typename T>
+class device_struct;
+namespace detail {
+template <typename T>
+struct element_ref;
+}
+
+// Operators shared by all vector sizes, they generate vector expressions
+
+#define SYCL_VEC_OP(op)                                                    \
+  vec operator op(const data_ref& d) const {                               \
+    auto r = data_ref::operator op(d);                                     \
+    return vec(std::move(r.name), type_t::expression);                     \
+  }                                                                        \
+  template <typename T,                                                    \
+            typename std::enable_if<std::is_arithmetic<T>::value>::type* = \
+                nullptr>                                                   \
+  friend vec operator op(const T& n, const vec& v) {                       \
+    return vec(data_ref::open_parenthesis + data_ref::get_name(n) +        \
+                   " " #op " " + v.name + ')',                             \
+               type_t::expression);                                        \
+  }
+
+// Only defined for integer element types
+#define SYCL_VEC_INTEGER_OP(op)                                      \
+  template <typename T = dataT>                                      \
+  typename std::enable_if<std::is_integral<T>::value, vec>::type     \
+  operator op(const data_ref& d) const {                             \
+    auto r = data_ref::operator op(d);                               \
+    return vec(std::move(r.name), type_t::expression);               \
+  }                                                                  \
+  template <typename T, typename std::enable_if<                     \
+                            std::is_integral<T>::value &&            \
+                            std::is_integral<dataT>::value>::type* = \
+                            nullptr>                                 \
+  friend vec operator op(const T& n, const vec& v) {                 \
+    return vec(data_ref::open_parenthesis + data_ref::get_name(n) +  \
+                   " " #op " " + v.name + ')',                       \
+               type_t::expression);                                  \
+  }
+
+#define SYCL_VEC_ASSIGNMENT_OP(op)      \
+  vec& operator op(const data_ref& d) { \
+    data_ref::operator op(d);           \
+    return *this;                       \
+  }
+
+#define SYCL_VEC_INTEGER_ASSIGNMENT_OP(op)                        \
+  template <typename T = dataT>                                   \
+  typename std::enable_if<std::is_integral<T>::value, vec&>::type \
+  operator op(const data_ref& d) {                                \
+    data_ref::operator op(d);                                     \
+    return *this;                                                 \
+  }
+
+#define SYCL_VEC_OPERATORS                                       \
+  SYCL_VEC_OP(+)                                                 \
+  SYCL_VEC_OP(-)                                                 \
+  SYCL_VEC_OP(*)                                                 \
+  SYCL_VEC_OP(/)                                                 \
+  SYCL_VEC_INTEGER_OP(%)                                         \
+  SYCL_VEC_INTEGER_OP(&)                                         \
+  SYCL_VEC_INTEGER_OP(|)                                         \
+  SYCL_VEC_INTEGER_OP(^)                                         \
+  SYCL_VEC_INTEGER_OP(<<)                                        \
+  SYCL_VEC_INTEGER_OP(>>)                                        \
+  SYCL_VEC_ASSIGNMENT_OP(+=)                                     \
+  SYCL_VEC_ASSIGNMENT_OP(-=)                                     \
+  SYCL_VEC_ASSIGNMENT_OP(*=)                                     \
+  SYCL_VEC_ASSIGNMENT_OP(/=)                                     \
+  SYCL_VEC_INTEGER_ASSIGNMENT_OP(%=)                             \
+  SYCL_VEC_INTEGER_ASSIGNMENT_OP(&=)                             \
+  SYCL_VEC_INTEGER_ASSIGNMENT_OP(|=)                             \
+  SYCL_VEC_INTEGER_ASSIGNMENT_OP(^=)                             \
+  SYCL_VEC_INTEGER_ASSIGNMENT_OP(<<=)                            \
+  SYCL_VEC_INTEGER_ASSIGNMENT_OP(>>=)                            \
+                                                                 \
+  vec operator-() const {                                        \
+    auto r = data_ref::operator-();                              \
+    return vec(std::move(r.name), type_t::expression);           \
+  }                                                              \
+  vec operator+() const {                                        \
+    return vec(this->name, type_t::expression);                  \
+  }                                                              \
+  template <typename T = dataT>                                  \
+  typename std::enable_if<std::is_integral<T>::value, vec>::type \
+  operator~() const {                                            \
+    auto r = data_ref::operator~();                              \
+    return vec(std::move(r.name), type_t::expression);           \
+  }
+
 template <typename dataT, int numElements>
 class vec : public detail::vectors::base<dataT, numElements>,
             public detail::vectors::members<dataT, numElements> {
@@ -25,6 +117,14 @@ class vec : public detail::vectors::base<dataT, numElements>,
   friend class detail::accessor_device_ref;
   template <typename, int>
   friend class detail::vectors::base;
+  template <typename>
+  friend struct detail::vectors::expression;
+  template <typename, int...>
+  friend class detail::vectors::swizzled;
+  template <typename>
+  friend class device_struct;
+  template <typename>
+  friend struct detail::element_ref;
 
   using Base = detail::vectors::base<dataT, numElements>;
   using Members = detail::vectors::members<dataT, numElements>;
@@ -61,6 +161,15 @@ class vec : public detail::vectors::base<dataT, numElements>,
   vec(data_ref&& move) : Base(std::move(move.name), true), Members(this) {}
   ~vec() = default;
 
+  // Copy of swizzled elements, only stored once it is assigned to
+  template <int... indices>
+  vec(detail::vectors::swizzled<dataT, indices...>&& s,
+      typename std::enable_if<sizeof...(indices) == numElements>::type* =
+          nullptr)
+      : Base(std::move(s.name)), Members(this) {
+    this->type = type_t::expression;
+  }
+
   vec& operator=(const vec& copy) {
     assign(static_cast<const Base&>(copy));
     return *this;
@@ -108,27 +217,65 @@ class vec : public detail::vectors::base<dataT, numElements>,
       : Base(s1, s2, s3, s4, s5, s6, s7, s8, s9, sA, sB, sC, sD, sE, sF),
         Members(this) {}
 
-  // TODO(progtx):
-  operator genvector() const {
-    return genvector();
+  // Host vector value, generates a vector literal
+  vec(const genvector& v) : Base(Base::literal(v), true), Members(this) {}
+
+  SYCL_VEC_OPERATORS
+
+// A scalar on the left is widened to the vector,
+// two vectors need their own overload to prevent ambiguity
+#define SYCL_VEC_SCALAR_OP(op)                                     \
+  vec operator op(const vec& v) const {                            \
+    auto r = data_ref::operator op(v);                             \
+    return vec(std::move(r.name), type_t::expression);             \
+  }                                                                \
+  friend vec operator op(const vec<dataT, 1>& s, const vec& v) {   \
+    return vec(data_ref::open_parenthesis + s.name + " " #op " " + \
+                   v.name + ')',                                   \
+               type_t::expression);                                \
   }
 
-// TODO(progtx): Operators
-#define SYCL_VEC_OP(op)                                \
-  vec operator op(const vec& v) const {                \
-    auto r = data_ref::operator op(v);                 \
-    return vec(std::move(r.name), type_t::expression); \
-  }                                                    \
-  vec operator op(const data_ref& d) const {           \
-    auto r = data_ref::operator op(d);                 \
-    return vec(std::move(r.name), type_t::expression); \
+  SYCL_VEC_SCALAR_OP(+)
+  SYCL_VEC_SCALAR_OP(-)
+  SYCL_VEC_SCALAR_OP(*)
+  SYCL_VEC_SCALAR_OP(/)
+
+#undef SYCL_VEC_SCALAR_OP
+
+  // Relational and logical operators result in a signed integer vector
+  // with -1 where the result is true, as in OpenCL
+  using rel_vec =
+      vec<typename detail::vectors::rel_type<dataT>::type, numElements>;
+
+#define SYCL_VEC_REL_OP(op)                                                \
+  rel_vec operator op(const data_ref& d) const {                           \
+    return detail::vectors::expression<rel_vec>::get(                      \
+        data_ref::operator op(d).name);                                    \
+  }                                                                        \
+  template <typename T,                                                    \
+            typename std::enable_if<std::is_arithmetic<T>::value>::type* = \
+                nullptr>                                                   \
+  friend rel_vec operator op(const T& n, const vec& v) {                   \
+    return detail::vectors::expression<rel_vec>::get(                      \
+        data_ref::open_parenthesis + data_ref::get_name(n) + " " #op " " + \
+        v.name + ')');                                                     \
   }
 
-  SYCL_VEC_OP(+)
-  SYCL_VEC_OP(-)
-  SYCL_VEC_OP(*)
+  SYCL_VEC_REL_OP(==)
+  SYCL_VEC_REL_OP(!=)
+  SYCL_VEC_REL_OP(<)
+  SYCL_VEC_REL_OP(<=)
+  SYCL_VEC_REL_OP(>)
+  SYCL_VEC_REL_OP(>=)
+  SYCL_VEC_REL_OP(&&)
+  SYCL_VEC_REL_OP(||)
 
-#undef SYCL_VEC_OP
+#undef SYCL_VEC_REL_OP
+
+  rel_vec operator!() const {
+    return detail::vectors::expression<rel_vec>::get(
+        data_ref::operator!().name);
+  }
 };
 
 template <typename dataT>
@@ -141,6 +288,14 @@ class vec<dataT, 1> : public detail::vectors::base<dataT, 1>,
   friend class detail::accessor_device_ref;
   template <typename, int>
   friend class detail::vectors::base;
+  template <typename>
+  friend struct detail::vectors::expression;
+  template <typename, int...>
+  friend class detail::vectors::swizzled;
+  template <typename>
+  friend class device_struct;
+  template <typename>
+  friend struct detail::element_ref;
 
   using Base = detail::vectors::base<dataT, 1>;
   using Members = detail::vectors::members<dataT, 1>;
@@ -178,8 +333,16 @@ class vec<dataT, 1> : public detail::vectors::base<dataT, 1>,
   vec(data_ref&& move) : Base(std::move(move.name), true), Members(this) {}
   ~vec() = default;
 
+  // Copy of swizzled elements, only stored once it is assigned to
+  template <int... indices>
+  vec(detail::vectors::swizzled<dataT, indices...>&& s,
+      typename std::enable_if<sizeof...(indices) == 1>::type* = nullptr)
+      : Base(std::move(s.name)), Members(this) {
+    this->type = type_t::expression;
+  }
+
   vec(const dataT& n)
-      : Base(detail::get_string<dataT>::get(n), true), Members(this) {}
+      : Base(data_ref::get_name(n), true), Members(this) {}
 
   vec& operator=(const vec& copy) {
     assign(static_cast<const Base&>(copy));
@@ -202,25 +365,16 @@ class vec<dataT, 1> : public detail::vectors::base<dataT, 1>,
     return *this;
   }
 
-  // TODO(progtx):
-  operator genvector() const {
-    return genvector();
-  }
-
-// TODO(progtx): Operators
-#define SYCL_VEC_OP(op)                                \
-  vec operator op(const data_ref& d) const {           \
-    auto r = data_ref::operator op(d);                 \
-    return vec(std::move(r.name), type_t::expression); \
-  }
-
-  SYCL_VEC_OP(+);
-  SYCL_VEC_OP(-);
-  SYCL_VEC_OP(*);
-  SYCL_VEC_OP(/);
+  // Relational and logical operators are inherited from data_ref,
+  // the result of a scalar comparison is an int
+  SYCL_VEC_OPERATORS
+};
 
 #undef SYCL_VEC_OP
-};
+#undef SYCL_VEC_INTEGER_OP
+#undef SYCL_VEC_ASSIGNMENT_OP
+#undef SYCL_VEC_INTEGER_ASSIGNMENT_OP
+#undef SYCL_VEC_OPERATORS
 
 // 3.10.1 Description of the built-in types available for SYCL host and device
 
@@ -277,3 +431,5 @@ SYCL_ADD_VEC_VECTOR(double)
 
 }  // namespace sycl
 }  // namespace cl
+
+#include "SYCL/vectors/swizzled_vec.h"
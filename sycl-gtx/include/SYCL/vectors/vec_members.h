@@ -18,6 +18,16 @@ namespace vectors {
 template <typename dataT, int parentElems, int selfElems = parentElems>
 struct members;
 
+// Simple swizzles of up to four elements, named with xyzw or rgba.
+// Each size adds the swizzles that use its last element.
+#define SYCL_SWIZZLE(xyzw, rgba, ...)                     \
+  swizzled<dataT, __VA_ARGS__> xyzw() const {             \
+    return this->parent->template swizzle<__VA_ARGS__>(); \
+  }                                                       \
+  swizzled<dataT, __VA_ARGS__> rgba() const {             \
+    return this->parent->template swizzle<__VA_ARGS__>(); \
+  }
+
 template <typename dataT, int parentElems>
 struct members<dataT, parentElems, 1> {
 #ifndef SYCL_SIMPLE_SWIZZLES
@@ -29,9 +39,10 @@ struct members<dataT, parentElems, 1> {
  public:
   members(base<dataT, parentElems>* parent) : parent(parent) {}
 
-  swizzled_vec<dataT, 1> x() const {
-    return this->parent->template swizzle<0>();
-  }
+  SYCL_SWIZZLE(x, r, 0)
+  SYCL_SWIZZLE(xx, rr, 0, 0)
+  SYCL_SWIZZLE(xxx, rrr, 0, 0, 0)
+  SYCL_SWIZZLE(xxxx, rrrr, 0, 0, 0, 0)
 #endif
 };
 
@@ -41,9 +52,32 @@ struct members<dataT, parentElems, 2> : members<dataT, parentElems, 1> {
       : members<dataT, parentElems, 1>(parent) {}
 
 #ifdef SYCL_SIMPLE_SWIZZLES
-  swizzled_vec<dataT, 1> y() const {
-    return this->parent->template swizzle<1>();
-  }
+  SYCL_SWIZZLE(y, g, 1)
+  SYCL_SWIZZLE(xy, rg, 0, 1)
+  SYCL_SWIZZLE(yx, gr, 1, 0)
+  SYCL_SWIZZLE(yy, gg, 1, 1)
+  SYCL_SWIZZLE(xxy, rrg, 0, 0, 1)
+  SYCL_SWIZZLE(xyx, rgr, 0, 1, 0)
+  SYCL_SWIZZLE(xyy, rgg, 0, 1, 1)
+  SYCL_SWIZZLE(yxx, grr, 1, 0, 0)
+  SYCL_SWIZZLE(yxy, grg, 1, 0, 1)
+  SYCL_SWIZZLE(yyx, ggr, 1, 1, 0)
+  SYCL_SWIZZLE(yyy, ggg, 1, 1, 1)
+  SYCL_SWIZZLE(xxxy, rrrg, 0, 0, 0, 1)
+  SYCL_SWIZZLE(xxyx, rrgr, 0, 0, 1, 0)
+  SYCL_SWIZZLE(xxyy, rrgg, 0, 0, 1, 1)
+  SYCL_SWIZZLE(xyxx, rgrr, 0, 1, 0, 0)
+  SYCL_SWIZZLE(xyxy, rgrg, 0, 1, 0, 1)
+  SYCL_SWIZZLE(xyyx, rggr, 0, 1, 1, 0)
+  SYCL_SWIZZLE(xyyy, rggg, 0, 1, 1, 1)
+  SYCL_SWIZZLE(yxxx, grrr, 1, 0, 0, 0)
+  SYCL_SWIZZLE(yxxy, grrg, 1, 0, 0, 1)
+  SYCL_SWIZZLE(yxyx, grgr, 1, 0, 1, 0)
+  SYCL_SWIZZLE(yxyy, grgg, 1, 0, 1, 1)
+  SYCL_SWIZZLE(yyxx, ggrr, 1, 1, 0, 0)
+  SYCL_SWIZZLE(yyxy, ggrg, 1, 1, 0, 1)
+  SYCL_SWIZZLE(yyyx, gggr, 1, 1, 1, 0)
+  SYCL_SWIZZLE(yyyy, gggg, 1, 1, 1, 1)
 #endif
 };
 
@@ -53,13 +87,96 @@ struct members<dataT, parentElems, 3> : members<dataT, parentElems, 2> {
       : members<dataT, parentElems, 2>(parent) {}
 
 #ifdef SYCL_SIMPLE_SWIZZLES
-  swizzled_vec<dataT, 1> z() const {
-    return this->parent->template swizzle<2>();
-  }
-
-  swizzled_vec<dataT, 3> xyz() const {
-    return this->parent->template swizzle<0, 1, 2>();
-  }
+  SYCL_SWIZZLE(z, b, 2)
+  SYCL_SWIZZLE(xz, rb, 0, 2)
+  SYCL_SWIZZLE(yz, gb, 1, 2)
+  SYCL_SWIZZLE(zx, br, 2, 0)
+  SYCL_SWIZZLE(zy, bg, 2, 1)
+  SYCL_SWIZZLE(zz, bb, 2, 2)
+  SYCL_SWIZZLE(xxz, rrb, 0, 0, 2)
+  SYCL_SWIZZLE(xyz, rgb, 0, 1, 2)
+  SYCL_SWIZZLE(xzx, rbr, 0, 2, 0)
+  SYCL_SWIZZLE(xzy, rbg, 0, 2, 1)
+  SYCL_SWIZZLE(xzz, rbb, 0, 2, 2)
+  SYCL_SWIZZLE(yxz, grb, 1, 0, 2)
+  SYCL_SWIZZLE(yyz, ggb, 1, 1, 2)
+  SYCL_SWIZZLE(yzx, gbr, 1, 2, 0)
+  SYCL_SWIZZLE(yzy, gbg, 1, 2, 1)
+  SYCL_SWIZZLE(yzz, gbb, 1, 2, 2)
+  SYCL_SWIZZLE(zxx, brr, 2, 0, 0)
+  SYCL_SWIZZLE(zxy, brg, 2, 0, 1)
+  SYCL_SWIZZLE(zxz, brb, 2, 0, 2)
+  SYCL_SWIZZLE(zyx, bgr, 2, 1, 0)
+  SYCL_SWIZZLE(zyy, bgg, 2, 1, 1)
+  SYCL_SWIZZLE(zyz, bgb, 2, 1, 2)
+  SYCL_SWIZZLE(zzx, bbr, 2, 2, 0)
+  SYCL_SWIZZLE(zzy, bbg, 2, 2, 1)
+  SYCL_SWIZZLE(zzz, bbb, 2, 2, 2)
+  SYCL_SWIZZLE(xxxz, rrrb, 0, 0, 0, 2)
+  SYCL_SWIZZLE(xxyz, rrgb, 0, 0, 1, 2)
+  SYCL_SWIZZLE(xxzx, rrbr, 0, 0, 2, 0)
+  SYCL_SWIZZLE(xxzy, rrbg, 0, 0, 2, 1)
+  SYCL_SWIZZLE(xxzz, rrbb, 0, 0, 2, 2)
+  SYCL_SWIZZLE(xyxz, rgrb, 0, 1, 0, 2)
+  SYCL_SWIZZLE(xyyz, rggb, 0, 1, 1, 2)
+  SYCL_SWIZZLE(xyzx, rgbr, 0, 1, 2, 0)
+  SYCL_SWIZZLE(xyzy, rgbg, 0, 1, 2, 1)
+  SYCL_SWIZZLE(xyzz, rgbb, 0, 1, 2, 2)
+  SYCL_SWIZZLE(xzxx, rbrr, 0, 2, 0, 0)
+  SYCL_SWIZZLE(xzxy, rbrg, 0, 2, 0, 1)
+  SYCL_SWIZZLE(xzxz, rbrb, 0, 2, 0, 2)
+  SYCL_SWIZZLE(xzyx, rbgr, 0, 2, 1, 0)
+  SYCL_SWIZZLE(xzyy, rbgg, 0, 2, 1, 1)
+  SYCL_SWIZZLE(xzyz, rbgb, 0, 2, 1, 2)
+  SYCL_SWIZZLE(xzzx, rbbr, 0, 2, 2, 0)
+  SYCL_SWIZZLE(xzzy, rbbg, 0, 2, 2, 1)
+  SYCL_SWIZZLE(xzzz, rbbb, 0, 2, 2, 2)
+  SYCL_SWIZZLE(yxxz, grrb, 1, 0, 0, 2)
+  SYCL_SWIZZLE(yxyz, grgb, 1, 0, 1, 2)
+  SYCL_SWIZZLE(yxzx, grbr, 1, 0, 2, 0)
+  SYCL_SWIZZLE(yxzy, grbg, 1, 0, 2, 1)
+  SYCL_SWIZZLE(yxzz, grbb, 1, 0, 2, 2)
+  SYCL_SWIZZLE(yyxz, ggrb, 1, 1, 0, 2)
+  SYCL_SWIZZLE(yyyz, gggb, 1, 1, 1, 2)
+  SYCL_SWIZZLE(yyzx, ggbr, 1, 1, 2, 0)
+  SYCL_SWIZZLE(yyzy, ggbg, 1, 1, 2, 1)
+  SYCL_SWIZZLE(yyzz, ggbb, 1, 1, 2, 2)
+  SYCL_SWIZZLE(yzxx, gbrr, 1, 2, 0, 0)
+  SYCL_SWIZZLE(yzxy, gbrg, 1, 2, 0, 1)
+  SYCL_SWIZZLE(yzxz, gbrb, 1, 2, 0, 2)
+  SYCL_SWIZZLE(yzyx, gbgr, 1, 2, 1, 0)
+  SYCL_SWIZZLE(yzyy, gbgg, 1, 2, 1, 1)
+  SYCL_SWIZZLE(yzyz, gbgb, 1, 2, 1, 2)
+  SYCL_SWIZZLE(yzzx, gbbr, 1, 2, 2, 0)
+  SYCL_SWIZZLE(yzzy, gbbg, 1, 2, 2, 1)
+  SYCL_SWIZZLE(yzzz, gbbb, 1, 2, 2, 2)
+  SYCL_SWIZZLE(zxxx, brrr, 2, 0, 0, 0)
+  SYCL_SWIZZLE(zxxy, brrg, 2, 0, 0, 1)
+  SYCL_SWIZZLE(zxxz, brrb, 2, 0, 0, 2)
+  SYCL_SWIZZLE(zxyx, brgr, 2, 0, 1, 0)
+  SYCL_SWIZZLE(zxyy, brgg, 2, 0, 1, 1)
+  SYCL_SWIZZLE(zxyz, brgb, 2, 0, 1, 2)
+  SYCL_SWIZZLE(zxzx, brbr, 2, 0, 2, 0)
+  SYCL_SWIZZLE(zxzy, brbg, 2, 0, 2, 1)
+  SYCL_SWIZZLE(zxzz, brbb, 2, 0, 2, 2)
+  SYCL_SWIZZLE(zyxx, bgrr, 2, 1, 0, 0)
+  SYCL_SWIZZLE(zyxy, bgrg, 2, 1, 0, 1)
+  SYCL_SWIZZLE(zyxz, bgrb, 2, 1, 0, 2)
+  SYCL_SWIZZLE(zyyx, bggr, 2, 1, 1, 0)
+  SYCL_SWIZZLE(zyyy, bggg, 2, 1, 1, 1)
+  SYCL_SWIZZLE(zyyz, bggb, 2, 1, 1, 2)
+  SYCL_SWIZZLE(zyzx, bgbr, 2, 1, 2, 0)
+  SYCL_SWIZZLE(zyzy, bgbg, 2, 1, 2, 1)
+  SYCL_SWIZZLE(zyzz, bgbb, 2, 1, 2, 2)
+  SYCL_SWIZZLE(zzxx, bbrr, 2, 2, 0, 0)
+  SYCL_SWIZZLE(zzxy, bbrg, 2, 2, 0, 1)
+  SYCL_SWIZZLE(zzxz, bbrb, 2, 2, 0, 2)
+  SYCL_SWIZZLE(zzyx, bbgr, 2, 2, 1, 0)
+  SYCL_SWIZZLE(zzyy, bbgg, 2, 2, 1, 1)
+  SYCL_SWIZZLE(zzyz, bbgb, 2, 2, 1, 2)
+  SYCL_SWIZZLE(zzzx, bbbr, 2, 2, 2, 0)
+  SYCL_SWIZZLE(zzzy, bbbg, 2, 2, 2, 1)
+  SYCL_SWIZZLE(zzzz, bbbb, 2, 2, 2, 2)
 #endif
 };
 
@@ -69,9 +186,226 @@ struct members<dataT, parentElems, 4> : members<dataT, parentElems, 3> {
       : members<dataT, parentElems, 3>(parent) {}
 
 #ifdef SYCL_SIMPLE_SWIZZLES
-  swizzled_vec<dataT, 1> w() const {
-    return this->parent->template swizzle<3>();
-  }
+  SYCL_SWIZZLE(w, a, 3)
+  SYCL_SWIZZLE(xw, ra, 0, 3)
+  SYCL_SWIZZLE(yw, ga, 1, 3)
+  SYCL_SWIZZLE(zw, ba, 2, 3)
+  SYCL_SWIZZLE(wx, ar, 3, 0)
+  SYCL_SWIZZLE(wy, ag, 3, 1)
+  SYCL_SWIZZLE(wz, ab, 3, 2)
+  SYCL_SWIZZLE(ww, aa, 3, 3)
+  SYCL_SWIZZLE(xxw, rra, 0, 0, 3)
+  SYCL_SWIZZLE(xyw, rga, 0, 1, 3)
+  SYCL_SWIZZLE(xzw, rba, 0, 2, 3)
+  SYCL_SWIZZLE(xwx, rar, 0, 3, 0)
+  SYCL_SWIZZLE(xwy, rag, 0, 3, 1)
+  SYCL_SWIZZLE(xwz, rab, 0, 3, 2)
+  SYCL_SWIZZLE(xww, raa, 0, 3, 3)
+  SYCL_SWIZZLE(yxw, gra, 1, 0, 3)
+  SYCL_SWIZZLE(yyw, gga, 1, 1, 3)
+  SYCL_SWIZZLE(yzw, gba, 1, 2, 3)
+  SYCL_SWIZZLE(ywx, gar, 1, 3, 0)
+  SYCL_SWIZZLE(ywy, gag, 1, 3, 1)
+  SYCL_SWIZZLE(ywz, gab, 1, 3, 2)
+  SYCL_SWIZZLE(yww, gaa, 1, 3, 3)
+  SYCL_SWIZZLE(zxw, bra, 2, 0, 3)
+  SYCL_SWIZZLE(zyw, bga, 2, 1, 3)
+  SYCL_SWIZZLE(zzw, bba, 2, 2, 3)
+  SYCL_SWIZZLE(zwx, bar, 2, 3, 0)
+  SYCL_SWIZZLE(zwy, bag, 2, 3, 1)
+  SYCL_SWIZZLE(zwz, bab, 2, 3, 2)
+  SYCL_SWIZZLE(zww, baa, 2, 3, 3)
+  SYCL_SWIZZLE(wxx, arr, 3, 0, 0)
+  SYCL_SWIZZLE(wxy, arg, 3, 0, 1)
+  SYCL_SWIZZLE(wxz, arb, 3, 0, 2)
+  SYCL_SWIZZLE(wxw, ara, 3, 0, 3)
+  SYCL_SWIZZLE(wyx, agr, 3, 1, 0)
+  SYCL_SWIZZLE(wyy, agg, 3, 1, 1)
+  SYCL_SWIZZLE(wyz, agb, 3, 1, 2)
+  SYCL_SWIZZLE(wyw, aga, 3, 1, 3)
+  SYCL_SWIZZLE(wzx, abr, 3, 2, 0)
+  SYCL_SWIZZLE(wzy, abg, 3, 2, 1)
+  SYCL_SWIZZLE(wzz, abb, 3, 2, 2)
+  SYCL_SWIZZLE(wzw, aba, 3, 2, 3)
+  SYCL_SWIZZLE(wwx, aar, 3, 3, 0)
+  SYCL_SWIZZLE(wwy, aag, 3, 3, 1)
+  SYCL_SWIZZLE(wwz, aab, 3, 3, 2)
+  SYCL_SWIZZLE(www, aaa, 3, 3, 3)
+  SYCL_SWIZZLE(xxxw, rrra, 0, 0, 0, 3)
+  SYCL_SWIZZLE(xxyw, rrga, 0, 0, 1, 3)
+  SYCL_SWIZZLE(xxzw, rrba, 0, 0, 2, 3)
+  SYCL_SWIZZLE(xxwx, rrar, 0, 0, 3, 0)
+  SYCL_SWIZZLE(xxwy, rrag, 0, 0, 3, 1)
+  SYCL_SWIZZLE(xxwz, rrab, 0, 0, 3, 2)
+  SYCL_SWIZZLE(xxww, rraa, 0, 0, 3, 3)
+  SYCL_SWIZZLE(xyxw, rgra, 0, 1, 0, 3)
+  SYCL_SWIZZLE(xyyw, rgga, 0, 1, 1, 3)
+  SYCL_SWIZZLE(xyzw, rgba, 0, 1, 2, 3)
+  SYCL_SWIZZLE(xywx, rgar, 0, 1, 3, 0)
+  SYCL_SWIZZLE(xywy, rgag, 0, 1, 3, 1)
+  SYCL_SWIZZLE(xywz, rgab, 0, 1, 3, 2)
+  SYCL_SWIZZLE(xyww, rgaa, 0, 1, 3, 3)
+  SYCL_SWIZZLE(xzxw, rbra, 0, 2, 0, 3)
+  SYCL_SWIZZLE(xzyw, rbga, 0, 2, 1, 3)
+  SYCL_SWIZZLE(xzzw, rbba, 0, 2, 2, 3)
+  SYCL_SWIZZLE(xzwx, rbar, 0, 2, 3, 0)
+  SYCL_SWIZZLE(xzwy, rbag, 0, 2, 3, 1)
+  SYCL_SWIZZLE(xzwz, rbab, 0, 2, 3, 2)
+  SYCL_SWIZZLE(xzww, rbaa, 0, 2, 3, 3)
+  SYCL_SWIZZLE(xwxx, rarr, 0, 3, 0, 0)
+  SYCL_SWIZZLE(xwxy, rarg, 0, 3, 0, 1)
+  SYCL_SWIZZLE(xwxz, rarb, 0, 3, 0, 2)
+  SYCL_SWIZZLE(xwxw, rara, 0, 3, 0, 3)
+  SYCL_SWIZZLE(xwyx, ragr, 0, 3, 1, 0)
+  SYCL_SWIZZLE(xwyy, ragg, 0, 3, 1, 1)
+  SYCL_SWIZZLE(xwyz, ragb, 0, 3, 1, 2)
+  SYCL_SWIZZLE(xwyw, raga, 0, 3, 1, 3)
+  SYCL_SWIZZLE(xwzx, rabr, 0, 3, 2, 0)
+  SYCL_SWIZZLE(xwzy, rabg, 0, 3, 2, 1)
+  SYCL_SWIZZLE(xwzz, rabb, 0, 3, 2, 2)
+  SYCL_SWIZZLE(xwzw, raba, 0, 3, 2, 3)
+  SYCL_SWIZZLE(xwwx, raar, 0, 3, 3, 0)
+  SYCL_SWIZZLE(xwwy, raag, 0, 3, 3, 1)
+  SYCL_SWIZZLE(xwwz, raab, 0, 3, 3, 2)
+  SYCL_SWIZZLE(xwww, raaa, 0, 3, 3, 3)
+  SYCL_SWIZZLE(yxxw, grra, 1, 0, 0, 3)
+  SYCL_SWIZZLE(yxyw, grga, 1, 0, 1, 3)
+  SYCL_SWIZZLE(yxzw, grba, 1, 0, 2, 3)
+  SYCL_SWIZZLE(yxwx, grar, 1, 0, 3, 0)
+  SYCL_SWIZZLE(yxwy, grag, 1, 0, 3, 1)
+  SYCL_SWIZZLE(yxwz, grab, 1, 0, 3, 2)
+  SYCL_SWIZZLE(yxww, graa, 1, 0, 3, 3)
+  SYCL_SWIZZLE(yyxw, ggra, 1, 1, 0, 3)
+  SYCL_SWIZZLE(yyyw, ggga, 1, 1, 1, 3)
+  SYCL_SWIZZLE(yyzw, ggba, 1, 1, 2, 3)
+  SYCL_SWIZZLE(yywx, ggar, 1, 1, 3, 0)
+  SYCL_SWIZZLE(yywy, ggag, 1, 1, 3, 1)
+  SYCL_SWIZZLE(yywz, ggab, 1, 1, 3, 2)
+  SYCL_SWIZZLE(yyww, ggaa, 1, 1, 3, 3)
+  SYCL_SWIZZLE(yzxw, gbra, 1, 2, 0, 3)
+  SYCL_SWIZZLE(yzyw, gbga, 1, 2, 1, 3)
+  SYCL_SWIZZLE(yzzw, gbba, 1, 2, 2, 3)
+  SYCL_SWIZZLE(yzwx, gbar, 1, 2, 3, 0)
+  SYCL_SWIZZLE(yzwy, gbag, 1, 2, 3, 1)
+  SYCL_SWIZZLE(yzwz, gbab, 1, 2, 3, 2)
+  SYCL_SWIZZLE(yzww, gbaa, 1, 2, 3, 3)
+  SYCL_SWIZZLE(ywxx, garr, 1, 3, 0, 0)
+  SYCL_SWIZZLE(ywxy, garg, 1, 3, 0, 1)
+  SYCL_SWIZZLE(ywxz, garb, 1, 3, 0, 2)
+  SYCL_SWIZZLE(ywxw, gara, 1, 3, 0, 3)
+  SYCL_SWIZZLE(ywyx, gagr, 1, 3, 1, 0)
+  SYCL_SWIZZLE(ywyy, gagg, 1, 3, 1, 1)
+  SYCL_SWIZZLE(ywyz, gagb, 1, 3, 1, 2)
+  SYCL_SWIZZLE(ywyw, gaga, 1, 3, 1, 3)
+  SYCL_SWIZZLE(ywzx, gabr, 1, 3, 2, 0)
+  SYCL_SWIZZLE(ywzy, gabg, 1, 3, 2, 1)
+  SYCL_SWIZZLE(ywzz, gabb, 1, 3, 2, 2)
+  SYCL_SWIZZLE(ywzw, gaba, 1, 3, 2, 3)
+  SYCL_SWIZZLE(ywwx, gaar, 1, 3, 3, 0)
+  SYCL_SWIZZLE(ywwy, gaag, 1, 3, 3, 1)
+  SYCL_SWIZZLE(ywwz, gaab, 1, 3, 3, 2)
+  SYCL_SWIZZLE(ywww, gaaa, 1, 3, 3, 3)
+  SYCL_SWIZZLE(zxxw, brra, 2, 0, 0, 3)
+  SYCL_SWIZZLE(zxyw, brga, 2, 0, 1, 3)
+  SYCL_SWIZZLE(zxzw, brba, 2, 0, 2, 3)
+  SYCL_SWIZZLE(zxwx, brar, 2, 0, 3, 0)
+  SYCL_SWIZZLE(zxwy, brag, 2, 0, 3, 1)
+  SYCL_SWIZZLE(zxwz, brab, 2, 0, 3, 2)
+  SYCL_SWIZZLE(zxww, braa, 2, 0, 3, 3)
+  SYCL_SWIZZLE(zyxw, bgra, 2, 1, 0, 3)
+  SYCL_SWIZZLE(zyyw, bgga, 2, 1, 1, 3)
+  SYCL_SWIZZLE(zyzw, bgba, 2, 1, 2, 3)
+  SYCL_SWIZZLE(zywx, bgar, 2, 1, 3, 0)
+  SYCL_SWIZZLE(zywy, bgag, 2, 1, 3, 1)
+  SYCL_SWIZZLE(zywz, bgab, 2, 1, 3, 2)
+  SYCL_SWIZZLE(zyww, bgaa, 2, 1, 3, 3)
+  SYCL_SWIZZLE(zzxw, bbra, 2, 2, 0, 3)
+  SYCL_SWIZZLE(zzyw, bbga, 2, 2, 1, 3)
+  SYCL_SWIZZLE(zzzw, bbba, 2, 2, 2, 3)
+  SYCL_SWIZZLE(zzwx, bbar, 2, 2, 3, 0)
+  SYCL_SWIZZLE(zzwy, bbag, 2, 2, 3, 1)
+  SYCL_SWIZZLE(zzwz, bbab, 2, 2, 3, 2)
+  SYCL_SWIZZLE(zzww, bbaa, 2, 2, 3, 3)
+  SYCL_SWIZZLE(zwxx, barr, 2, 3, 0, 0)
+  SYCL_SWIZZLE(zwxy, barg, 2, 3, 0, 1)
+  SYCL_SWIZZLE(zwxz, barb, 2, 3, 0, 2)
+  SYCL_SWIZZLE(zwxw, bara, 2, 3, 0, 3)
+  SYCL_SWIZZLE(zwyx, bagr, 2, 3, 1, 0)
+  SYCL_SWIZZLE(zwyy, bagg, 2, 3, 1, 1)
+  SYCL_SWIZZLE(zwyz, bagb, 2, 3, 1, 2)
+  SYCL_SWIZZLE(zwyw, baga, 2, 3, 1, 3)
+  SYCL_SWIZZLE(zwzx, babr, 2, 3, 2, 0)
+  SYCL_SWIZZLE(zwzy, babg, 2, 3, 2, 1)
+  SYCL_SWIZZLE(zwzz, babb, 2, 3, 2, 2)
+  SYCL_SWIZZLE(zwzw, baba, 2, 3, 2, 3)
+  SYCL_SWIZZLE(zwwx, baar, 2, 3, 3, 0)
+  SYCL_SWIZZLE(zwwy, baag, 2, 3, 3, 1)
+  SYCL_SWIZZLE(zwwz, baab, 2, 3, 3, 2)
+  SYCL_SWIZZLE(zwww, baaa, 2, 3, 3, 3)
+  SYCL_SWIZZLE(wxxx, arrr, 3, 0, 0, 0)
+  SYCL_SWIZZLE(wxxy, arrg, 3, 0, 0, 1)
+  SYCL_SWIZZLE(wxxz, arrb, 3, 0, 0, 2)
+  SYCL_SWIZZLE(wxxw, arra, 3, 0, 0, 3)
+  SYCL_SWIZZLE(wxyx, argr, 3, 0, 1, 0)
+  SYCL_SWIZZLE(wxyy, argg, 3, 0, 1, 1)
+  SYCL_SWIZZLE(wxyz, argb, 3, 0, 1, 2)
+  SYCL_SWIZZLE(wxyw, arga, 3, 0, 1, 3)
+  SYCL_SWIZZLE(wxzx, arbr, 3, 0, 2, 0)
+  SYCL_SWIZZLE(wxzy, arbg, 3, 0, 2, 1)
+  SYCL_SWIZZLE(wxzz, arbb, 3, 0, 2, 2)
+  SYCL_SWIZZLE(wxzw, arba, 3, 0, 2, 3)
+  SYCL_SWIZZLE(wxwx, arar, 3, 0, 3, 0)
+  SYCL_SWIZZLE(wxwy, arag, 3, 0, 3, 1)
+  SYCL_SWIZZLE(wxwz, arab, 3, 0, 3, 2)
+  SYCL_SWIZZLE(wxww, araa, 3, 0, 3, 3)
+  SYCL_SWIZZLE(wyxx, agrr, 3, 1, 0, 0)
+  SYCL_SWIZZLE(wyxy, agrg, 3, 1, 0, 1)
+  SYCL_SWIZZLE(wyxz, agrb, 3, 1, 0, 2)
+  SYCL_SWIZZLE(wyxw, agra, 3, 1, 0, 3)
+  SYCL_SWIZZLE(wyyx, aggr, 3, 1, 1, 0)
+  SYCL_SWIZZLE(wyyy, aggg, 3, 1, 1, 1)
+  SYCL_SWIZZLE(wyyz, aggb, 3, 1, 1, 2)
+  SYCL_SWIZZLE(wyyw, agga, 3, 1, 1, 3)
+  SYCL_SWIZZLE(wyzx, agbr, 3, 1, 2, 0)
+  SYCL_SWIZZLE(wyzy, agbg, 3, 1, 2, 1)
+  SYCL_SWIZZLE(wyzz, agbb, 3, 1, 2, 2)
+  SYCL_SWIZZLE(wyzw, agba, 3, 1, 2, 3)
+  SYCL_SWIZZLE(wywx, agar, 3, 1, 3, 0)
+  SYCL_SWIZZLE(wywy, agag, 3, 1, 3, 1)
+  SYCL_SWIZZLE(wywz, agab, 3, 1, 3, 2)
+  SYCL_SWIZZLE(wyww, agaa, 3, 1, 3, 3)
+  SYCL_SWIZZLE(wzxx, abrr, 3, 2, 0, 0)
+  SYCL_SWIZZLE(wzxy, abrg, 3, 2, 0, 1)
+  SYCL_SWIZZLE(wzxz, abrb, 3, 2, 0, 2)
+  SYCL_SWIZZLE(wzxw, abra, 3, 2, 0, 3)
+  SYCL_SWIZZLE(wzyx, abgr, 3, 2, 1, 0)
+  SYCL_SWIZZLE(wzyy, abgg, 3, 2, 1, 1)
+  SYCL_SWIZZLE(wzyz, abgb, 3, 2, 1, 2)
+  SYCL_SWIZZLE(wzyw, abga, 3, 2, 1, 3)
+  SYCL_SWIZZLE(wzzx, abbr, 3, 2, 2, 0)
+  SYCL_SWIZZLE(wzzy, abbg, 3, 2, 2, 1)
+  SYCL_SWIZZLE(wzzz, abbb, 3, 2, 2, 2)
+  SYCL_SWIZZLE(wzzw, abba, 3, 2, 2, 3)
+  SYCL_SWIZZLE(wzwx, abar, 3, 2, 3, 0)
+  SYCL_SWIZZLE(wzwy, abag, 3, 2, 3, 1)
+  SYCL_SWIZZLE(wzwz, abab, 3, 2, 3, 2)
+  SYCL_SWIZZLE(wzww, abaa, 3, 2, 3, 3)
+  SYCL_SWIZZLE(wwxx, aarr, 3, 3, 0, 0)
+  SYCL_SWIZZLE(wwxy, aarg, 3, 3, 0, 1)
+  SYCL_SWIZZLE(wwxz, aarb, 3, 3, 0, 2)
+  SYCL_SWIZZLE(wwxw, aara, 3, 3, 0, 3)
+  SYCL_SWIZZLE(wwyx, aagr, 3, 3, 1, 0)
+  SYCL_SWIZZLE(wwyy, aagg, 3, 3, 1, 1)
+  SYCL_SWIZZLE(wwyz, aagb, 3, 3, 1, 2)
+  SYCL_SWIZZLE(wwyw, aaga, 3, 3, 1, 3)
+  SYCL_SWIZZLE(wwzx, aabr, 3, 3, 2, 0)
+  SYCL_SWIZZLE(wwzy, aabg, 3, 3, 2, 1)
+  SYCL_SWIZZLE(wwzz, aabb, 3, 3, 2, 2)
+  SYCL_SWIZZLE(wwzw, aaba, 3, 3, 2, 3)
+  SYCL_SWIZZLE(wwwx, aaar, 3, 3, 3, 0)
+  SYCL_SWIZZLE(wwwy, aaag, 3, 3, 3, 1)
+  SYCL_SWIZZLE(wwwz, aaab, 3, 3, 3, 2)
+  SYCL_SWIZZLE(wwww, aaaa, 3, 3, 3, 3)
 #endif
 };
 
@@ -91,6 +425,8 @@ struct members<dataT, parentElems, 16> {
 #endif
 };
 
+#undef SYCL_SWIZZLE
+
 }  // namespace vectors
 }  // namespace detail
 
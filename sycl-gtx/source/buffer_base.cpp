@@ -1,26 +1,309 @@
 #include "SYCL/buffer_base.h"
 
+#include "SYCL/detail/counters.h"
+#include "SYCL/detail/memory_manager.h"
 #include "SYCL/queue.h"
+#include <algorithm>
+#include <cstring>
 
 using namespace cl::sycl;
 using namespace detail;
 
+::size_t buffer_base::next_id() {
+  static std::atomic<::size_t> num_buffers(0);
+  return ++num_buffers;
+}
+
+static void count_transfer(queue* q, ::size_t buffer_id, ::size_t size,
+                           bool is_upload, cl_event evnt,
+                           const vector_class<cl_event>& wait_events) {
+  counters::get(q)->add(is_upload ? info::counter::bytes_uploaded
+                                  : info::counter::bytes_downloaded,
+                        size);
+  profiler::add_buffer(q,
+                       is_upload ? profiler::command_t::upload
+                                 : profiler::command_t::download,
+                       buffer_id, size, evnt, wait_events);
+}
+
+static ::cl_int enqueue_range(queue* q, ::size_t buffer_id, cl_mem mem,
+                              ::size_t offset, ::size_t size, void* host_ptr,
+                              const vector_class<cl_event>& wait_events,
+                              cl_event& evnt,
+                              decltype(&clEnqueueWriteBuffer) clEnqueueBuffer) {
+  auto num_events_to_wait = wait_events.size();
+
+  auto error_code = clEnqueueBuffer(
+      q->get(), mem, false,
+      // TODO(progtx): Sub-buffer access
+      offset, size, static_cast<char*>(host_ptr) + offset,
+      static_cast<::cl_uint>(num_events_to_wait),
+      (num_events_to_wait == 0 ? nullptr : wait_events.data()), &evnt);
+
+  if (error_code == CL_SUCCESS) {
+    count_transfer(q, buffer_id, size,
+                   clEnqueueBuffer == &clEnqueueWriteBuffer, evnt,
+                   wait_events);
+  }
+  return error_code;
+}
+
 ::cl_int buffer_base::cl_enqueue_buffer(
     queue* q, ::size_t size, void* host_ptr,
     const vector_class<cl_event>& wait_events, cl_event& evnt,
     clEnqueueBuffer_f clEnqueueBuffer) {
-  auto num_events_to_wait = wait_events.size();
+  if (!soa_arrays.empty()) {
+    return cl_enqueue_soa(q, host_ptr, wait_events, evnt, clEnqueueBuffer);
+  }
+  if (is_strided()) {
+    return cl_enqueue_rect(q, host_ptr, wait_events, evnt, clEnqueueBuffer);
+  }
+  if (is_file_backed && clEnqueueBuffer == &clEnqueueWriteBuffer) {
+    return cl_upload_once(q, size, host_ptr, wait_events, evnt);
+  }
+  return enqueue_range(q, buffer_id, device_data.get(), 0, size, host_ptr,
+                       wait_events, evnt, clEnqueueBuffer);
+}
 
-  return clEnqueueBuffer(
-      q->get(), device_data.get(), false,
-      // TODO(progtx): Sub-buffer access
-      0, size, host_ptr, static_cast<::cl_uint>(num_events_to_wait),
-      (num_events_to_wait == 0 ? nullptr : wait_events.data()), &evnt);
+// The rows of the sub-buffer are packed on the device
+// and spread over the rows of its parent on the host
+::cl_int buffer_base::cl_enqueue_rect(queue* q, void* host_ptr,
+                                      const vector_class<cl_event>& wait_events,
+                                      cl_event& evnt,
+                                      clEnqueueBuffer_f clEnqueueBuffer) {
+  static const ::size_t origin[3] = {0, 0, 0};
+  auto num_events_to_wait = static_cast<::cl_uint>(wait_events.size());
+  auto wait_list = (num_events_to_wait == 0 ? nullptr : wait_events.data());
+  auto row_pitch = rect_region[0];
+  auto slice_pitch = row_pitch * rect_region[1];
+  bool is_upload = (clEnqueueBuffer == &clEnqueueWriteBuffer);
+
+  ::cl_int error_code;
+  if (is_upload) {
+    error_code = clEnqueueWriteBufferRect(
+        q->get(), device_data.get(), false, origin, origin,
+        rect_region.data(), row_pitch, slice_pitch, host_row_pitch,
+        host_slice_pitch, host_ptr, num_events_to_wait, wait_list, &evnt);
+  } else {
+    error_code = clEnqueueReadBufferRect(
+        q->get(), device_data.get(), false, origin, origin,
+        rect_region.data(), row_pitch, slice_pitch, host_row_pitch,
+        host_slice_pitch, host_ptr, num_events_to_wait, wait_list, &evnt);
+  }
+
+  if (error_code == CL_SUCCESS) {
+    count_transfer(q, buffer_id, slice_pitch * rect_region[2], is_upload,
+                   evnt, wait_events);
+  }
+  return error_code;
+}
+
+// Each array starts at a multiple of this,
+// so that the first element of every array starts a memory transaction
+static const ::size_t soa_alignment = 128;
+
+void buffer_base::set_soa_layout(const vector_class<field_info>& fields,
+                                 ::size_t element_size, ::size_t count) {
+  soa_arrays.clear();
+  ::size_t offset = 0;
+  for (auto& field : fields) {
+    offset = (offset + soa_alignment - 1) / soa_alignment * soa_alignment;
+    soa_arrays.push_back({field, offset});
+    offset += field.size * count;
+  }
+  soa_size = offset;
+  soa_count = count;
+  soa_element_size = element_size;
+  soa_data = shared_ptr_class<char>(new char[soa_size],
+                                    std::default_delete<char[]>());
+}
+
+void buffer_base::to_soa(const void* host_ptr) {
+  auto host = static_cast<const char*>(host_ptr);
+  for (auto& arr : soa_arrays) {
+    auto size = arr.field.size;
+    auto source = host + arr.field.offset;
+    auto dest = soa_data.get() + arr.offset;
+    for (::size_t i = 0; i < soa_count; ++i) {
+      std::memcpy(dest + i * size, source + i * soa_element_size, size);
+    }
+  }
+}
+
+void buffer_base::from_soa(void* host_ptr) {
+  auto host = static_cast<char*>(host_ptr);
+  for (auto& arr : soa_arrays) {
+    auto size = arr.field.size;
+    auto source = soa_data.get() + arr.offset;
+    auto dest = host + arr.field.offset;
+    for (::size_t i = 0; i < soa_count; ++i) {
+      std::memcpy(dest + i * soa_element_size, source + i * size, size);
+    }
+  }
+}
+
+// The host copy of the device memory is only transposed
+// once the commands before the transfer are done,
+// and a download is waited for before it is transposed into the structs
+::cl_int buffer_base::cl_enqueue_soa(queue* q, void* host_ptr,
+                                     const vector_class<cl_event>& wait_events,
+                                     cl_event& evnt,
+                                     clEnqueueBuffer_f clEnqueueBuffer) {
+  bool is_upload = (clEnqueueBuffer == &clEnqueueWriteBuffer);
+  ::cl_int error_code;
+  if (is_upload) {
+    if (!wait_events.empty()) {
+      error_code = clWaitForEvents(static_cast<::cl_uint>(wait_events.size()),
+                                   wait_events.data());
+      if (error_code != CL_SUCCESS) {
+        return error_code;
+      }
+    }
+    to_soa(host_ptr);
+  }
+
+  error_code = enqueue_range(q, buffer_id, device_data.get(), 0, soa_size,
+                             soa_data.get(), wait_events, evnt,
+                             clEnqueueBuffer);
+  if (error_code != CL_SUCCESS || is_upload) {
+    return error_code;
+  }
+
+  error_code = clWaitForEvents(1, &evnt);
+  if (error_code == CL_SUCCESS) {
+    from_soa(host_ptr);
+  }
+  return error_code;
+}
+
+// The file is uploaded in chunks,
+// so that reading its pages overlaps with the transfers of earlier chunks.
+// Later uploads only wait for the first one.
+::cl_int buffer_base::cl_upload_once(queue* q, ::size_t size, void* host_ptr,
+                                     const vector_class<cl_event>& wait_events,
+                                     cl_event& evnt) {
+  static const ::size_t chunk_size = 4 << 20;
+
+  std::lock_guard<mutex_class> lock(events_lock);
+  if (uploaded.get() != nullptr) {
+    auto upload_event = uploaded.get();
+    return clEnqueueMarkerWithWaitList(q->get(), 1, &upload_event, &evnt);
+  }
+
+  // The queue is in order, only the last chunk needs to be waited for
+  const vector_class<cl_event> no_events;
+  ::cl_int error_code = CL_SUCCESS;
+  cl_event chunk_event = nullptr;
+  for (::size_t offset = 0; offset < size; offset += chunk_size) {
+    if (chunk_event != nullptr) {
+      clReleaseEvent(chunk_event);
+    }
+    error_code = enqueue_range(
+        q, buffer_id, device_data.get(), offset,
+        std::min(chunk_size, size - offset), host_ptr,
+        (offset == 0 ? wait_events : no_events), chunk_event,
+        &clEnqueueWriteBuffer);
+    if (error_code != CL_SUCCESS) {
+      return error_code;
+    }
+  }
+  evnt = chunk_event;
+  uploaded = event(evnt);
+  return error_code;
+}
+
+static cl_mem create_mem(queue* q, ::size_t buffer_id,
+                         const cl_mem_flags& flags, ::size_t size,
+                         void* host_ptr, ::cl_int& error_code) {
+  auto& stats = counters::get(q);
+  stats->add(info::counter::buffers_created);
+  stats->add(info::counter::bytes_allocated, size);
+
+  if (!profiler::is_enabled(q)) {
+    return clCreateBuffer(q->get_context().get(), flags, size, host_ptr,
+                          &error_code);
+  }
+
+  // Not enqueued, timed on the host
+  auto start = profiler::host_time();
+  auto mem = clCreateBuffer(q->get_context().get(), flags, size, host_ptr,
+                            &error_code);
+  profiler::add_buffer(q, profiler::command_t::create_buffer, buffer_id, size,
+                       start, profiler::host_time());
+  return mem;
 }
 
 cl_mem buffer_base::cl_create_buffer(queue* q, const cl_mem_flags& flags,
                                      ::size_t size, void* host_ptr,
+                                     bool has_host_data,
                                      ::cl_int& error_code) {
-  return clCreateBuffer(q->get_context().get(), flags, size, host_ptr,
-                        &error_code);
+  auto& manager = memory_manager::get(q);
+  if (has_host_data) {
+    memory = manager;
+    memory->allocate(q, this, size);
+  }
+
+  auto mem = create_mem(q, buffer_id, flags, size, host_ptr, error_code);
+  // Most devices only report this when the memory is first used
+  if ((error_code == CL_MEM_OBJECT_ALLOCATION_FAILURE ||
+       error_code == CL_OUT_OF_RESOURCES) &&
+      manager->evict_all(q, this) > 0) {
+    mem = create_mem(q, buffer_id, flags, size, host_ptr, error_code);
+  }
+
+  if (error_code != CL_SUCCESS) {
+    release_memory();
+  }
+  return mem;
+}
+
+void buffer_base::evict() {
+  // The readbacks bring the host data up to date
+  event::wait(events);
+  events.clear();
+  uploaded = event();
+  device_version = 0;
+  device_data.reset();
+  is_initialized = false;
+}
+
+void buffer_base::release_memory() {
+  if (memory != nullptr) {
+    memory->release(this);
+    memory = nullptr;
+  }
+}
+
+buffer_pins::buffer_pins(const buffer_pins& copy) : buffers(copy.buffers) {
+  for (auto buf : buffers) {
+    ++buf->pins;
+  }
+}
+
+buffer_pins::buffer_pins(buffer_pins&& move) noexcept
+    : buffers(std::move(move.buffers)) {
+  move.buffers.clear();
+}
+
+buffer_pins& buffer_pins::operator=(buffer_pins other) noexcept {
+  std::swap(buffers, other.buffers);
+  return *this;
+}
+
+buffer_pins::~buffer_pins() {
+  clear();
+}
+
+void buffer_pins::add(buffer_base* buf) {
+  memory_manager::touch(buf);
+  if (buffers.insert(buf).second) {
+    ++buf->pins;
+  }
+}
+
+void buffer_pins::clear() {
+  for (auto buf : buffers) {
+    --buf->pins;
+  }
+  buffers.clear();
 }
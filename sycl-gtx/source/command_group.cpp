@@ -2,6 +2,9 @@
 
 #include "SYCL/accessor.h"
 #include "SYCL/buffer.h"
+#include "SYCL/detail/compiler.h"
+#include "SYCL/detail/logger.h"
+#include "SYCL/detail/tracer.h"
 #include "SYCL/queue.h"
 #include <map>
 #include <unordered_set>
@@ -16,9 +19,34 @@ void command_group::exit() {
   detail::command::group_detail::last = nullptr;
 }
 
+bool command_group::is_build_done() const {
+  for (auto& build : builds) {
+    if (!build->is_done()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+::cl_int command_group::wait_for_builds() const {
+  for (auto& build : builds) {
+    auto error_code = build->wait();
+    if (error_code != CL_SUCCESS) {
+      return error_code;
+    }
+  }
+  return CL_SUCCESS;
+}
+
+void command_group::drop() {
+  SYCL_LOG(warning, build, "dropped", commands.size());
+  commands.clear();
+  pins.clear();
+}
+
 // TODO(progtx): Reschedules commands to achieve better performance
 void command_group::optimize() {
-  DSELF();
+  SYCL_LOG(trace, command, "commands", commands.size());
 
   auto size_to_keep = commands.size();
   std::map<command_t*, bool> keep;
@@ -73,6 +101,10 @@ void command_group::optimize() {
           --size_to_keep;
         }
       }
+    } else if (command.type == type_t::device_write) {
+      // The host data is older than the device data from now on,
+      // uploading it would overwrite the result
+      was_written.insert(command.data.buf_acc.data);
     }
   }
 
@@ -87,31 +119,48 @@ void command_group::optimize() {
   commands = std::move(saveResults);
 }
 
+static void log_command(const command::info& command) {
+  using command::type_t;
+  if (command.type == type_t::get_accessor ||
+      command.type == type_t::device_write) {
+    auto& acc = command.data.buf_acc;
+    SYCL_LOG(trace, command, command.type, acc.data, acc.mode, acc.target);
+  } else if (command.type == type_t::copy_data) {
+    auto& copy = command.data.buf_copy;
+    SYCL_LOG(trace, command, command.type, copy.buf.data, copy.buf.mode,
+             copy.buf.target, copy.mode);
+  } else {
+    SYCL_LOG(trace, command, command.type, command.name);
+  }
+}
+
 // Executes all commands in queue and removes them
 void command_group::flush(vector_class<cl_event> wait_events) {
-  DSELF() << q << q->get();
+  SYCL_LOG(trace, command, q, q->get());
+  detail::tracer::span span("command_group::flush");
 
   using detail::command::type_t;
 
   for (auto& command : commands) {
-    if (command.type == type_t::get_accessor) {
-      auto& acc = command.data.buf_acc;
-      auto d = debug();
-      d << command.type << acc.data << acc.mode << acc.target;
-    } else if (command.type == type_t::copy_data) {
-      auto& copy = command.data.buf_copy;
-      auto d = debug();
-      d << command.type << copy.buf.data << copy.buf.mode << copy.buf.target
-        << copy.mode;
-    } else {
-      debug() << "command:" << command.name;
+    if (SYCL_LOG_ENABLED(trace, command)) {
+      log_command(command);
     }
     command.function(q, wait_events);
   }
   commands.clear();
 
-  auto error = clFlush(q->get());
+  // Marks the completion of the whole group
+  cl_event marker;
+  auto error = clEnqueueMarkerWithWaitList(q->get(), 0, nullptr, &marker);
   detail::error::report(error);
+  events.events->completeEvent = event(marker);
+  events.events->endEvent = events.events->completeEvent;
+  clReleaseEvent(marker);
+  events.events->is_enqueued = true;
+
+  error = clFlush(q->get());
+  detail::error::report(error);
+  pins.clear();
 }
 
 using namespace detail;
@@ -147,6 +196,14 @@ void command::group_detail::add_buffer_access(buffer_access buf_acc,
   }
 }
 
+void command::group_detail::add_buffer_pin(buffer_base* buf) {
+  last->pins.add(buf);
+}
+
+void command::group_detail::add_build(shared_ptr_class<build_result> build) {
+  last->builds.push_back(std::move(build));
+}
+
 void command::group_detail::add_buffer_copy(
     buffer_access buf_acc, access::mode copy_mode,
     fn<buffer_base*, buffer_base::clEnqueueBuffer_f> function,
@@ -157,3 +214,11 @@ void command::group_detail::add_buffer_copy(
                        buffer, enqueue_function),
        type_t::copy_data, metadata(buffer_copy{buf_acc, copy_mode})});
 }
+
+void command::group_detail::add_device_write(buffer_access buf_acc,
+                                             command_f function,
+                                             string_class name) {
+  last->commands.push_back(
+      {name, std::move(function), type_t::device_write, metadata(buf_acc)});
+  last->read_buffers.insert(buf_acc.data);
+}
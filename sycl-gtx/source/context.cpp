@@ -32,6 +32,8 @@ context::context(cl_context c, const async_handler& asyncHandler,
     ctx = c;
     ctx.release_one();
   }
+  stats = detail::counters::find(c);
+  memory = detail::memory_manager::find(c);
 }
 
 context::context() : context(nullptr, detail::default_async_handler, false) {}
@@ -72,3 +74,19 @@ cl_context context::get() const {
 vector_class<device> context::get_devices() const {
   return detail::transform_vector<device>(get_info<info::context::devices>());
 }
+
+void context::reset_counters() {
+  stats->reset();
+}
+
+void context::set_memory_budget(::size_t bytes) {
+  memory->set_budget(bytes);
+}
+
+::size_t context::get_memory_budget() const {
+  return memory->get_budget();
+}
+
+::size_t context::get_memory_usage() const {
+  return memory->get_used();
+}
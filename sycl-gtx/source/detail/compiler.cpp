@@ -0,0 +1,232 @@
+#include "SYCL/detail/compiler.h"
+
+#include "SYCL/detail/debug.h"
+#include "SYCL/detail/kernel_store.h"
+#include "SYCL/detail/profiler.h"
+#include "SYCL/detail/thread_pool.h"
+#include "SYCL/detail/tracer.h"
+#include "SYCL/program.h"
+
+using namespace cl::sycl;
+using namespace detail;
+
+std::map<compiler::key_t, shared_ptr_class<build_result>> compiler::programs;
+mutex_class compiler::programs_lock;
+
+// A single thread runs the listeners,
+// so they can block on queues without starving the builds.
+static thread_pool& listener_pool() {
+  static thread_pool pool(1);
+  return pool;
+}
+
+static thread_pool& build_pool() {
+  // Builds notify listeners, so the listener pool has to outlive this one
+  listener_pool();
+  static thread_pool pool(thread_pool::hardware_threads());
+  return pool;
+}
+
+void build_result::finish(::cl_int build_error_code) {
+  vector_class<listener_f> to_notify;
+  {
+    std::lock_guard<mutex_class> guard(lock);
+    if (done) {
+      return;
+    }
+    done = true;
+    error_code = build_error_code;
+    to_notify.swap(listeners);
+  }
+  auto end_time = profiler::host_time();
+  stats->add(info::counter::programs_compiled);
+  stats->add(info::counter::programs_linked);
+  stats->add(info::counter::compile_time, end_time - start_time);
+  tracer::add_span("clBuildProgram", start_time, end_time);
+  if (build_error_code != CL_SUCCESS) {
+    report_build_log();
+  } else if (!code.empty()) {
+    kernel_store::extract(code, prog.get());
+  }
+  finished.notify_all();
+  compiler::notify_listeners(std::move(to_notify));
+}
+
+void build_result::finish_from_status() {
+  ::cl_int status_error = CL_SUCCESS;
+  for (auto& dev : devices) {
+    cl_build_status status;
+    auto error_code =
+        clGetProgramBuildInfo(prog.get(), dev.get(), CL_PROGRAM_BUILD_STATUS,
+                              sizeof(status), &status, nullptr);
+    if (error_code != CL_SUCCESS) {
+      finish(error_code);
+      return;
+    }
+    if (status == CL_BUILD_IN_PROGRESS) {
+      // The notification callback will finish the build
+      return;
+    }
+    if (status != CL_BUILD_SUCCESS) {
+      status_error = CL_BUILD_PROGRAM_FAILURE;
+    }
+  }
+  finish(status_error);
+}
+
+bool build_result::is_done() const {
+  std::lock_guard<mutex_class> guard(lock);
+  return done;
+}
+
+bool build_result::is_built() const {
+  std::lock_guard<mutex_class> guard(lock);
+  return done && error_code == CL_SUCCESS;
+}
+
+void build_result::report_build_log() const {
+  debug() << "Error while building program ->";
+  if (prog.get() != nullptr) {
+    for (auto dev : devices) {
+      program::report_compile_error(prog.get(), dev);
+    }
+  }
+}
+
+::cl_int build_result::wait() const {
+  std::unique_lock<mutex_class> guard(lock);
+  finished.wait(guard, [this]() { return done; });
+  return error_code;
+}
+
+cl_program build_result::get() const {
+  detail::error::report(wait());
+  return prog.get();
+}
+
+bool build_result::on_done(listener_f listener) {
+  std::lock_guard<mutex_class> guard(lock);
+  if (done) {
+    return false;
+  }
+  listeners.push_back(std::move(listener));
+  return true;
+}
+
+shared_ptr_class<kernel_binding> build_result::get_kernel(
+    const string_class& name) {
+  auto p = get();
+  std::lock_guard<mutex_class> guard(lock);
+  auto& binding = kernels[name];
+  if (binding == nullptr) {
+    ::cl_int error_code;
+    cl_kernel k = clCreateKernel(p, name.c_str(), &error_code);
+    detail::error::report(error_code);
+    binding.reset(new kernel_binding(k));
+    clReleaseKernel(k);
+  }
+  return binding;
+}
+
+shared_ptr_class<build_result> compiler::build(
+    const context& ctx, const vector_class<device>& devices,
+    const string_class& code, const string_class& options) {
+  key_t key(ctx.get(), get_cl_array(devices), options, code);
+
+  std::lock_guard<mutex_class> guard(programs_lock);
+  auto& stats = counters::get(ctx);
+  auto it = programs.find(key);
+  if (it != programs.end()) {
+    stats->add(info::counter::program_cache_hits);
+    return it->second;
+  }
+  stats->add(info::counter::program_cache_misses);
+
+  auto result = std::make_shared<build_result>();
+  result->devices = devices;
+  result->stats = stats;
+  if (kernel_store::is_extracting()) {
+    result->code = code;
+  }
+  programs.emplace(std::move(key), result);
+
+  // The cache keeps the result alive for the duration of the build
+  build_pool().add(std::bind(&compiler::run, result.get(), ctx, code, options));
+
+  return result;
+}
+
+void compiler::run(build_result* result, context ctx, string_class code,
+                   string_class options) {
+  result->start_time = profiler::host_time();
+  ::cl_int error_code;
+  auto p = create_program(result, ctx, code);
+  if (p != nullptr) {
+    result->stats->add(info::counter::programs_loaded);
+  } else {
+    const char* code_p = code.c_str();
+    ::size_t length = code.size();
+    p = clCreateProgramWithSource(ctx.get(), 1, &code_p, &length, &error_code);
+    if (error_code != CL_SUCCESS) {
+      result->finish(error_code);
+      return;
+    }
+  }
+  result->prog = p;
+  result->prog.release_one();
+
+  auto device_pointers = get_cl_array(result->devices);
+
+  // With a callback the implementation may return before the build is done.
+  // Programs created from binaries still have to be built.
+  error_code = clBuildProgram(p, static_cast<::cl_uint>(device_pointers.size()),
+                              device_pointers.data(), options.c_str(),
+                              &compiler::notify, result);
+  if (error_code != CL_SUCCESS) {
+    result->finish(error_code);
+  } else {
+    result->finish_from_status();
+  }
+}
+
+// Uses the binaries embedded ahead of time, if there are any for all devices
+cl_program compiler::create_program(build_result* result, const context& ctx,
+                                    const string_class& code) {
+  auto binaries = kernel_store::find(code, result->devices);
+  if (binaries.empty()) {
+    return nullptr;
+  }
+
+  auto num_devices = binaries.size();
+  vector_class<::size_t> lengths;
+  vector_class<const unsigned char*> pointers;
+  lengths.reserve(num_devices);
+  pointers.reserve(num_devices);
+  for (auto& bin : binaries) {
+    lengths.push_back(bin.size);
+    pointers.push_back(bin.data);
+  }
+  vector_class<::cl_int> binary_status(num_devices);
+  auto device_pointers = get_cl_array(result->devices);
+  ::cl_int error_code;
+
+  auto p = clCreateProgramWithBinary(
+      ctx.get(), static_cast<::cl_uint>(num_devices), device_pointers.data(),
+      lengths.data(), pointers.data(), binary_status.data(), &error_code);
+  if (error_code != CL_SUCCESS) {
+    // Binaries from another driver version, compile the source instead
+    debug() << "Embedded kernel binary rejected, error" << error_code;
+    return nullptr;
+  }
+  return p;
+}
+
+void CL_CALLBACK compiler::notify(cl_program prog, void* user_data) {
+  static_cast<build_result*>(user_data)->finish_from_status();
+}
+
+void compiler::notify_listeners(vector_class<build_result::listener_f> list) {
+  for (auto& listener : list) {
+    listener_pool().add(std::move(listener));
+  }
+}
@@ -0,0 +1,43 @@
+#include "SYCL/detail/counters.h"
+
+#include "SYCL/context.h"
+#include "SYCL/detail/profiler.h"
+#include "SYCL/queue.h"
+
+using namespace cl::sycl;
+using namespace detail;
+
+context_registry<counters> counters::registry;
+
+counters::timer::timer(counters* stats, info::counter param)
+    : stats(stats),
+      param(param),
+      start(stats == nullptr ? 0 : profiler::host_time()) {}
+
+counters::timer::~timer() {
+  if (stats != nullptr) {
+    stats->add(param, profiler::host_time() - start);
+  }
+}
+
+counters::counters() {
+  reset();
+}
+
+shared_ptr_class<counters> counters::find(cl_context ctx) {
+  return registry.find(ctx);
+}
+
+const shared_ptr_class<counters>& counters::get(const context& ctx) {
+  return ctx.stats;
+}
+
+const shared_ptr_class<counters>& counters::get(queue* q) {
+  return q->ctx.stats;
+}
+
+void counters::reset() {
+  for (auto& value : values) {
+    value.store(0, std::memory_order_relaxed);
+  }
+}
@@ -9,4 +9,8 @@ void detail::kernel_add(string_class line) {
   kernel_ns::source::add(line);
 }
 
+counter_t detail::kernel_temporary_id() {
+  return kernel_ns::source::next_temporary_id();
+}
+
 const string_class data_ref::open_parenthesis = "(";
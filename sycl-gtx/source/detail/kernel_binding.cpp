@@ -0,0 +1,34 @@
+#include "SYCL/detail/kernel_binding.h"
+
+#include "SYCL/error_handler.h"
+#include <cstring>
+
+using namespace cl::sycl;
+using namespace detail;
+
+void kernel_binding::set_arg(::cl_uint index, ::size_t size,
+                             const void* value) {
+  if (index >= args.size()) {
+    args.resize(index + 1);
+  }
+  auto& arg = args[index];
+  auto value_size = (value == nullptr ? 0 : size);
+
+  if (arg.is_set && arg.size == size && arg.value.size() == value_size &&
+      (value_size == 0 ||
+       std::memcmp(arg.value.data(), value, value_size) == 0)) {
+    return;
+  }
+
+  auto error_code = clSetKernelArg(kern.get(), index, size, value);
+  if (error_code != CL_SUCCESS) {
+    arg.is_set = false;
+    error::report(error_code);
+    return;
+  }
+
+  auto bytes = static_cast<const char*>(value);
+  arg.value.assign(bytes, bytes + value_size);
+  arg.size = size;
+  arg.is_set = true;
+}
@@ -1,6 +1,43 @@
 #include "SYCL/detail/kernel_name.h"
 
+#include <cstdlib>
+#if defined(__GNUC__)
+#include <cxxabi.h>
+#endif
+
 using namespace cl::sycl;
 using namespace detail;
 
-::size_t kernel_name::current_count = 0;
+std::atomic<::size_t> kernel_name::current_count(0);
+
+string_class kernel_name::demangle_pointer(const char* name) {
+  string_class result(name);
+#if defined(__GNUC__)
+  int status = 0;
+  char* demangled = abi::__cxa_demangle(name, nullptr, nullptr, &status);
+  if (status == 0 && demangled != nullptr) {
+    result = demangled;
+    std::free(demangled);
+  }
+#endif
+  // Names declared inside command group lambdas are scoped to the lambda,
+  // only the enclosing function is kept
+  static const string_class lambda_begin = "{lambda";
+  static const string_class lambda_end = ") const::";
+  auto begin = result.find(lambda_begin);
+  while (begin != string_class::npos) {
+    auto end = result.find(lambda_end, begin);
+    if (end == string_class::npos) {
+      break;
+    }
+    result.erase(begin, end + lambda_end.size() - begin);
+    begin = result.find(lambda_begin, begin);
+  }
+
+  // Drop the pointer from the name
+  auto end = result.find_last_not_of(" *");
+  if (end != string_class::npos && end + 1 < result.size()) {
+    result.erase(end + 1);
+  }
+  return result;
+}
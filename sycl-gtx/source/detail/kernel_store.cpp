@@ -0,0 +1,190 @@
+#include "SYCL/detail/kernel_store.h"
+
+#include "SYCL/context.h"
+#include "SYCL/detail/debug.h"
+#include "SYCL/device.h"
+#include "SYCL/program.h"
+#include <cctype>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+
+using namespace cl::sycl;
+using namespace detail;
+
+static mutex_class files_lock;
+
+static void write_file(const string_class& path, const void* data,
+                       ::size_t size) {
+  std::lock_guard<mutex_class> lock(files_lock);
+  std::ofstream file(path, std::ios::binary | std::ios::trunc);
+  file.write(static_cast<const char*>(data), size);
+  if (!file) {
+    debug() << "Unable to extract kernel to" << path;
+  }
+}
+
+kernel_store::registrar::registrar(const unsigned char* code, ::size_t size,
+                                   std::initializer_list<binary> binaries) {
+  // The embedded source is null terminated
+  auto& embedded = artifacts()[string_class(
+      reinterpret_cast<const char*>(code), size - 1)];
+  for (auto& bin : binaries) {
+    embedded.binaries[bin.device_name] = bin;
+  }
+}
+
+kernel_store::functor_registrar::functor_registrar(extract_f extract) {
+  functors().push_back(std::move(extract));
+}
+
+// Function local statics, so that registration works
+// regardless of the order in which static objects are initialized
+
+std::map<string_class, kernel_store::artifact>& kernel_store::artifacts() {
+  static std::map<string_class, artifact> embedded;
+  return embedded;
+}
+
+vector_class<kernel_store::extract_f>& kernel_store::functors() {
+  static vector_class<extract_f> registered;
+  return registered;
+}
+
+string_class& kernel_store::directory() {
+  static string_class dir = []() {
+    auto env = std::getenv("SYCL_GTX_EXTRACT_DIR");
+    return string_class(env == nullptr ? "" : env);
+  }();
+  return dir;
+}
+
+bool& kernel_store::with_binaries() {
+  static bool binaries = (std::getenv("SYCL_GTX_EXTRACT_BINARIES") != nullptr);
+  return binaries;
+}
+
+void kernel_store::extract_to(string_class dir, bool binaries) {
+  directory() = std::move(dir);
+  with_binaries() = binaries;
+}
+
+bool kernel_store::is_extracting() {
+  return !directory().empty();
+}
+
+void kernel_store::extract_registered(const context& ctx) {
+  static std::once_flag extracted;
+  if (!is_extracting()) {
+    return;
+  }
+  std::call_once(extracted, [&ctx]() {
+    for (auto& extract : functors()) {
+      program p(ctx);
+      extract(p);
+    }
+  });
+}
+
+void kernel_store::extract(const string_class& code) {
+  if (!is_extracting()) {
+    return;
+  }
+  write_file(directory() + "/" + hash(code) + ".cl", code.data(), code.size());
+}
+
+void kernel_store::extract(const string_class& code, cl_program prog) {
+  extract(code);
+  if (!is_extracting() || !with_binaries()) {
+    return;
+  }
+
+  // Binaries are listed in the order of the program devices
+  ::cl_uint num_devices = 0;
+  auto error_code =
+      clGetProgramInfo(prog, CL_PROGRAM_NUM_DEVICES, sizeof(num_devices),
+                       &num_devices, nullptr);
+  vector_class<cl_device_id> device_ids(num_devices);
+  vector_class<::size_t> sizes(num_devices);
+  if (error_code == CL_SUCCESS) {
+    error_code = clGetProgramInfo(prog, CL_PROGRAM_DEVICES,
+                                  num_devices * sizeof(cl_device_id),
+                                  device_ids.data(), nullptr);
+  }
+  if (error_code == CL_SUCCESS) {
+    error_code = clGetProgramInfo(prog, CL_PROGRAM_BINARY_SIZES,
+                                  num_devices * sizeof(::size_t), sizes.data(),
+                                  nullptr);
+  }
+
+  vector_class<vector_class<unsigned char>> binaries;
+  vector_class<unsigned char*> pointers;
+  binaries.reserve(num_devices);
+  for (auto size : sizes) {
+    binaries.emplace_back(size);
+    pointers.push_back(binaries.back().data());
+  }
+  if (error_code == CL_SUCCESS) {
+    error_code = clGetProgramInfo(prog, CL_PROGRAM_BINARIES,
+                                  num_devices * sizeof(unsigned char*),
+                                  pointers.data(), nullptr);
+  }
+  if (error_code != CL_SUCCESS) {
+    debug() << "Unable to extract kernel binaries, error" << error_code;
+    return;
+  }
+
+  auto name = directory() + "/" + hash(code) + ".";
+  for (::cl_uint i = 0; i < num_devices; ++i) {
+    if (sizes[i] > 0) {
+      write_file(name + device_name(device(device_ids[i])) + ".bin",
+                 pointers[i], sizes[i]);
+    }
+  }
+}
+
+vector_class<kernel_store::binary> kernel_store::find(
+    const string_class& code, const vector_class<device>& devices) {
+  vector_class<binary> found;
+  auto it = artifacts().find(code);
+  if (it == artifacts().end()) {
+    return found;
+  }
+
+  for (auto& dev : devices) {
+    auto bin = it->second.binaries.find(device_name(dev));
+    if (bin == it->second.binaries.end()) {
+      return {};
+    }
+    found.push_back(bin->second);
+  }
+  return found;
+}
+
+string_class kernel_store::hash(const string_class& code) {
+  // 64-bit FNV-1a, the same on every platform
+  std::uint64_t value = 14695981039346656037ull;
+  for (auto c : code) {
+    value ^= static_cast<unsigned char>(c);
+    value *= 1099511628211ull;
+  }
+
+  static const char digits[] = "0123456789abcdef";
+  string_class name(16, '0');
+  for (auto i = name.rbegin(); i != name.rend(); ++i) {
+    *i = digits[value & 0xf];
+    value >>= 4;
+  }
+  return name;
+}
+
+string_class kernel_store::device_name(const device& dev) {
+  // Drop the terminating null of the info string
+  string_class name = dev.get_info<info::device::name>().c_str();
+  for (auto& c : name) {
+    if (!std::isalnum(static_cast<unsigned char>(c))) {
+      c = '_';
+    }
+  }
+  return name;
+}
@@ -0,0 +1,201 @@
+#include "SYCL/detail/logger.h"
+
+#include "SYCL/detail/profiler.h"
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+
+using namespace cl::sycl;
+using namespace detail;
+
+static const ::size_t ring_size = 1024;
+
+static logger::entry ring[ring_size];
+static std::atomic<std::uint64_t> next_index(0);
+
+static std::uint32_t level_mask(logger::level_t level,
+                                std::uint32_t categories) {
+  std::uint32_t result = 0;
+  for (unsigned int l = 0; l <= static_cast<unsigned int>(level); ++l) {
+    result |= (categories & logger::all_categories)
+              << (l * logger::num_categories);
+  }
+  return result;
+}
+
+static bool parse_level(const string_class& name, logger::level_t& level) {
+  auto num_levels = static_cast<unsigned int>(logger::level_t::trace) + 1;
+  for (unsigned int l = 0; l < num_levels; ++l) {
+    if (name == logger::level_name(static_cast<logger::level_t>(l))) {
+      level = static_cast<logger::level_t>(l);
+      return true;
+    }
+  }
+  return false;
+}
+
+static std::uint32_t parse_categories(const string_class& list) {
+  std::uint32_t categories = 0;
+  std::stringstream stream(list);
+  string_class name;
+  while (std::getline(stream, name, ',')) {
+    for (unsigned int c = 0; c < logger::num_categories; ++c) {
+      auto category = static_cast<logger::category_t>(c);
+      if (name == logger::category_name(category)) {
+        categories |= 1u << c;
+      }
+    }
+  }
+  return categories;
+}
+
+static const char* log_environment() {
+  return std::getenv("SYCL_GTX_LOG");
+}
+
+// SYCL_GTX_LOG=level[:category,category...]
+static std::uint32_t initial_mask() {
+  auto env = log_environment();
+  if (env == nullptr) {
+    return level_mask(logger::level_t::warning, logger::all_categories);
+  }
+  string_class setting(env);
+  auto separator = setting.find(':');
+  auto level = logger::level_t::warning;
+  if (!parse_level(setting.substr(0, separator), level)) {
+    debug::warning("SYCL_GTX_LOG") << "unknown level" << setting;
+  }
+  auto categories = logger::all_categories;
+  if (separator != string_class::npos) {
+    categories = parse_categories(setting.substr(separator + 1));
+  }
+  return level_mask(level, categories);
+}
+
+std::atomic<std::uint32_t> logger::mask(initial_mask());
+
+// Writes the log at exit when it was requested through the environment
+struct log_at_exit {
+  ~log_at_exit() {
+    if (log_environment() != nullptr) {
+      logger::dump(std::cerr);
+    }
+  }
+};
+static log_at_exit at_exit;
+
+logger::entry& logger::begin_entry(level_t level, category_t category,
+                                   const char* function) {
+  auto index = next_index.fetch_add(1, std::memory_order_relaxed);
+  auto& e = ring[index % ring_size];
+  e.sequence.store(2 * index + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  e.time = profiler::host_time();
+  e.level = level;
+  e.category = category;
+  e.function = function;
+  return e;
+}
+
+void logger::end_entry(entry& e) {
+  e.sequence.store(e.sequence.load(std::memory_order_relaxed) + 1,
+                   std::memory_order_release);
+}
+
+void logger::set_level(level_t level, std::uint32_t categories) {
+  mask.store(level_mask(level, categories), std::memory_order_relaxed);
+}
+
+void logger::disable() {
+  mask.store(0, std::memory_order_relaxed);
+}
+
+static void format(std::ostream& os, const logger::argument& arg) {
+  using kind_t = logger::argument::kind_t;
+  switch (arg.kind) {
+    case kind_t::signed_int:
+      os << arg.value.i;
+      break;
+    case kind_t::unsigned_int:
+      os << arg.value.u;
+      break;
+    case kind_t::floating:
+      os << arg.value.d;
+      break;
+    case kind_t::pointer:
+      os << arg.value.p;
+      break;
+    case kind_t::name:
+      os << arg.value.name;
+      break;
+    case kind_t::text:
+      os << arg.value.text;
+      break;
+  }
+}
+
+void logger::dump(std::ostream& os) {
+  auto end = next_index.load(std::memory_order_acquire);
+  auto begin = (end > ring_size ? end - ring_size : 0);
+  entry copy;
+  for (auto index = begin; index < end; ++index) {
+    auto& e = ring[index % ring_size];
+    auto complete = 2 * index + 2;
+    if (e.sequence.load(std::memory_order_acquire) != complete) {
+      continue;
+    }
+    copy.time = e.time;
+    copy.level = e.level;
+    copy.category = e.category;
+    copy.function = e.function;
+    copy.num_arguments = e.num_arguments;
+    std::memcpy(copy.arguments, e.arguments, sizeof(copy.arguments));
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (e.sequence.load(std::memory_order_relaxed) != complete) {
+      continue;
+    }
+
+    os << copy.time << ' ' << level_name(copy.level) << ' '
+       << category_name(copy.category) << ' ' << copy.function << ':';
+    for (unsigned int i = 0; i < copy.num_arguments; ++i) {
+      os << ' ';
+      format(os, copy.arguments[i]);
+    }
+    os << '\n';
+  }
+  os.flush();
+}
+
+const char* logger::level_name(level_t level) {
+  switch (level) {
+    case level_t::error:
+      return "error";
+    case level_t::warning:
+      return "warning";
+    case level_t::info:
+      return "info";
+    case level_t::trace:
+    default:
+      return "trace";
+  }
+}
+
+const char* logger::category_name(category_t category) {
+  switch (category) {
+    case category_t::sync:
+      return "sync";
+    case category_t::command:
+      return "command";
+    case category_t::kernel:
+      return "kernel";
+    case category_t::build:
+      return "build";
+    case category_t::buffer:
+      return "buffer";
+    case category_t::queue:
+      return "queue";
+    case category_t::general:
+    default:
+      return "general";
+  }
+}
@@ -0,0 +1,173 @@
+#include "SYCL/detail/memory_manager.h"
+
+#include "SYCL/buffer_base.h"
+#include "SYCL/context.h"
+#include "SYCL/detail/counters.h"
+#include "SYCL/detail/logger.h"
+#include "SYCL/queue.h"
+#include <algorithm>
+#include <cstdlib>
+#include <limits>
+
+using namespace cl::sycl;
+using namespace detail;
+
+context_registry<memory_manager> memory_manager::registry;
+std::atomic<cl_ulong> memory_manager::clock(0);
+
+static ::size_t default_budget(queue* q) {
+  auto env = std::getenv("SYCL_GTX_MEMORY_BUDGET");
+  if (env != nullptr) {
+    auto bytes = std::strtoull(env, nullptr, 10);
+    if (bytes > 0) {
+      return static_cast<::size_t>(bytes);
+    }
+  }
+  return static_cast<::size_t>(
+      q->get_device().get_info<info::device::global_mem_size>());
+}
+
+shared_ptr_class<memory_manager> memory_manager::find(cl_context ctx) {
+  return registry.find(ctx);
+}
+
+const shared_ptr_class<memory_manager>& memory_manager::get(
+    const context& ctx) {
+  return ctx.memory;
+}
+
+const shared_ptr_class<memory_manager>& memory_manager::get(queue* q) {
+  return q->ctx.memory;
+}
+
+void memory_manager::touch(buffer_base* buf) {
+  buf->last_use = ++clock;
+}
+
+void memory_manager::allocate(queue* q, buffer_base* buf, ::size_t size) {
+  touch(buf);
+  vector_class<victim> victims;
+  {
+    std::lock_guard<mutex_class> guard(lock);
+    if (budget == 0) {
+      budget = default_budget(q);
+    }
+    if (allocations.count(buf) > 0) {
+      return;
+    }
+    if (used + size > budget) {
+      victims = choose_victims(used + size - budget, buf);
+    }
+    // Still allocated when nothing more can be evicted,
+    // the device may have more memory than the budget
+    used += size;
+    allocations.emplace(buf, size);
+  }
+  evict(victims, counters::get(q).get());
+}
+
+vector_class<memory_manager::victim> memory_manager::choose_victims(
+    ::size_t bytes, buffer_base* keep) {
+  vector_class<std::pair<cl_ulong, buffer_base*>> candidates;
+  candidates.reserve(allocations.size());
+  for (auto& allocation : allocations) {
+    if (allocation.first != keep) {
+      candidates.emplace_back(allocation.first->last_use.load(),
+                              allocation.first);
+    }
+  }
+  std::sort(candidates.begin(), candidates.end());
+
+  vector_class<victim> victims;
+  ::size_t freed = 0;
+  for (auto& candidate : candidates) {
+    if (freed >= bytes) {
+      break;
+    }
+    auto buf = candidate.second;
+    // A buffer locked by another thread is being used right now
+    std::unique_lock<mutex_class> buf_lock(buf->events_lock,
+                                           std::try_to_lock);
+    if (!buf_lock.owns_lock() || buf->pins > 0 || !buf->is_initialized) {
+      continue;
+    }
+
+    auto it = allocations.find(buf);
+    auto size = it->second;
+    allocations.erase(it);
+    used -= size;
+    freed += size;
+    victims.push_back({buf, size, std::move(buf_lock)});
+  }
+  return victims;
+}
+
+::size_t memory_manager::evict(vector_class<victim>& victims,
+                               counters* stats) {
+  ::size_t freed = 0;
+  for (auto& v : victims) {
+    // A buffer being destroyed waits for its events_lock after its release,
+    // so the buffer stays alive while the lock is held
+    v.buf->evict();
+    SYCL_LOG(info, buffer, "evicted", v.buf, v.size);
+    v.buf_lock.unlock();
+    freed += v.size;
+    if (stats != nullptr) {
+      stats->add(info::counter::buffers_evicted);
+      stats->add(info::counter::bytes_evicted, v.size);
+    }
+  }
+  return freed;
+}
+
+::size_t memory_manager::evict_all(queue* q, buffer_base* keep) {
+  vector_class<victim> victims;
+  {
+    std::lock_guard<mutex_class> guard(lock);
+    victims = choose_victims(std::numeric_limits<::size_t>::max(), keep);
+  }
+  return evict(victims, counters::get(q).get());
+}
+
+void memory_manager::release(buffer_base* buf) {
+  std::lock_guard<mutex_class> guard(lock);
+  auto it = allocations.find(buf);
+  if (it != allocations.end()) {
+    used -= it->second;
+    allocations.erase(it);
+  }
+}
+
+memory_manager::constant_limits memory_manager::get_constant_limits(
+    const vector_class<device>& devices) {
+  constant_limits common = {std::numeric_limits<cl_ulong>::max(),
+                            std::numeric_limits<cl_uint>::max()};
+  std::lock_guard<mutex_class> guard(lock);
+  for (auto& dev : devices) {
+    auto it = device_limits.find(dev.get());
+    if (it == device_limits.end()) {
+      constant_limits limits = {
+          dev.get_info<info::device::max_constant_buffer_size>(),
+          dev.get_info<info::device::max_constant_args>()};
+      it = device_limits.emplace(dev.get(), limits).first;
+    }
+    common.max_size = std::min(common.max_size, it->second.max_size);
+    common.max_args = std::min(common.max_args, it->second.max_args);
+  }
+  return common;
+}
+
+void memory_manager::set_budget(::size_t bytes) {
+  std::lock_guard<mutex_class> guard(lock);
+  budget = bytes;
+}
+
+::size_t memory_manager::get_budget() {
+  std::lock_guard<mutex_class> guard(lock);
+  return budget;
+}
+
+::size_t memory_manager::get_used() {
+  std::lock_guard<mutex_class> guard(lock);
+  return used;
+}
@@ -0,0 +1,209 @@
+#include "SYCL/detail/profiler.h"
+
+#include "SYCL/detail/tracer.h"
+#include "SYCL/queue.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <map>
+#include <ostream>
+#include <sstream>
+#include <tuple>
+
+using namespace cl::sycl;
+using namespace detail;
+
+static const char* command_name(profiler::command_t type) {
+  switch (type) {
+    case profiler::command_t::create_buffer:
+      return "create";
+    case profiler::command_t::upload:
+      return "upload";
+    case profiler::command_t::download:
+      return "download";
+    case profiler::command_t::kernel:
+    default:
+      return "kernel";
+  }
+}
+
+static cl_ulong get_time(cl_event evnt, cl_profiling_info param) {
+  cl_ulong value = 0;
+  auto error_code = clGetEventProfilingInfo(evnt, param, sizeof(value),
+                                            &value, nullptr);
+  return (error_code == CL_SUCCESS ? value : 0);
+}
+
+// Nearest rank percentile of sorted values
+static cl_ulong percentile(const vector_class<cl_ulong>& sorted,
+                           ::size_t percent) {
+  auto rank = (sorted.size() * percent + 99) / 100;
+  return sorted[std::max<::size_t>(rank, 1) - 1];
+}
+
+profiler::profiler(bool requested) : requested(requested) {}
+
+profiler* profiler::get(queue* q) {
+  return q->prof.get();
+}
+
+// Only passed on to the tracer if no statistics were requested,
+// the queue would otherwise keep every event until it is destroyed
+void profiler::add(record rec) {
+  if (!requested) {
+    return;
+  }
+  std::lock_guard<mutex_class> guard(lock);
+  records.push_back(std::move(rec));
+}
+
+void profiler::resolve() {
+  for (; num_resolved < records.size(); ++num_resolved) {
+    auto& rec = records[num_resolved];
+    auto evnt = rec.evnt.get();
+    if (evnt == nullptr) {
+      continue;
+    }
+    rec.queued = get_time(evnt, CL_PROFILING_COMMAND_QUEUED);
+    rec.submit = get_time(evnt, CL_PROFILING_COMMAND_SUBMIT);
+    rec.start = get_time(evnt, CL_PROFILING_COMMAND_START);
+    rec.end = get_time(evnt, CL_PROFILING_COMMAND_END);
+    // The event is no longer needed
+    rec.evnt = event();
+  }
+}
+
+vector_class<profiler::stats> profiler::aggregate(bool kernels) {
+  using key_t = std::tuple<string_class, command_t>;
+  std::map<key_t, vector_class<const record*>> groups;
+
+  std::lock_guard<mutex_class> guard(lock);
+  resolve();
+  for (auto& rec : records) {
+    if ((rec.type == command_t::kernel) == kernels) {
+      groups[key_t(rec.name, rec.type)].push_back(&rec);
+    }
+  }
+
+  vector_class<stats> result;
+  result.reserve(groups.size());
+  for (auto& group : groups) {
+    stats s = {std::get<1>(group.first), std::get<0>(group.first), 0, 0, 0,
+               0, 0, 0, 0.0};
+    vector_class<cl_ulong> durations;
+    durations.reserve(group.second.size());
+    for (auto rec : group.second) {
+      auto duration = (rec->end > rec->start ? rec->end - rec->start : 0);
+      durations.push_back(duration);
+      s.total += duration;
+      s.bytes += rec->bytes;
+    }
+    std::sort(durations.begin(), durations.end());
+    s.count = durations.size();
+    s.median = percentile(durations, 50);
+    s.p90 = percentile(durations, 90);
+    s.p99 = percentile(durations, 99);
+    if (s.total > 0) {
+      s.bandwidth = s.bytes * 1e9 / s.total;
+    }
+    result.push_back(std::move(s));
+  }
+  return result;
+}
+
+bool profiler::is_enabled_by_default() {
+  static const bool enabled = (std::getenv("SYCL_GTX_PROFILE") != nullptr);
+  return enabled;
+}
+
+cl_ulong profiler::host_time() {
+  using namespace std::chrono;
+  return static_cast<cl_ulong>(
+      duration_cast<nanoseconds>(steady_clock::now().time_since_epoch())
+          .count());
+}
+
+bool profiler::is_enabled(queue* q) {
+  return get(q) != nullptr;
+}
+
+void profiler::add_kernel(queue* q, const string_class& name, cl_event evnt,
+                          const vector_class<cl_event>& wait_events) {
+  auto prof = get(q);
+  if (prof != nullptr) {
+    prof->add({command_t::kernel, name, 0, event(evnt), 0, 0, 0, 0});
+    tracer::add_command(q->get(), name, "kernel", evnt, wait_events);
+  }
+}
+
+void profiler::add_buffer(queue* q, command_t type, ::size_t buffer_id,
+                          ::size_t bytes, cl_event evnt,
+                          const vector_class<cl_event>& wait_events) {
+  auto prof = get(q);
+  if (prof != nullptr) {
+    std::stringstream name;
+    name << "buffer " << buffer_id;
+    prof->add({type, name.str(), bytes, event(evnt), 0, 0, 0, 0});
+    tracer::add_command(q->get(),
+                        string_class(command_name(type)) + " " + name.str(),
+                        "transfer", evnt, wait_events);
+  }
+}
+
+void profiler::add_buffer(queue* q, command_t type, ::size_t buffer_id,
+                          ::size_t bytes, cl_ulong start, cl_ulong end) {
+  auto prof = get(q);
+  if (prof != nullptr) {
+    std::stringstream name;
+    name << "buffer " << buffer_id;
+    prof->add({type, name.str(), bytes, event(), start, start, start, end});
+    tracer::add_span("clCreateBuffer", start, end);
+  }
+}
+
+vector_class<profiler::record> profiler::get_log() {
+  std::lock_guard<mutex_class> guard(lock);
+  resolve();
+  return records;
+}
+
+vector_class<profiler::stats> profiler::kernel_stats() {
+  return aggregate(true);
+}
+
+vector_class<profiler::stats> profiler::buffer_stats() {
+  return aggregate(false);
+}
+
+void profiler::report(std::ostream& os) {
+  auto kernels = kernel_stats();
+  auto buffers = buffer_stats();
+  if (kernels.empty() && buffers.empty()) {
+    return;
+  }
+
+  auto flags = os.flags();
+  os << "Profile (times in us):\n";
+  os << std::left << std::setw(10) << "command" << std::setw(32) << "name"
+     << std::right << std::setw(8) << "count" << std::setw(12) << "total"
+     << std::setw(10) << "median" << std::setw(10) << "p90" << std::setw(10)
+     << "p99" << std::setw(14) << "bytes" << std::setw(10) << "GB/s"
+     << '\n';
+  os << std::fixed << std::setprecision(1);
+  for (auto list : {&kernels, &buffers}) {
+    for (auto& s : *list) {
+      os << std::left << std::setw(10) << command_name(s.type)
+         << std::setw(32) << s.name << std::right << std::setw(8) << s.count
+         << std::setw(12) << s.total / 1e3 << std::setw(10) << s.median / 1e3
+         << std::setw(10) << s.p90 / 1e3 << std::setw(10) << s.p99 / 1e3
+         << std::setw(14) << s.bytes << std::setprecision(2) << std::setw(10)
+         << s.bandwidth / 1e9 << std::setprecision(1) << '\n';
+    }
+  }
+  os.flags(flags);
+}
+
+bool profiler::is_requested() const {
+  return requested;
+}
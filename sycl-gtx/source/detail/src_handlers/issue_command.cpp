@@ -2,7 +2,9 @@
 
 #include "SYCL/accessors/buffer.h"
 #include "SYCL/buffer.h"
+#include "SYCL/detail/logger.h"
 #include "SYCL/kernel.h"
+#include "SYCL/queue.h"
 
 using namespace cl::sycl;
 using detail::issue_command;
@@ -14,42 +16,42 @@ void issue_command::compile_command(queue* q,
                                     source src, shared_ptr_class<kernel> kern) {
 }
 
-void issue_command::prepare_kernel(shared_ptr_class<kernel> kern) {
-  DSELF() << kern->src.kernel_name;
-  auto k = kern->get();
-  ::cl_int error_code;
-  int i = 0;
+std::unique_lock<mutex_class> issue_command::prepare_kernel(
+    shared_ptr_class<kernel> kern) {
+  SYCL_LOG(trace, kernel, kern->src.kernel_name);
+  kern->finish_build();
+  auto& binding = *kern->binding;
+  std::unique_lock<mutex_class> lock(binding.lock);
+  ::cl_uint i = 0;
   for (auto& acc : kern->src.resources) {
-    if (acc.second.acc.target == access::target::local) {
-      error_code = clSetKernelArg(k, i, acc.second.size, nullptr);
+    if (acc.acc.target == access::target::local) {
+      binding.set_arg(i, acc.size, nullptr);
     } else {
-      auto mem = acc.second.acc.data->device_data.get();
-      error_code = clSetKernelArg(k, i, acc.second.size, &mem);
+      auto mem = acc.acc.data->device_data.get();
+      binding.set_arg(i, acc.size, &mem);
     }
-    detail::error::report(error_code);
     ++i;
   }
+  return lock;
 }
 
 void issue_command::write_buffers_to_device(shared_ptr_class<kernel> kern) {
   for (auto& acc : kern->src.resources) {
-    auto mode = acc.second.acc.mode;
+    auto mode = acc.acc.mode;
     if (mode == access::mode::write || mode == access::mode::discard_write ||
         mode == access::mode::discard_read_write ||
-        acc.second.acc.target == access::target::local) {
+        acc.acc.target == access::target::local) {
       // Don't need to copy data that won't be used
       continue;
     }
-    command::group_detail::add_buffer_copy(
-        acc.second.acc, access::mode::write, buffer_base::enqueue_command,
-        __func__, acc.second.acc.data, &clEnqueueWriteBuffer);
+    upload(acc.acc);
   }
 }
 
 void issue_command::enqueue_task_command(
     queue* q, const vector_class<cl_event>& wait_events,
     shared_ptr_class<kernel> kern, event* evnt) {
-  prepare_kernel(kern);
+  auto lock = prepare_kernel(kern);
   kern->enqueue_task(q, wait_events, evnt);
 }
 
@@ -60,15 +62,152 @@ void issue_command::enqueue_task(shared_ptr_class<kernel> kern, event* evnt) {
 
 void issue_command::read_buffers_from_device(shared_ptr_class<kernel> kern) {
   for (auto& acc : kern->src.resources) {
-    if (acc.second.acc.mode == access::mode::read ||
-        acc.second.acc.target == access::target::local) {
+    if (acc.acc.mode == access::mode::read ||
+        acc.acc.target == access::target::local) {
       // Don't need to read back read-only buffers
       continue;
     }
-    command::group_detail::add_buffer_copy(
-        acc.second.acc, access::mode::read, buffer_base::enqueue_command,
-        __func__, acc.second.acc.data,
-        reinterpret_cast<buffer_base::clEnqueueBuffer_f>(  // NOLINT
-            &clEnqueueReadBuffer));
+    read_back(acc.acc);
+  }
+}
+
+void issue_command::upload(buffer_access acc) {
+  command::group_detail::add_buffer_copy(acc, access::mode::write,
+                                         buffer_base::enqueue_command,
+                                         __func__, acc.data,
+                                         &clEnqueueWriteBuffer);
+}
+
+void issue_command::upload_changed(buffer_access acc) {
+  command::group_detail::add_buffer_copy(acc, access::mode::write,
+                                         upload_changed_command, __func__,
+                                         acc.data, &clEnqueueWriteBuffer);
+}
+
+// Decided at flush, after the earlier command groups enqueued their transfers
+void issue_command::upload_changed_command(
+    queue* q, const vector_class<cl_event>& wait_events, buffer_base* buf,
+    buffer_base::clEnqueueBuffer_f clEnqueueBuffer) {
+  {
+    std::lock_guard<mutex_class> lock(buf->events_lock);
+    if (buf->is_device_current()) {
+      SYCL_LOG(trace, buffer, "upload skipped", buf);
+      return;
+    }
   }
+  buffer_base::enqueue_command(q, wait_events, buf, clEnqueueBuffer);
+}
+
+void issue_command::read_back(buffer_access acc) {
+  command::group_detail::add_buffer_copy(
+      acc, access::mode::read, buffer_base::enqueue_command, __func__,
+      acc.data,
+      reinterpret_cast<buffer_base::clEnqueueBuffer_f>(  // NOLINT
+          &clEnqueueReadBuffer));
+}
+
+void issue_command::fill_command(queue* q,
+                                 const vector_class<cl_event>& wait_events,
+                                 buffer_base* buf,
+                                 const vector_class<char>& pattern,
+                                 ::size_t size) {
+  auto num_events_to_wait = wait_events.size();
+  auto fill_range = [&](const char* field_pattern, ::size_t pattern_size,
+                        ::size_t offset, ::size_t range_size) {
+    cl_event evnt;
+    auto error_code = clEnqueueFillBuffer(
+        q->get(), buf->device_data.get(), field_pattern, pattern_size, offset,
+        range_size, static_cast<::cl_uint>(num_events_to_wait),
+        (num_events_to_wait == 0 ? nullptr : wait_events.data()), &evnt);
+    detail::error::report(error_code);
+
+    std::lock_guard<mutex_class> lock(buf->events_lock);
+    buf->events.emplace_back(evnt);
+    buf->device_version = 0;
+    clReleaseEvent(evnt);
+  };
+
+  if (buf->soa_arrays.empty()) {
+    fill_range(pattern.data(), pattern.size(), 0, size);
+    return;
+  }
+  // Every array is filled with its field of the value
+  for (auto& arr : buf->soa_arrays) {
+    fill_range(pattern.data() + arr.field.offset, arr.field.size, arr.offset,
+               arr.field.size * buf->soa_count);
+  }
+}
+
+void issue_command::copy_command(queue* q,
+                                 const vector_class<cl_event>& wait_events,
+                                 buffer_base* src, buffer_base* dest,
+                                 std::array<::size_t, 3> src_range,
+                                 std::array<::size_t, 3> dest_range,
+                                 ::size_t element_size) {
+  auto num_events_to_wait = static_cast<::cl_uint>(wait_events.size());
+  auto wait_list = (num_events_to_wait == 0 ? nullptr : wait_events.data());
+  cl_event evnt;
+  ::cl_int error_code;
+
+  // Both layouts and ranges match, handler::copy checks it
+  if (!src->soa_arrays.empty()) {
+    error_code = clEnqueueCopyBuffer(q->get(), src->device_data.get(),
+                                     dest->device_data.get(), 0, 0,
+                                     src->soa_size, num_events_to_wait,
+                                     wait_list, &evnt);
+  } else if (src_range == dest_range) {
+    auto size = element_size * src_range[0] * src_range[1] * src_range[2];
+    error_code = clEnqueueCopyBuffer(q->get(), src->device_data.get(),
+                                     dest->device_data.get(), 0, 0, size,
+                                     num_events_to_wait, wait_list, &evnt);
+  } else {
+    // The source is copied into the corner of a larger destination
+    const ::size_t origin[3] = {0, 0, 0};
+    const ::size_t region[3] = {src_range[0] * element_size, src_range[1],
+                                src_range[2]};
+    auto src_row_pitch = region[0];
+    auto dest_row_pitch = dest_range[0] * element_size;
+    error_code = clEnqueueCopyBufferRect(
+        q->get(), src->device_data.get(), dest->device_data.get(), origin,
+        origin, region, src_row_pitch, src_row_pitch * src_range[1],
+        dest_row_pitch, dest_row_pitch * dest_range[1], num_events_to_wait,
+        wait_list, &evnt);
+  }
+  detail::error::report(error_code);
+
+  // Later writers of the source wait for the copy as well
+  for (auto buf : {src, dest}) {
+    std::lock_guard<mutex_class> lock(buf->events_lock);
+    buf->events.emplace_back(evnt);
+  }
+  {
+    // Newer than the host memory until it is read back
+    std::lock_guard<mutex_class> lock(dest->events_lock);
+    dest->device_version = 0;
+  }
+  clReleaseEvent(evnt);
+}
+
+void issue_command::fill(buffer_access dest, vector_class<char> pattern,
+                         ::size_t size) {
+  using namespace std::placeholders;
+  command::group_detail::add_device_write(
+      dest,
+      std::bind(fill_command, _1, _2, dest.data, std::move(pattern), size),
+      __func__);
+  read_back(dest);
+}
+
+void issue_command::copy(buffer_access src, buffer_access dest,
+                         std::array<::size_t, 3> src_range,
+                         std::array<::size_t, 3> dest_range,
+                         ::size_t element_size) {
+  using namespace std::placeholders;
+  upload_changed(src);
+  command::group_detail::add_device_write(
+      dest,
+      std::bind(copy_command, _1, _2, src.data, dest.data, src_range,
+                dest_range, element_size),
+      __func__);
+  read_back(dest);
 }
@@ -2,39 +2,79 @@
 
 #include "SYCL/access.h"
 #include "SYCL/command_group.h"
+#include "SYCL/context.h"
+#include "SYCL/detail/kernel_store.h"
+#include "SYCL/detail/memory_manager.h"
+#include "SYCL/device.h"
 #include "SYCL/error_handler.h"
+#include "SYCL/info.h"
 #include "SYCL/kernel.h"
+#include "SYCL/param_traits.h"
 #include "SYCL/program.h"
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <cstdlib>
+#include <iterator>
 
 using namespace cl::sycl;
 using namespace detail::kernel_ns;
 
 const string_class source::resource_name_root = "_sycl_buf";
+const string_class source::kernel_name_root = "_sycl_kernel_";
 SYCL_THREAD_LOCAL int source::num_resources = 0;
+SYCL_THREAD_LOCAL detail::counter_t source::num_temporaries = 0;
 SYCL_THREAD_LOCAL source* source::scope = nullptr;
 
+// As generated by generate_id_refs<1>::global
+static const string_class global_id_name = "_sycl_gid";
+static const string_class global_id_subscript = "[" + global_id_name + "]";
+
 bool source::in_scope() {
   return scope != nullptr;
 }
 
-void source::enter(source& src) {
+void source::enter(source& src, bool wide_indices) {
   scope = &src;
+  src.is_wide = wide_indices;
   num_resources = 0;
+  num_temporaries = 0;
+}
+
+// Escape hatch for aliasing the runtime cannot see,
+// e.g. buffers created from OpenCL sub-buffers of the same memory object
+static bool restrict_disabled() {
+  static const bool disabled = (std::getenv("SYCL_GTX_NO_RESTRICT") != nullptr);
+  return disabled;
 }
 
 source source::exit(source& src) {
   scope = nullptr;
+  src.is_restrict = !restrict_disabled() && !src.may_alias();
+  src.set_kernel_name();
   return src;
 }
 
+void source::set_kernel_name() {
+  // The name is not part of the hashed code
+  kernel_name.clear();
+  kernel_name = kernel_name_root + kernel_store::hash(get_code());
+}
+
 // Creates kernel source
 string_class source::get_code() const {
   // TODO(progtx): Caching?
 
   static const char newline = '\n';
 
-  string_class final_code = string_class("__kernel void ") + kernel_name + "(" +
-                            generate_accessor_list() + ") {" + newline;
+  string_class final_code;
+  for (auto& definition : definitions) {
+    final_code += definition.second + newline;
+  }
+
+  final_code += string_class("__kernel void ") + kernel_name + "(" +
+                generate_accessor_list() + ") {" + newline +
+                generate_soa_pointers();
 
   for (auto& line : lines) {
     final_code += line + newline;
@@ -45,10 +85,62 @@ string_class source::get_code() const {
   return final_code;
 }
 
+// Buffers alias when their host memory overlaps,
+// e.g. a sub-buffer and its parent or two buffers over the same array.
+// Every argument without host memory has its own allocation.
+bool source::may_alias() const {
+  using host_range = std::pair<std::uintptr_t, std::uintptr_t>;
+  vector_class<host_range> ranges;
+  for (auto& res : resources) {
+    if (res.host_data != nullptr) {
+      auto begin = reinterpret_cast<std::uintptr_t>(res.host_data);
+      ranges.emplace_back(begin, begin + res.host_size);
+    }
+  }
+  std::sort(ranges.begin(), ranges.end());
+  for (::size_t i = 1; i < ranges.size(); ++i) {
+    if (ranges[i].first < ranges[i - 1].second) {
+      return true;
+    }
+  }
+  return false;
+}
+
 string_class source::get_kernel_name() const {
   return kernel_name;
 }
 
+static string_class index_type_name(bool wide) {
+  return wide ? "long" : "int";
+}
+
+string_class source::index_type() {
+  return index_type_name(has_wide_indices());
+}
+
+bool source::has_wide_indices() {
+  return scope != nullptr && scope->is_wide;
+}
+
+bool detail::kernel_ns::wide_indices() {
+  return source::has_wide_indices();
+}
+
+detail::counter_t source::next_temporary_id() {
+  return num_temporaries++;
+}
+
+void source::add_definition(const string_class& name,
+                            const string_class& definition) {
+  auto& definitions = scope->definitions;
+  auto it = std::find_if(definitions.begin(), definitions.end(),
+                         [&name](const std::pair<string_class, string_class>&
+                                     d) { return d.first == name; });
+  if (it == definitions.end()) {
+    definitions.emplace_back(name, definition);
+  }
+}
+
 string_class source::generate_accessor_list() const {
   string_class list;
   if (resources.empty()) {
@@ -56,18 +148,47 @@ string_class source::generate_accessor_list() const {
   }
 
   for (auto& acc : resources) {
-    list += get_name(acc.second.acc.target) + " ";
-    if (acc.second.acc.mode == access::mode::read) {
+    list += get_name(acc.is_constant ? access::target::constant_buffer
+                                     : acc.acc.target) +
+            " ";
+    if (acc.acc.mode == access::mode::read) {
       list += "const ";
     }
-    list += acc.second.type_name + " ";
-    list += acc.second.resource_name + ", ";
+    list += acc.type_name + " ";
+    if (is_restrict) {
+      list += "restrict ";
+    }
+    list += acc.resource_name + ", ";
   }
 
   // 2 to get rid of the last comma and space
   return list.substr(0, list.length() - 2);
 }
 
+// Struct of arrays buffers are passed as bytes,
+// each field is then accessed through its own typed pointer
+string_class source::generate_soa_pointers() const {
+  string_class pointers;
+  for (auto& res : resources) {
+    auto space = get_name(res.is_constant ? access::target::constant_buffer
+                                          : res.acc.target) +
+                 (res.acc.mode == access::mode::read ? " const " : " ");
+    for (auto& arr : res.soa_arrays) {
+      auto type = space + arr.field.type_name + '*';
+      pointers += '\t' + type + (is_restrict ? " restrict " : " ") +
+                  res.resource_name + '_' + arr.field.name + " = (" + type +
+                  ")(" + res.resource_name + " + " +
+                  get_string<::size_t>::get(arr.offset) + ");\n";
+    }
+  }
+  return pointers;
+}
+
+bool source::is_soa(const string_class& resource_name) {
+  auto res = scope->find_resource(resource_name);
+  return res != nullptr && !res->soa_arrays.empty();
+}
+
 string_class source::get_name(access::target target) {
   // TODO(progtx): All cases
   switch (target) {
@@ -82,10 +203,258 @@ string_class source::get_name(access::target target) {
   }
 }
 
-void source::init_kernel(program& p, shared_ptr_class<kernel> kern) {
+static bool can_be_constant(const detail::buffer_access& acc) {
+  return acc.mode == access::mode::read &&
+         acc.target == access::target::global_buffer;
+}
+
+void source::promote_to_constant(const context& ctx,
+                                 const vector_class<device>& devices) {
+  // Explicit constant buffers use up the limits first
+  cl_ulong constant_size = 0;
+  cl_uint constant_args = 0;
+  using candidate_t = std::pair<::size_t, buf_info*>;
+  vector_class<candidate_t> candidates;
+  for (auto& res : resources) {
+    if (res.acc.target == access::target::constant_buffer) {
+      constant_size += res.buffer_size;
+      ++constant_args;
+    } else if (can_be_constant(res.acc)) {
+      candidates.emplace_back(res.buffer_size, &res);
+    }
+  }
+  if (candidates.empty() || devices.empty()) {
+    return;
+  }
+
+  // The size limit is applied to all constant arguments together,
+  // which is what most devices actually have
+  auto limits = memory_manager::get(ctx)->get_constant_limits(devices);
+  auto max_size = limits.max_size;
+  auto max_args = limits.max_args;
+
+  std::stable_sort(candidates.begin(), candidates.end(),
+                   [](const candidate_t& a, const candidate_t& b) {
+                     return a.first < b.first;
+                   });
+
+  bool promoted = false;
+  for (auto& candidate : candidates) {
+    if (constant_args >= max_args ||
+        constant_size + candidate.first > max_size) {
+      break;
+    }
+    constant_size += candidate.first;
+    ++constant_args;
+    candidate.second->is_constant = true;
+    promoted = true;
+  }
+
+  if (promoted) {
+    set_kernel_name();
+  }
+}
+
+static bool is_vector_element(const string_class& type) {
+  static const char* const types[] = {"char",  "uchar", "short", "ushort",
+                                      "int",   "uint",  "long",  "ulong",
+                                      "float", "double"};
+  return std::find(std::begin(types), std::end(types), type) !=
+         std::end(types);
+}
+
+static bool is_floating(const string_class& type) {
+  return type == "float" || type == "double";
+}
+
+// Math functions of one argument, which apply element-wise to vectors
+static bool is_unary_function(const string_class& name) {
+  static const char* const functions[] = {
+      "sqrt", "rsqrt", "cbrt", "fabs", "exp",  "exp2",  "exp10", "log",
+      "log2", "log10", "sin",  "cos",  "tan",  "asin",  "acos",  "atan",
+      "sinh", "cosh",  "tanh", "floor", "ceil", "round", "trunc"};
+  return std::find(std::begin(functions), std::end(functions), name) !=
+         std::end(functions);
+}
+
+string_class source::vector_element_type() const {
+  string_class type;
+  for (auto& res : resources) {
+    if (res.acc.target != access::target::global_buffer &&
+        res.acc.target != access::target::constant_buffer) {
+      return "";
+    }
+    // Without the pointer
+    auto element = res.type_name.substr(0, res.type_name.length() - 1);
+    if (!res.soa_arrays.empty() || !is_vector_element(element) ||
+        (!type.empty() && element != type)) {
+      return "";
+    }
+    type = element;
+  }
+  return type;
+}
+
+const source::buf_info* source::find_resource(const string_class& name) const {
+  for (auto& res : resources) {
+    if (res.resource_name == name) {
+      return &res;
+    }
+  }
+  return nullptr;
+}
+
+bool source::vectorize(int width, source& vectorized) const {
+  auto type = vector_element_type();
+  auto index_type = "\tconst " + index_type_name(is_wide) + " ";
+  // Lines are indented by one tab and end with a semicolon
+  auto id_line = index_type + global_id_name + "0 = get_global_id(0);";
+  auto index_line =
+      index_type + global_id_name + " = " + global_id_name + "0;";
+  if (type.empty() || lines.size() < 3 || lines[0] != id_line ||
+      lines[1] != index_line) {
+    return false;
+  }
+
+  vectorized = *this;
+  vectorized.lines.clear();
+  vectorized.lines.push_back(index_type + global_id_name +
+                             " = get_global_id(0) * " +
+                             get_string<int>::get(width) + ";");
+  for (auto it = lines.begin() + 2; it != lines.end(); ++it) {
+    string_class line;
+    if (!vectorize_line(*it, type, width, line)) {
+      return false;
+    }
+    vectorized.lines.push_back(line);
+  }
+  vectorized.set_kernel_name();
+  return true;
+}
+
+// Statements have the form "target[_sycl_gid] op expression"
+bool source::vectorize_line(const string_class& line, const string_class& type,
+                            int width, string_class& vectorized) const {
+  if (line.size() < 2 || line.front() != '\t' || line.back() != ';') {
+    return false;
+  }
+  auto statement = line.substr(1, line.size() - 2);
+  auto subscript = statement.find(global_id_subscript + " ");
+  if (subscript == string_class::npos) {
+    return false;
+  }
+  auto target = statement.substr(0, subscript);
+  auto res = find_resource(target);
+  if (res == nullptr || res->acc.mode == access::mode::read) {
+    return false;
+  }
+
+  auto rest = statement.substr(subscript + global_id_subscript.size() + 1);
+  auto space = rest.find(' ');
+  if (space == string_class::npos) {
+    return false;
+  }
+  auto op = rest.substr(0, space);
+  if (op != "=" && op != "+=" && op != "-=" && op != "*=" && op != "/=") {
+    return false;
+  }
+  string_class expression;
+  if (!vectorize_expression(rest.substr(space + 1), type, width,
+                            expression)) {
+    return false;
+  }
+
+  auto n = get_string<int>::get(width);
+  auto address = "0, " + target + " + " + global_id_name;
+  if (op != "=") {
+    expression = "vload" + n + "(" + address + ") " + op[0] + " (" +
+                 expression + ")";
+  }
+  vectorized = "\tvstore" + n + "(" + expression + ", " + address + ");";
+  return true;
+}
+
+// Anything that would not be element-wise on vectors is rejected,
+// such as comparisons, which give -1 instead of 1 for vectors,
+// or literals of a higher rank than the element type
+bool source::vectorize_expression(const string_class& expression,
+                                  const string_class& type, int width,
+                                  string_class& vectorized) const {
+  auto n = get_string<int>::get(width);
+  auto floating = is_floating(type);
+  auto length = expression.length();
+  vectorized.clear();
+
+  for (::size_t i = 0; i < length;) {
+    auto c = expression[i];
+    auto next = (i + 1 < length) ? expression[i + 1] : '\0';
+
+    if (std::isalpha(c) || c == '_') {
+      auto end = i;
+      while (end < length &&
+             (std::isalnum(expression[end]) || expression[end] == '_')) {
+        ++end;
+      }
+      auto name = expression.substr(i, end - i);
+      if (find_resource(name) != nullptr) {
+        if (expression.compare(end, global_id_subscript.size(),
+                               global_id_subscript) != 0) {
+          return false;
+        }
+        vectorized +=
+            "vload" + n + "(0, " + name + " + " + global_id_name + ")";
+        i = end + global_id_subscript.size();
+      } else if (floating && is_unary_function(name) && end < length &&
+                 expression[end] == '(') {
+        vectorized += name;
+        i = end;
+      } else {
+        return false;
+      }
+    } else if (std::isdigit(c) || (c == '.' && std::isdigit(next))) {
+      auto end = i;
+      bool integral = true;
+      while (end < length) {
+        auto d = expression[end];
+        auto prev = expression[end - 1];
+        if (std::isalnum(d) || d == '.' ||
+            ((d == '+' || d == '-') && (prev == 'e' || prev == 'E'))) {
+          integral = integral && std::isdigit(d);
+          ++end;
+        } else {
+          break;
+        }
+      }
+      auto literal = expression.substr(i, end - i);
+      auto suffix = literal.back();
+      if (!integral &&
+          (!floating || (type == "float" && suffix != 'f' && suffix != 'F'))) {
+        return false;
+      }
+      vectorized += literal;
+      i = end;
+    } else if (c == ' ' || c == '+' || c == '-' || c == '*' || c == '/' ||
+               c == '(' || c == ')') {
+      vectorized += c;
+      ++i;
+    } else if (!floating &&
+               (c == '%' || c == '&' || c == '|' || c == '^' || c == '~')) {
+      vectorized += c;
+      ++i;
+    } else if (!floating && (c == '<' || c == '>') && next == c) {
+      vectorized += string_class(2, c);
+      i += 2;
+    } else {
+      return false;
+    }
+  }
+  return true;
+}
+
+void source::init_kernel(program& p, kernel& kern) {
   ::cl_int error_code;
   cl_kernel k = clCreateKernel(p.get(), kernel_name.c_str(), &error_code);
   detail::error::report(error_code);
-  kern->set(k);
-  kern->kern.release_one();
+  kern.set(k);
+  kern.kern.release_one();
 }
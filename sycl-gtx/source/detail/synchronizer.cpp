@@ -2,63 +2,114 @@
 
 #include "SYCL/accessor.h"
 #include "SYCL/buffer_base.h"
+#include "SYCL/detail/logger.h"
 #include "SYCL/queue.h"
 
 using namespace cl::sycl;
 using namespace detail;
 
-std::set<queue*> synchronizer::queues;
+std::map<queue*, synchronizer::queue_entry> synchronizer::queues;
 std::map<accessor_base*, buffer_base*> synchronizer::host_accessors;
+mutex_class synchronizer::queues_lock;
+std::condition_variable synchronizer::queue_released;
+mutex_class synchronizer::accessors_lock;
 
+synchronizer::queue_refs::queue_refs(queue* only) {
+  std::lock_guard<mutex_class> lock(queues_lock);
+  for (auto& entry : queues) {
+    if (!entry.second.is_removed &&
+        (only == nullptr || entry.first == only)) {
+      ++entry.second.users;
+      list.push_back(entry.first);
+    }
+  }
+}
+
+synchronizer::queue_refs::~queue_refs() {
+  if (list.empty()) {
+    return;
+  }
+  {
+    std::lock_guard<mutex_class> lock(queues_lock);
+    for (auto q : list) {
+      --queues[q].users;
+    }
+  }
+  queue_released.notify_all();
+}
+
+// A blocking wait on one queue doesn't hold up the other threads
 void synchronizer::wait_on_queues(buffer_base* buf) {
-  for (auto&& q : queues) {
-    if (q->buffers_in_use.count(buf) > 0) {
+  queue_refs refs;
+  for (auto q : refs) {
+    if (q->is_using(buf)) {
       q->wait();
     }
   }
 }
 
 void synchronizer::flush_queues(buffer_base* buf) {
-  for (auto&& q : queues) {
-    if (q->buffers_in_use.count(buf) > 0) {
+  queue_refs refs;
+  for (auto q : refs) {
+    if (q->is_using(buf)) {
       q->flush();
     }
   }
 }
 
 void synchronizer::add(queue* q) {
-  queues.insert(q);
+  std::lock_guard<mutex_class> lock(queues_lock);
+  queues[q] = queue_entry();
 }
 
 void synchronizer::remove(queue* q) {
-  queues.erase(q);
+  std::unique_lock<mutex_class> lock(queues_lock);
+  auto it = queues.find(q);
+  if (it == queues.end()) {
+    return;
+  }
+  it->second.is_removed = true;
+  queue_released.wait(lock, [&it]() { return it->second.users == 0; });
+  queues.erase(it);
+}
+
+void synchronizer::flush_built(queue* q) {
+  queue_refs refs(q);
+  for (auto registered : refs) {
+    registered->flush_built();
+  }
 }
 
 void synchronizer::add(accessor_base* acc, buffer_base* buf) {
-  DSELF() << acc << buf;
-  host_accessors.emplace(acc, buf);
+  SYCL_LOG(trace, sync, acc, buf);
+  {
+    std::lock_guard<mutex_class> lock(accessors_lock);
+    host_accessors.emplace(acc, buf);
+  }
   wait_on_queues(buf);
 }
 
 void synchronizer::remove(accessor_base* acc, buffer_base* buf) {
-  host_accessors.erase(acc);
+  {
+    std::lock_guard<mutex_class> lock(accessors_lock);
+    host_accessors.erase(acc);
+  }
+  flush_queues(buf);
+}
+
+void synchronizer::remove(buffer_base* buf) {
   flush_queues(buf);
 }
 
 bool synchronizer::can_flush(
     const std::set<detail::buffer_base*>& buffers_in_use) {
-  {
-    auto d = DSELF();
-    d << "buffers_in_use";
+  std::lock_guard<mutex_class> lock(accessors_lock);
+  if (SYCL_LOG_ENABLED(trace, sync)) {
     for (auto& buf : buffers_in_use) {
-      d << buf;
+      SYCL_LOG(trace, sync, "buffer_in_use", buf);
     }
-  }
-  {
-    auto d = DSELF();
-    d << "host_accessors";
     for (auto&& acc : host_accessors) {
-      d << "{" << acc.first << acc.second << "}";
+      SYCL_LOG(trace, sync, "host_accessor", acc.first, acc.second);
     }
   }
   for (auto&& acc : host_accessors) {
@@ -0,0 +1,60 @@
+#include "SYCL/detail/thread_pool.h"
+
+#include "SYCL/detail/debug.h"
+#include "SYCL/exception.h"
+
+using namespace cl::sycl;
+using namespace detail;
+
+thread_pool::thread_pool(unsigned int num_threads) {
+  workers.reserve(num_threads);
+  for (unsigned int i = 0; i < num_threads; ++i) {
+    workers.emplace_back(&thread_pool::work, this);
+  }
+}
+
+thread_pool::~thread_pool() {
+  {
+    std::lock_guard<mutex_class> guard(lock);
+    stopping = true;
+  }
+  has_jobs.notify_all();
+  for (auto& worker : workers) {
+    worker.join();
+  }
+}
+
+void thread_pool::add(job_f job) {
+  {
+    std::lock_guard<mutex_class> guard(lock);
+    jobs.push_back(std::move(job));
+  }
+  has_jobs.notify_one();
+}
+
+unsigned int thread_pool::hardware_threads() {
+  auto num_threads = std::thread::hardware_concurrency();
+  return (num_threads == 0 ? 1 : num_threads);
+}
+
+void thread_pool::work() {
+  while (true) {
+    job_f job;
+    {
+      std::unique_lock<mutex_class> guard(lock);
+      has_jobs.wait(guard, [this]() { return stopping || !jobs.empty(); });
+      if (jobs.empty()) {
+        return;
+      }
+      job = std::move(jobs.front());
+      jobs.pop_front();
+    }
+
+    // There is nobody to report the error to on a worker thread
+    try {
+      job();
+    } catch (::cl::sycl::exception& e) {
+      debug("SYCL_ERROR::", e.what());
+    }
+  }
+}
@@ -0,0 +1,316 @@
+#include "SYCL/detail/tracer.h"
+
+#include "SYCL/detail/debug.h"
+#include "SYCL/detail/profiler.h"
+#include "SYCL/event.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <thread>
+
+using namespace cl::sycl;
+using namespace detail;
+
+struct trace_span {
+  string_class name;
+  ::size_t thread;
+  cl_ulong start;
+  cl_ulong end;
+};
+
+struct trace_command {
+  ::size_t track;
+  string_class name;
+  const char* category;
+  // Released once the timestamps are read
+  event evnt;
+  // Host time when the command was enqueued, aligns the device clock
+  cl_ulong host_queued;
+  cl_ulong queued;
+  cl_ulong start;
+  cl_ulong end;
+  bool is_resolved;
+  bool has_times;
+};
+
+class trace_timeline {
+ private:
+  mutex_class lock;
+  string_class path;
+  cl_ulong origin;
+  vector_class<trace_span> spans;
+  vector_class<trace_command> commands;
+  // Commands whose event is still retained, for finding dependencies
+  std::map<cl_event, ::size_t> pending;
+  // Producer and consumer command indices
+  vector_class<std::pair<::size_t, ::size_t>> flows;
+  std::map<std::thread::id, ::size_t> threads;
+  // Tracks of the command queues that have not been released yet,
+  // a released handle can be reused by a new queue
+  std::map<cl_command_queue, ::size_t> tracks;
+  ::size_t num_tracks = 0;
+  // Difference between the host and the device clock of each track
+  std::map<::size_t, std::int64_t> offsets;
+
+  ::size_t thread_id();
+  ::size_t track_id(cl_command_queue track);
+  void resolve(::size_t track);
+  double to_us(cl_ulong host_time) const;
+  double to_us(const trace_command& command, cl_ulong device_time) const;
+  void write();
+
+ public:
+  trace_timeline();
+  ~trace_timeline();
+
+  void add_span(const char* name, cl_ulong start, cl_ulong end);
+  void add_command(cl_command_queue track, const string_class& name,
+                   const char* category, cl_event evnt,
+                   const vector_class<cl_event>& wait_events);
+  void finish(cl_command_queue track);
+};
+
+static const char* trace_path() {
+  auto env = std::getenv("SYCL_GTX_TRACE");
+  return (env == nullptr ? "" : env);
+}
+
+static trace_timeline& get_timeline() {
+  static trace_timeline trace;
+  return trace;
+}
+
+static cl_ulong get_time(cl_event evnt, cl_profiling_info param,
+                         ::cl_int& error_code) {
+  cl_ulong value = 0;
+  if (error_code == CL_SUCCESS) {
+    error_code = clGetEventProfilingInfo(evnt, param, sizeof(value), &value,
+                                         nullptr);
+  }
+  return value;
+}
+
+static string_class escape(const string_class& text) {
+  string_class escaped;
+  escaped.reserve(text.size());
+  for (auto c : text) {
+    if (c == '"' || c == '\\') {
+      escaped += '\\';
+    }
+    escaped += c;
+  }
+  return escaped;
+}
+
+trace_timeline::trace_timeline()
+    : path(trace_path()), origin(profiler::host_time()) {}
+
+trace_timeline::~trace_timeline() {
+  write();
+}
+
+::size_t trace_timeline::thread_id() {
+  auto it = threads.find(std::this_thread::get_id());
+  if (it == threads.end()) {
+    it = threads
+             .emplace(std::this_thread::get_id(),
+                      static_cast<::size_t>(threads.size() + 1))
+             .first;
+  }
+  return it->second;
+}
+
+::size_t trace_timeline::track_id(cl_command_queue track) {
+  auto it = tracks.find(track);
+  if (it == tracks.end()) {
+    it = tracks.emplace(track, ++num_tracks).first;
+  }
+  return it->second;
+}
+
+void trace_timeline::add_span(const char* name, cl_ulong start,
+                              cl_ulong end) {
+  std::lock_guard<mutex_class> guard(lock);
+  spans.push_back({name, thread_id(), start, end});
+}
+
+void trace_timeline::add_command(cl_command_queue track,
+                                 const string_class& name,
+                                 const char* category, cl_event evnt,
+                                 const vector_class<cl_event>& wait_events) {
+  auto host_queued = profiler::host_time();
+  std::lock_guard<mutex_class> guard(lock);
+
+  // The runtime creates in-order command queues,
+  // so only the latest producer on each queue gets an arrow
+  std::map<::size_t, ::size_t> producers;
+  for (auto wait : wait_events) {
+    auto it = pending.find(wait);
+    if (it != pending.end()) {
+      auto& producer = producers[commands[it->second].track];
+      producer = std::max(producer, it->second + 1);
+    }
+  }
+  auto index = commands.size();
+  for (auto& producer : producers) {
+    flows.emplace_back(producer.second - 1, index);
+  }
+  commands.push_back({track_id(track), name, category, event(evnt),
+                      host_queued, 0, 0, 0, false, false});
+  pending[evnt] = index;
+}
+
+void trace_timeline::finish(cl_command_queue track) {
+  std::lock_guard<mutex_class> guard(lock);
+  auto it = tracks.find(track);
+  if (it != tracks.end()) {
+    resolve(it->second);
+    tracks.erase(it);
+  }
+}
+
+// Reads the timestamps of the commands of the track, or of all tracks if 0
+void trace_timeline::resolve(::size_t track) {
+  for (auto& command : commands) {
+    if (command.is_resolved || (track != 0 && command.track != track)) {
+      continue;
+    }
+    auto evnt = command.evnt.get();
+    ::cl_int error_code = CL_SUCCESS;
+    command.queued = get_time(evnt, CL_PROFILING_COMMAND_QUEUED, error_code);
+    command.start = get_time(evnt, CL_PROFILING_COMMAND_START, error_code);
+    command.end = get_time(evnt, CL_PROFILING_COMMAND_END, error_code);
+    command.has_times = (error_code == CL_SUCCESS);
+    command.is_resolved = true;
+
+    if (command.has_times && offsets.count(command.track) == 0) {
+      offsets[command.track] = static_cast<std::int64_t>(command.host_queued) -
+                               static_cast<std::int64_t>(command.queued);
+    }
+    pending.erase(evnt);
+    command.evnt = event();
+  }
+}
+
+double trace_timeline::to_us(cl_ulong host_time) const {
+  return (static_cast<std::int64_t>(host_time) -
+          static_cast<std::int64_t>(origin)) /
+         1e3;
+}
+
+double trace_timeline::to_us(const trace_command& command,
+                             cl_ulong device_time) const {
+  return to_us(static_cast<cl_ulong>(static_cast<std::int64_t>(device_time) +
+                                     offsets.at(command.track)));
+}
+
+void trace_timeline::write() {
+  if (path.empty()) {
+    return;
+  }
+  std::lock_guard<mutex_class> guard(lock);
+  resolve(0);
+
+  std::ofstream file(path, std::ios::trunc);
+  if (!file) {
+    debug() << "Unable to write the trace to" << path;
+    return;
+  }
+
+  file << std::fixed << std::setprecision(3);
+  file << "{\"traceEvents\":[\n";
+  file << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,"
+          "\"args\":{\"name\":\"host\"}},\n";
+  file << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":2,"
+          "\"args\":{\"name\":\"device\"}}";
+  for (::size_t track = 1; track <= num_tracks; ++track) {
+    file << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":2,\"tid\":"
+         << track << ",\"args\":{\"name\":\"queue " << track << "\"}}";
+  }
+
+  for (auto& span : spans) {
+    file << ",\n{\"name\":\"" << escape(span.name)
+         << "\",\"cat\":\"host\",\"ph\":\"X\",\"pid\":1,\"tid\":"
+         << span.thread << ",\"ts\":" << to_us(span.start)
+         << ",\"dur\":" << (span.end - span.start) / 1e3 << "}";
+  }
+
+  for (auto& command : commands) {
+    if (!command.has_times) {
+      continue;
+    }
+    file << ",\n{\"name\":\"" << escape(command.name) << "\",\"cat\":\""
+         << command.category << "\",\"ph\":\"X\",\"pid\":2,\"tid\":"
+         << command.track
+         << ",\"ts\":" << to_us(command, command.start)
+         << ",\"dur\":" << (command.end - command.start) / 1e3 << "}";
+  }
+
+  ::size_t flow_id = 0;
+  for (auto& flow : flows) {
+    auto& producer = commands[flow.first];
+    auto& consumer = commands[flow.second];
+    if (!producer.has_times || !consumer.has_times) {
+      continue;
+    }
+    ++flow_id;
+    // The arrow starts just before the end, inside the producer span
+    auto end =
+        (producer.end > producer.start ? producer.end - 1 : producer.end);
+    file << ",\n{\"name\":\"dependency\",\"cat\":\"dependency\","
+            "\"ph\":\"s\",\"id\":"
+         << flow_id << ",\"pid\":2,\"tid\":" << producer.track
+         << ",\"ts\":" << to_us(producer, end) << "}";
+    file << ",\n{\"name\":\"dependency\",\"cat\":\"dependency\","
+            "\"ph\":\"f\",\"bp\":\"e\",\"id\":"
+         << flow_id << ",\"pid\":2,\"tid\":" << consumer.track
+         << ",\"ts\":" << to_us(consumer, consumer.start) << "}";
+  }
+
+  file << "\n],\"displayTimeUnit\":\"ns\"}\n";
+}
+
+tracer::span::span(const char* name)
+    : name(name), start(is_enabled() ? profiler::host_time() : 0) {}
+
+tracer::span::~span() {
+  if (is_enabled()) {
+    add_span(name, start, profiler::host_time());
+  }
+}
+
+bool tracer::is_enabled() {
+  static const bool enabled = []() {
+    if (trace_path()[0] == '\0') {
+      return false;
+    }
+    // Created before the thread pools that record spans,
+    // so it is destroyed after them
+    get_timeline();
+    return true;
+  }();
+  return enabled;
+}
+
+void tracer::add_span(const char* name, cl_ulong start, cl_ulong end) {
+  if (is_enabled()) {
+    get_timeline().add_span(name, start, end);
+  }
+}
+
+void tracer::add_command(cl_command_queue track, const string_class& name,
+                         const char* category, cl_event evnt,
+                         const vector_class<cl_event>& wait_events) {
+  if (is_enabled()) {
+    get_timeline().add_command(track, name, category, evnt, wait_events);
+  }
+}
+
+void tracer::finish(cl_command_queue track) {
+  if (is_enabled()) {
+    get_timeline().finish(track);
+  }
+}
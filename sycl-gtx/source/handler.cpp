@@ -1,6 +1,11 @@
 #include "SYCL/handler.h"
 
 #include "SYCL/context.h"
+#include "SYCL/detail/logger.h"
+#include "SYCL/device.h"
+#include "SYCL/error_handler.h"
+#include "SYCL/info.h"
+#include "SYCL/param_traits.h"
 #include "SYCL/queue.h"
 
 using namespace cl::sycl;
@@ -9,3 +14,53 @@ using namespace detail;
 context handler::get_context(queue* q) {
   return q->get_context();
 }
+
+void handler::build(shared_ptr_class<kernel> kern, ::size_t kernel_name_id) {
+  program prog(get_context(q));
+  prog.build_async(kern, kernel_name_id, "");
+  detail::command::group_detail::add_build(kern->build);
+}
+
+static int preferred_vector_width(const device& dev, const string_class& type) {
+  cl_uint width = 1;
+  if (type == "char" || type == "uchar") {
+    width = dev.get_info<info::device::preferred_vector_width_char>();
+  } else if (type == "short" || type == "ushort") {
+    width = dev.get_info<info::device::preferred_vector_width_short>();
+  } else if (type == "int" || type == "uint") {
+    width = dev.get_info<info::device::preferred_vector_width_int>();
+  } else if (type == "long" || type == "ulong") {
+    width = dev.get_info<info::device::preferred_vector_width_long_long>();
+  } else if (type == "float") {
+    width = dev.get_info<info::device::preferred_vector_width_float>();
+  } else if (type == "double") {
+    width = dev.get_info<info::device::preferred_vector_width_double>();
+  }
+  return static_cast<int>(width);
+}
+
+shared_ptr_class<kernel> handler::vectorize(const kernel& kern, int& width) {
+  if (width != 0 && width != 1 && width != 2 && width != 4 && width != 8 &&
+      width != 16) {
+    detail::error::report(CL_INVALID_VALUE);
+  }
+  auto type = kern.src.vector_element_type();
+  if (type.empty() || width == 1) {
+    return nullptr;
+  }
+  if (width == 0) {
+    width = preferred_vector_width(q->get_device(), type);
+    if (width < 2) {
+      return nullptr;
+    }
+  }
+
+  auto vectorized = shared_ptr_class<kernel>(new kernel(true));
+  if (!kern.src.vectorize(width, vectorized->src)) {
+    SYCL_LOG(info, kernel, "not vectorized", kern.type_name);
+    return nullptr;
+  }
+  vectorized->type_name = kern.type_name;
+  SYCL_LOG(info, kernel, "vectorized", kern.type_name, width);
+  return vectorized;
+}
@@ -1,5 +1,7 @@
 #include "SYCL/kernel.h"
 
+#include "SYCL/detail/compiler.h"
+#include "SYCL/detail/counters.h"
 #include "SYCL/event.h"
 #include "SYCL/program.h"
 #include "SYCL/queue.h"
@@ -10,24 +12,36 @@ kernel::kernel(bool) : prog(new program(ctx)) {}
 
 kernel::kernel(cl_kernel k)
     : kern(k),
+      binding(new detail::kernel_binding(k)),
       ctx(get_info<info::kernel::context>()),
       prog(new program(ctx, get_info<info::kernel::program>())) {}
 
-cl_event kernel::get_cl_event(event* evnt) {
-  return evnt->evnt.get();
-}
 cl_command_queue kernel::get_cl_queue(queue* q) {
   return q->get();
 }
 
+void kernel::set_event(queue* q, const vector_class<cl_event>& wait_events,
+                       event* evnt, cl_event ev) const {
+  evnt->evnt = ev;
+  evnt->evnt.release_one();
+  detail::counters::get(q)->add(info::counter::kernel_launches);
+  if (detail::profiler::is_enabled(q)) {
+    auto name = type_name;
+    if (name.empty()) {
+      name = get_info<info::kernel::function_name>().c_str();
+    }
+    detail::profiler::add_kernel(q, name, ev, wait_events);
+  }
+}
+
 void kernel::enqueue_task(queue* q, const vector_class<cl_event>& wait_events,
                           event* evnt) const {
-  auto ev = evnt->evnt.get();
-
+  cl_event ev;
   auto error_code = clEnqueueTask(q->get(), kern.get(),
                                   static_cast<::cl_uint>(wait_events.size()),
                                   get_events_ptr(wait_events), &ev);
   detail::error::report(error_code);
+  set_event(q, wait_events, evnt, ev);
 }
 
 program kernel::get_program() const {
@@ -36,9 +50,19 @@ program kernel::get_program() const {
 
 void kernel::set(cl_kernel openclKernelObject) {
   kern = openclKernelObject;
+  binding.reset(new detail::kernel_binding(openclKernelObject));
 }
 
 void kernel::set(const context& context, cl_program validProgram) {
   ctx = context;
   *prog = program(context, validProgram);
 }
+
+void kernel::finish_build() {
+  if (kern.get() != nullptr || build == nullptr) {
+    return;
+  }
+  set(ctx, build->get());
+  binding = build->get_kernel(src.get_kernel_name());
+  kern = binding->get();
+}
@@ -0,0 +1,121 @@
+#include "SYCL/mapped_file.h"
+
+#include "SYCL/error_handler.h"
+
+#if defined(_WIN32)
+#include <fcntl.h>
+#include <io.h>
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace cl::sycl;
+
+mapped_file::mapped_file(string_class path, ::size_t offset)
+    : path(std::move(path)), fd(-1), offset(offset) {}
+
+mapped_file::mapped_file(int fd, ::size_t offset)
+    : fd(fd), offset(offset) {}
+
+#if defined(_WIN32)
+
+static shared_ptr_class<void> map_file(int fd, ::size_t size,
+                                       ::size_t offset) {
+  auto file = reinterpret_cast<HANDLE>(_get_osfhandle(fd));
+  LARGE_INTEGER file_size;
+  if (file == INVALID_HANDLE_VALUE || !GetFileSizeEx(file, &file_size) ||
+      static_cast<unsigned long long>(file_size.QuadPart) < offset + size) {
+    return nullptr;
+  }
+
+  SYSTEM_INFO info;
+  GetSystemInfo(&info);
+  auto start = offset - offset % info.dwAllocationGranularity;
+  auto length = size + (offset - start);
+
+  auto mapping = CreateFileMapping(file, nullptr, PAGE_WRITECOPY, 0, 0,
+                                   nullptr);
+  if (mapping == nullptr) {
+    return nullptr;
+  }
+  auto start64 = static_cast<unsigned long long>(start);
+  auto view = MapViewOfFile(mapping, FILE_MAP_COPY,
+                            static_cast<DWORD>(start64 >> 32),
+                            static_cast<DWORD>(start64), length);
+  // The view keeps the mapping alive
+  CloseHandle(mapping);
+  if (view == nullptr) {
+    return nullptr;
+  }
+  return shared_ptr_class<void>(static_cast<char*>(view) + (offset - start),
+                                [view](void*) { UnmapViewOfFile(view); });
+}
+
+static int open_file(const string_class& path) {
+  return _open(path.c_str(), _O_RDONLY | _O_BINARY);
+}
+
+static void close_file(int fd) {
+  _close(fd);
+}
+
+#else
+
+static shared_ptr_class<void> map_file(int fd, ::size_t size,
+                                       ::size_t offset) {
+  struct stat info;
+  if (fstat(fd, &info) != 0 ||
+      static_cast<::size_t>(info.st_size) < offset + size) {
+    return nullptr;
+  }
+
+  auto page_size = static_cast<::size_t>(sysconf(_SC_PAGESIZE));
+  auto start = offset - offset % page_size;
+  auto length = size + (offset - start);
+
+  // Private and writable, in case the OpenCL driver writes to host memory
+  auto address = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE,
+                      fd, static_cast<off_t>(start));
+  if (address == MAP_FAILED) {
+    return nullptr;
+  }
+  // The upload reads the pages in order
+  madvise(address, length, MADV_SEQUENTIAL);
+  return shared_ptr_class<void>(
+      static_cast<char*>(address) + (offset - start),
+      [address, length](void*) { munmap(address, length); });
+}
+
+static int open_file(const string_class& path) {
+  return open(path.c_str(), O_RDONLY);
+}
+
+static void close_file(int fd) {
+  close(fd);
+}
+
+#endif
+
+shared_ptr_class<void> mapped_file::map(::size_t size) const {
+  shared_ptr_class<void> mapping;
+  if (size > 0) {
+    if (fd >= 0) {
+      mapping = map_file(fd, size, offset);
+    } else {
+      // The mapping stays valid after the file is closed
+      auto file = open_file(path);
+      if (file >= 0) {
+        mapping = map_file(file, size, offset);
+        close_file(file);
+      }
+    }
+  }
+  if (mapping == nullptr) {
+    detail::error::report(detail::error::code::FILE_MAPPING_FAILURE);
+  }
+  return mapping;
+}
@@ -1,6 +1,9 @@
 #include "SYCL/program.h"
 
+#include "SYCL/detail/counters.h"
 #include "SYCL/detail/debug.h"
+#include "SYCL/detail/kernel_store.h"
+#include "SYCL/detail/tracer.h"
 #include "SYCL/kernel.h"
 #include "SYCL/queue.h"
 
@@ -21,12 +24,15 @@ program::program(const context& context, cl_program clProgram)
 
 void program::compile(string_class compile_options, ::size_t kernel_name_id,
                       shared_ptr_class<kernel> kern) {
+  detail::tracer::span span("program::compile");
   kernels.emplace(kernel_name_id, kern);
   auto& src = kern->src;
+  src.promote_to_constant(ctx, devices);
   auto code = src.get_code();
 
   debug() << "Compiled kernel:";
   debug() << code;
+  detail::kernel_store::extract(code);
 
   const char* code_p = code.c_str();
   ::size_t length = code.size();
@@ -40,10 +46,15 @@ void program::compile(string_class compile_options, ::size_t kernel_name_id,
 
   auto device_pointers = detail::get_cl_array(devices);
 
-  error_code = clCompileProgram(kern->prog.get()->get(),
-                                static_cast<::cl_uint>(devices.size()),
-                                device_pointers.data(), compile_options.c_str(),
-                                0, nullptr, nullptr, nullptr, nullptr);
+  auto& stats = detail::counters::get(ctx);
+  {
+    detail::counters::timer timer(stats.get(), info::counter::compile_time);
+    error_code = clCompileProgram(
+        kern->prog.get()->get(), static_cast<::cl_uint>(devices.size()),
+        device_pointers.data(), compile_options.c_str(), 0, nullptr, nullptr,
+        nullptr, nullptr);
+  }
+  stats->add(info::counter::programs_compiled);
 
   try {
     detail::error::report(error_code);
@@ -51,27 +62,39 @@ void program::compile(string_class compile_options, ::size_t kernel_name_id,
     debug() << "Error while compiling kernel" << kern->src.get_kernel_name()
             << "->";
     for (auto& d : devices) {
-      report_compile_error(kern, d);
+      report_compile_error(kern->prog.get()->get(), d);
     }
     throw e;
   }
 }
 
-void program::report_compile_error(shared_ptr_class<kernel> kern,
-                                   device& dev) const {
+void program::build_async(shared_ptr_class<kernel> kern,
+                          ::size_t kernel_name_id,
+                          string_class build_options) {
+  kern->src.promote_to_constant(ctx, devices);
+  auto code = kern->src.get_code();
+  debug() << "Building kernel:";
+  debug() << code;
+  kern->ctx = ctx;
+  kern->build = detail::compiler::build(ctx, devices, code, build_options);
+  kernels.emplace(kernel_name_id, kern);
+  linked = true;
+}
+
+void program::report_compile_error(cl_program prog, device& dev) {
   // http://stackoverflow.com/a/9467325/793006
 
   // Determine the size of the log
   ::size_t log_size;
-  clGetProgramBuildInfo(kern->prog.get()->get(), dev.get(),
-                        CL_PROGRAM_BUILD_LOG, 0, nullptr, &log_size);
+  clGetProgramBuildInfo(prog, dev.get(), CL_PROGRAM_BUILD_LOG, 0, nullptr,
+                        &log_size);
 
   // Allocate memory for the log
   auto log = new char[log_size];
 
   // Get the log
-  clGetProgramBuildInfo(kern->prog.get()->get(), dev.get(),
-                        CL_PROGRAM_BUILD_LOG, log_size, log, nullptr);
+  clGetProgramBuildInfo(prog, dev.get(), CL_PROGRAM_BUILD_LOG, log_size, log,
+                        nullptr);
 
   debug() << "\tWhile compiling for device"
           << dev.get_info<info::device::name>() << "->\n"
@@ -83,7 +106,7 @@ void program::report_compile_error(shared_ptr_class<kernel> kern,
 void program::init_kernels() {
   for (auto& kern : kernels) {
     // The extra kernel parameter is required because of complex dependencies
-    kern.second->src.init_kernel(*this, kern.second);
+    kern.second->src.init_kernel(*this, *kern.second);
   }
 }
 
@@ -103,16 +126,22 @@ void program::link(string_class linking_options) {
     // TODO(progtx): Error?
     return;
   }
+  detail::tracer::span span("program::link");
 
   auto device_pointers = detail::get_cl_array(devices);
   auto program_pointers = get_program_pointers();
   ::cl_int error_code;
 
-  prog =
-      clLinkProgram(ctx.get(), static_cast<::cl_uint>(device_pointers.size()),
-                    device_pointers.data(), linking_options.c_str(),
-                    static_cast<::cl_uint>(program_pointers.size()),
-                    program_pointers.data(), nullptr, nullptr, &error_code);
+  auto& stats = detail::counters::get(ctx);
+  {
+    detail::counters::timer timer(stats.get(), info::counter::compile_time);
+    prog = clLinkProgram(
+        ctx.get(), static_cast<::cl_uint>(device_pointers.size()),
+        device_pointers.data(), linking_options.c_str(),
+        static_cast<::cl_uint>(program_pointers.size()),
+        program_pointers.data(), nullptr, nullptr, &error_code);
+  }
+  stats->add(info::counter::programs_linked);
   detail::error::report(error_code);
 
   // Can only initialize after program successfully built
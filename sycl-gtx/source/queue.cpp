@@ -1,6 +1,11 @@
 #include "SYCL/queue.h"
 
 #include "SYCL/buffer_base.h"
+#include "SYCL/detail/compiler.h"
+#include "SYCL/detail/counters.h"
+#include "SYCL/detail/kernel_store.h"
+#include "SYCL/detail/tracer.h"
+#include <iostream>
 
 using namespace cl::sycl;
 
@@ -16,23 +21,38 @@ void queue::display_device_info() const {
 }
 
 cl_command_queue queue::create_queue(bool display_info,
-                                     bool register_with_synchronizer,
                                      info::queue_profiling enable_profiling) {
   if (display_info) {
     display_device_info();
   }
 
+  bool profiling =
+      (enable_profiling || detail::profiler::is_enabled_by_default() ||
+       detail::tracer::is_enabled());
+
   ::cl_int error_code;
   auto q = clCreateCommandQueue(
-      ctx.get(), dev.get(), (enable_profiling ? CL_QUEUE_PROFILING_ENABLE : 0),
+      ctx.get(), dev.get(), (profiling ? CL_QUEUE_PROFILING_ENABLE : 0),
       &error_code);
   detail::error::report(error_code);
 
-  if (register_with_synchronizer) {
-    detail::synchronizer::add(this);
+  return q;
+}
+
+void queue::register_queue(info::queue_profiling profiling_requested) {
+  cl_command_queue_properties properties = 0;
+  auto error_code =
+      clGetCommandQueueInfo(command_q.get(), CL_QUEUE_PROPERTIES,
+                            sizeof(properties), &properties, nullptr);
+  detail::error::report(error_code);
+  if (properties & CL_QUEUE_PROFILING_ENABLE) {
+    prof.reset(new detail::profiler(
+        profiling_requested || detail::profiler::is_enabled_by_default()));
   }
 
-  return q;
+  detail::synchronizer::add(this);
+  is_registered = true;
+  detail::kernel_store::extract_registered(ctx);
 }
 
 queue::queue(const async_handler& asyncHandler)
@@ -41,6 +61,7 @@ queue::queue(const async_handler& asyncHandler)
       command_q(create_queue()),
       command_group(this) {
   command_q.release_one();
+  register_queue();
 }
 
 queue::queue(const device_selector& deviceSelector,
@@ -50,6 +71,7 @@ queue::queue(const device_selector& deviceSelector,
       command_q(create_queue()),
       command_group(this) {
   command_q.release_one();
+  register_queue();
 }
 
 queue::queue(const context& syclContext, const device_selector& deviceSelector,
@@ -62,6 +84,7 @@ queue::queue(const context& syclContext, const device_selector& deviceSelector,
       command_q(create_queue()),
       command_group(this) {
   command_q.release_one();
+  register_queue();
 }
 
 queue::queue(const context& syclContext, const device& syclDevice,
@@ -74,9 +97,10 @@ queue::queue(const context& syclContext, const device& syclDevice,
              const async_handler& asyncHandler)
     : ctx(syclContext.get(), asyncHandler),
       dev(syclDevice),
-      command_q(create_queue(profilingFlag)),
+      command_q(create_queue(true, profilingFlag)),
       command_group(this) {
   command_q.release_one();
+  register_queue(profilingFlag);
 }
 
 // Creates a queue for the provided device.
@@ -86,6 +110,7 @@ queue::queue(const device& syclDevice, const async_handler& asyncHandler)
       command_q(create_queue()),
       command_group(this) {
   command_q.release_one();
+  register_queue();
 }
 
 // Creates a SYCL queue from an OpenCL queue.
@@ -96,13 +121,33 @@ queue::queue(cl_command_queue clQueue, const async_handler& asyncHandler)
 
   ctx = context(get_info<info::queue::context>(), asyncHandler);
   dev = device(get_info<info::queue::device>());
-
-  detail::synchronizer::add(this);
+  // Profiling was enabled by the creator of the OpenCL queue
+  register_queue(true);
 }
 
 queue::~queue() {
-  detail::synchronizer::remove(this);
-  wait_and_throw();
+  // Subqueues are destroyed while the master queue is locked
+  if (is_registered) {
+    detail::synchronizer::remove(this);
+  }
+  wait_all(true);
+  // Exceptions can't leave the destructor,
+  // so build errors are passed to the async handler instead
+  if (build_error != CL_SUCCESS) {
+    detail::error::thrower::add_async(ex_list, build_error, &ctx);
+    build_error = CL_SUCCESS;
+  }
+  throw_asynchronous();
+  if (prof == nullptr) {
+    return;
+  }
+  // Each subqueue finishes the track of its own OpenCL queue
+  if (command_q.get() != nullptr) {
+    detail::tracer::finish(command_q.get());
+  }
+  if (is_registered && prof->is_requested()) {
+    prof->report(std::cerr);
+  }
 }
 
 bool queue::is_host() {
@@ -127,27 +172,145 @@ device queue::get_device() const {
 // If no async_handler was provided then asynchronous exceptions will be lost.
 void queue::throw_asynchronous() {
   if (ex_list.size() > 0) {
-    detail::error::thrower::report_async(&ctx, ex_list);
+    // Each error is only reported once
+    exception_list list;
+    std::swap(list, ex_list);
+    detail::error::thrower::report_async(&ctx, list);
   }
 }
 
+// Subqueues are only waited on by their master queue,
+// so only master queues count the wait time
+detail::counters* queue::wait_counters() {
+  return (is_registered ? detail::counters::get(this).get() : nullptr);
+}
+
 void queue::wait() {
-  finish();
-  wait_subqueues(false);
+  wait_all(false);
+  report_build_error();
 }
 
 void queue::wait_and_throw() {
-  finish();
-  wait_subqueues(true);
+  wait_all(true);
+  report_build_error();
+  // The async handler is free to use the queue again
   throw_asynchronous();
 }
 
-void queue::flush() {
+void queue::wait_all(bool and_throw) {
+  detail::counters::timer timer(wait_counters(), info::counter::wait_time);
+  std::lock_guard<mutex_class> lock(queue_lock);
+  process_subqueues(true);
+  finish();
+  wait_subqueues(and_throw);
+}
+
+// Thrown without holding the queue lock
+void queue::report_build_error() {
+  ::cl_int error_code;
+  {
+    std::lock_guard<mutex_class> lock(queue_lock);
+    error_code = build_error;
+    build_error = CL_SUCCESS;
+  }
+  detail::error::report(error_code, &ctx);
+}
+
+bool queue::is_profiling() const {
+  return prof != nullptr && prof->is_requested();
+}
+
+vector_class<detail::profiler::record> queue::get_profiling_log() {
+  if (!is_profiling()) {
+    return {};
+  }
+  wait();
+  return prof->get_log();
+}
+
+vector_class<detail::profiler::stats> queue::get_kernel_stats() {
+  if (!is_profiling()) {
+    return {};
+  }
+  wait();
+  return prof->kernel_stats();
+}
+
+vector_class<detail::profiler::stats> queue::get_buffer_stats() {
+  if (!is_profiling()) {
+    return {};
+  }
+  wait();
+  return prof->buffer_stats();
+}
+
+bool queue::is_using(detail::buffer_base* buf) {
+  std::lock_guard<mutex_class> lock(queue_lock);
+  if (buffers_in_use.count(buf) > 0) {
+    return true;
+  }
+  // Command groups can still be waiting for their kernels to be built
+  for (auto& q : subqueues) {
+    if (!q.is_flushed && (q.command_group.read_buffers.count(buf) > 0 ||
+                          q.command_group.write_buffers.count(buf) > 0)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+handler_event queue::add_subqueue(queue&& subqueue) {
+  handler_event events;
+  {
+    std::lock_guard<mutex_class> lock(queue_lock);
+    subqueues.push_back(std::move(subqueue));
+    events = subqueues.back().command_group.events;
+
+    for (auto& build : subqueues.back().command_group.builds) {
+      build->on_done([this]() { detail::synchronizer::flush_built(this); });
+    }
+
+    process_subqueues(false);
+  }
+  report_build_error();
+  return events;
+}
+
+// Command groups are enqueued in submission order,
+// a group waiting for its kernels holds back all later groups.
+// Groups with a failed build are dropped, the error is kept
+// for the next submit or wait, since this is also called from destructors.
+void queue::process_subqueues(bool wait_for_builds) {
   for (auto& q : subqueues) {
+    if (q.is_flushed) {
+      continue;
+    }
+    if (!wait_for_builds && !q.command_group.is_build_done()) {
+      return;
+    }
+    auto error_code = q.command_group.wait_for_builds();
+    if (error_code != CL_SUCCESS) {
+      q.command_group.drop();
+      q.is_flushed = true;
+      if (build_error == CL_SUCCESS) {
+        build_error = error_code;
+      }
+      continue;
+    }
     q.process(buffers_in_use);
   }
 }
 
+void queue::flush() {
+  std::lock_guard<mutex_class> lock(queue_lock);
+  process_subqueues(true);
+}
+
+void queue::flush_built() {
+  std::lock_guard<mutex_class> lock(queue_lock);
+  process_subqueues(false);
+}
+
 void queue::finish() {
   if (command_q.get() != nullptr) {
     auto error_code = clFinish(command_q.get());
@@ -169,8 +332,7 @@ handler_event queue::process(buffer_set& buffers_in_use_master) {
   if (is_flushed ||
       !detail::synchronizer::can_flush(command_group.read_buffers) ||
       !detail::synchronizer::can_flush(command_group.write_buffers)) {
-    // TODO(progtx):
-    return handler_event();
+    return command_group.events;
   }
   command_group.optimize();
   command_group.flush(
@@ -178,7 +340,7 @@ handler_event queue::process(buffer_set& buffers_in_use_master) {
   buffers_in_use_master.insert(command_group.write_buffers.begin(),
                                command_group.write_buffers.end());
   is_flushed = true;
-  return handler_event();
+  return command_group.events;
 }
 
 vector_class<cl_event> queue::get_wait_events(const buffer_set& dependencies,
@@ -189,6 +351,7 @@ vector_class<cl_event> queue::get_wait_events(const buffer_set& dependencies,
   for (auto&& buf : dependencies) {
     auto buf_it = buffers_in_use.find(buf);
     if (buf_it != buffers_in_use.end()) {
+      std::lock_guard<mutex_class> lock(buf->events_lock);
       auto size = buf->events.size();
       if (size == 0) {
         remove_dependencies.push_back(buf_it);
@@ -0,0 +1,81 @@
+#include "benchmark.h"
+
+// Host-device bandwidth by transfer size and mode,
+// measured from the profiled upload and download commands.
+// The kernel only touches a single element,
+// the runtime still copies the whole buffer.
+
+using namespace cl::sycl;
+using command_t = detail::profiler::command_t;
+
+static const int repetitions = 10;
+
+template <access::mode mode>
+static void touch(queue& q, buffer<int>& data) {
+  q.submit([&](handler& cgh) {
+    auto d = data.get_access<mode>(cgh);
+    cgh.single_task<class touch_kernel>([=]() { d[0] = 1; });
+  });
+  q.wait();
+}
+
+static void touch_read(queue& q, buffer<int>& data, buffer<int>& result) {
+  q.submit([&](handler& cgh) {
+    auto d = data.get_access<access::mode::read>(cgh);
+    auto r = result.get_access<access::mode::write>(cgh);
+    cgh.single_task<class touch_read_kernel>([=]() { r[0] = d[0]; });
+  });
+  q.wait();
+}
+
+int main(int argc, char* argv[]) {
+  context ctx;
+  queue q(ctx, ctx.get_devices()[0], true);
+  benchmark::reporter report("bandwidth", q);
+  buffer<int> result(1);
+  size_t position = 0;
+
+  // Bytes per nanosecond are gigabytes per second
+  auto add = [&](const char* name, long long bytes,
+                 benchmark::device_time time) {
+    if (time.ns > 0) {
+      report.add(name, {{"bytes", bytes}}, time.bytes / time.ns, "GB/s");
+    }
+  };
+
+  for (size_t bytes = 4096; bytes <= (64u << 20); bytes *= 8) {
+    std::vector<int> host(bytes / sizeof(int), 1);
+    auto b = static_cast<long long>(bytes);
+
+    {
+      buffer<int> data(host.data(), host.size());
+      for (int r = 0; r < repetitions; ++r) {
+        touch_read(q, data, result);
+      }
+      add("upload", b,
+          benchmark::get_device_time(q, position, command_t::upload));
+    }
+    {
+      buffer<int> data(host.data(), host.size());
+      for (int r = 0; r < repetitions; ++r) {
+        touch<access::mode::discard_write>(q, data);
+      }
+      add("download", b,
+          benchmark::get_device_time(q, position, command_t::download));
+    }
+    {
+      buffer<int> data(host.data(), host.size());
+      for (int r = 0; r < repetitions; ++r) {
+        touch<access::mode::read_write>(q, data);
+      }
+      auto start = position;
+      add("read_write_upload", b,
+          benchmark::get_device_time(q, position, command_t::upload));
+      position = start;
+      add("read_write_download", b,
+          benchmark::get_device_time(q, position, command_t::download));
+    }
+  }
+
+  return report.finish(argc, argv);
+}
@@ -0,0 +1,146 @@
+#pragma once
+
+#include "../common.h"
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Minimal harness shared by the benchmarks.
+// Results are written as JSON to the file given as the first argument,
+// or to the standard output, so they can be compared across versions.
+
+#ifndef SYCL_GTX_BENCHMARK_VERSION
+#define SYCL_GTX_BENCHMARK_VERSION "unknown"
+#endif
+
+namespace benchmark {
+
+using parameters = std::vector<std::pair<std::string, long long>>;
+
+struct result {
+  std::string name;
+  parameters params;
+  double value;
+  std::string unit;
+};
+
+class reporter {
+ private:
+  std::string suite;
+  std::string device;
+  std::vector<result> results;
+
+  static void write_string(std::ostream& os, const std::string& text) {
+    os << '"';
+    for (auto c : text) {
+      if (c == '"' || c == '\\') {
+        os << '\\';
+      }
+      os << c;
+    }
+    os << '"';
+  }
+
+  void write(std::ostream& os) const {
+    os << "{\n  \"suite\": ";
+    write_string(os, suite);
+    os << ",\n  \"version\": ";
+    write_string(os, SYCL_GTX_BENCHMARK_VERSION);
+    os << ",\n  \"device\": ";
+    write_string(os, device);
+    os << ",\n  \"results\": [";
+    for (size_t i = 0; i < results.size(); ++i) {
+      auto& r = results[i];
+      os << (i == 0 ? "\n" : ",\n") << "    {\"name\": ";
+      write_string(os, r.name);
+      os << ", \"params\": {";
+      for (size_t p = 0; p < r.params.size(); ++p) {
+        os << (p == 0 ? "" : ", ");
+        write_string(os, r.params[p].first);
+        os << ": " << r.params[p].second;
+      }
+      os << "}, \"value\": " << r.value << ", \"unit\": ";
+      write_string(os, r.unit);
+      os << "}";
+    }
+    os << "\n  ]\n}\n";
+  }
+
+ public:
+  reporter(std::string suite, cl::sycl::queue& q)
+      : suite(std::move(suite)),
+        device(q.get_device()
+                   .get_info<cl::sycl::info::device::name>()
+                   .c_str()) {}
+
+  void add(std::string name, parameters params, double value,
+           std::string unit) {
+    std::cerr << suite << ' ' << name;
+    for (auto& p : params) {
+      std::cerr << ' ' << p.first << '=' << p.second;
+    }
+    std::cerr << ": " << value << ' ' << unit << std::endl;
+    results.push_back({std::move(name), std::move(params), value,
+                       std::move(unit)});
+  }
+
+  // Returns the exit code of the benchmark
+  int finish(int argc, char* argv[]) const {
+    if (argc < 2) {
+      write(std::cout);
+      return 0;
+    }
+    std::ofstream file(argv[1], std::ios::trunc);
+    write(file);
+    return file ? 0 : 1;
+  }
+};
+
+using clock = std::chrono::steady_clock;
+
+// Microseconds since start
+inline double elapsed_us(clock::time_point start) {
+  return std::chrono::duration<double, std::micro>(clock::now() - start)
+      .count();
+}
+
+// Mean time of the function in microseconds
+template <class F>
+double time_us(int repetitions, F function) {
+  auto start = clock::now();
+  for (int r = 0; r < repetitions; ++r) {
+    function();
+  }
+  return elapsed_us(start) / repetitions;
+}
+
+// Sums up the device time and the bytes of the commands of one type,
+// recorded by a profiling queue since the given position in its log.
+// The position is moved to the end of the log.
+struct device_time {
+  double ns;
+  size_t bytes;
+  size_t count;
+};
+
+inline device_time get_device_time(
+    cl::sycl::queue& q, size_t& position,
+    cl::sycl::detail::profiler::command_t type) {
+  auto log = q.get_profiling_log();
+  device_time total = {0, 0, 0};
+  for (; position < log.size(); ++position) {
+    auto& record = log[position];
+    if (record.type == type) {
+      total.ns += static_cast<double>(record.end - record.start);
+      total.bytes += record.bytes;
+      ++total.count;
+    }
+  }
+  return total;
+}
+
+}  // namespace benchmark
@@ -0,0 +1,43 @@
+#include "benchmark.h"
+
+// Cold and warm kernel compilation.
+// Every cold kernel differs in a constant, so it misses the program cache,
+// warm kernels are the same as one that was already built.
+// Cold kernels are timed by the compile_time counter of the context,
+// so only the build counts. Warm kernels are not built,
+// their whole submission is timed instead.
+
+using namespace cl::sycl;
+
+static const int repetitions = 10;
+
+int main(int argc, char* argv[]) {
+  queue q;
+  auto ctx = q.get_context();
+  benchmark::reporter report("compile_time", q);
+  buffer<int> data(64);
+
+  auto submit = [&](int constant) {
+    q.submit([&](handler& cgh) {
+      auto d = data.get_access<access::mode::read_write>(cgh);
+      cgh.parallel_for<class compiled>(range<1>(64),
+                                       [=](id<1> i) { d[i] += constant; });
+    });
+    q.wait();
+  };
+
+  int constant = 0;
+  auto compile_start = ctx.get_counter<info::counter::compile_time>();
+  for (int r = 0; r < repetitions; ++r) {
+    submit(++constant);
+  }
+  auto compile_ns =
+      ctx.get_counter<info::counter::compile_time>() - compile_start;
+  report.add("cold", {{"kernels", repetitions}},
+             compile_ns / 1000.0 / repetitions, "us");
+  report.add("warm_submit", {{"kernels", repetitions}},
+             benchmark::time_us(repetitions, [&]() { submit(constant); }),
+             "us");
+
+  return report.finish(argc, argv);
+}
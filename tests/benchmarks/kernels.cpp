@@ -0,0 +1,164 @@
+#include "benchmark.h"
+
+// Throughput of the kernels used by the regression tests
+// at several sizes, from the profiled device time of the kernels.
+
+using namespace cl::sycl;
+using command_t = detail::profiler::command_t;
+
+static const int repetitions = 5;
+
+static void vector_add(queue& q, size_t n) {
+  buffer<float> a(n);
+  buffer<float> b(n);
+  buffer<float> c(n);
+  for (int r = 0; r < repetitions; ++r) {
+    q.submit([&](handler& cgh) {
+      auto ka = a.get_access<access::mode::read>(cgh);
+      auto kb = b.get_access<access::mode::read>(cgh);
+      auto kc = c.get_access<access::mode::discard_write>(cgh);
+      cgh.parallel_for<class vector_add_kernel>(
+          range<1>(n), [=](id<1> i) { kc[i] = ka[i] + kb[i]; });
+    });
+  }
+}
+
+static void matrix_rotation(queue& q, size_t n) {
+  buffer<float, 2> a(range<2>(n, n));
+  buffer<float, 2> b(range<2>(n, n));
+  for (int r = 0; r < repetitions; ++r) {
+    q.submit([&](handler& cgh) {
+      auto ka = a.get_access<access::mode::read>(cgh);
+      auto kb = b.get_access<access::mode::discard_write>(cgh);
+      cgh.parallel_for<class rotation_kernel>(
+          range<2>(n, n), [=](id<2> i) { kb[n - i[1] - 1][i[0]] = ka[i]; });
+    });
+  }
+}
+
+static void reduction(queue& q, size_t n) {
+  buffer<int> v(n);
+  for (int r = 0; r < repetitions; ++r) {
+    q.submit([&](handler& cgh) {
+      auto kv = v.get_access<access::mode::read_write>(cgh);
+      for (size_t stride = 1; stride < n; stride *= 2) {
+        cgh.parallel_for<class reduction_kernel>(
+            range<1>(n / 2 / stride), [=](id<1> index) {
+              auto i = 2 * stride * index;
+              kv[i] += kv[i + stride];
+            });
+      }
+    });
+  }
+}
+
+// Naive inclusive scan, one pass for each power of two
+static void prefix_sum(queue& q, size_t n) {
+  buffer<int> a(n);
+  buffer<int> b(n);
+  for (int r = 0; r < repetitions; ++r) {
+    bool swap = false;
+    for (size_t offset = 1; offset < n; offset *= 2) {
+      auto& in = (swap ? b : a);
+      auto& out = (swap ? a : b);
+      q.submit([&](handler& cgh) {
+        auto ki = in.get_access<access::mode::read>(cgh);
+        auto ko = out.get_access<access::mode::discard_write>(cgh);
+        cgh.parallel_for<class prefix_sum_kernel>(
+            range<1>(n), [=](id<1> i) {
+              SYCL_IF(i[0] >= offset) {
+                ko[i] = ki[i] + ki[i - offset];
+              }
+              SYCL_ELSE {
+                ko[i] = ki[i];
+              }
+              SYCL_END;
+            });
+      });
+      swap = !swap;
+    }
+  }
+}
+
+// Seven-point stencil over the interior of a cube
+static void stencil_7pt(queue& q, size_t n) {
+  buffer<float, 3> a(range<3>(n, n, n));
+  buffer<float, 3> b(range<3>(n, n, n));
+  for (int r = 0; r < repetitions; ++r) {
+    q.submit([&](handler& cgh) {
+      auto ka = a.get_access<access::mode::read>(cgh);
+      auto kb = b.get_access<access::mode::discard_write>(cgh);
+      cgh.parallel_for<class stencil_kernel>(
+          range<3>(n - 2, n - 2, n - 2), id<3>(1, 1, 1), [=](id<3> i) {
+            auto x = i[0];
+            auto y = i[1];
+            auto z = i[2];
+            kb[i] = 0.4f * ka[i] +
+                    0.1f * (ka[x - 1][y][z] + ka[x + 1][y][z] +
+                            ka[x][y - 1][z] + ka[x][y + 1][z] +
+                            ka[x][y][z - 1] + ka[x][y][z + 1]);
+          });
+    });
+  }
+}
+
+// The same stencil over the whole cube, reading from local memory
+static void stencil_7pt_tiled(queue& q, size_t n) {
+  const range<3> cube(n, n, n);
+  const range<3> group(16, 4, 4);
+  buffer<float, 3> a(cube);
+  buffer<float, 3> b(cube);
+  for (int r = 0; r < repetitions; ++r) {
+    q.submit([&](handler& cgh) {
+      auto ka = a.get_access<access::mode::read>(cgh);
+      auto kb = b.get_access<access::mode::discard_write>(cgh);
+      local_tile_3d<float> tile(group, 1, cgh);
+      cgh.parallel_for<class stencil_tiled_kernel>(
+          nd_range<3>(cube, group), [=](nd_item<3> it) {
+            tile.load(it, ka, cube);
+            kb[it.get_global()] =
+                0.4f * tile(it, 0, 0, 0) +
+                0.1f * (tile(it, -1, 0, 0) + tile(it, 1, 0, 0) +
+                        tile(it, 0, -1, 0) + tile(it, 0, 1, 0) +
+                        tile(it, 0, 0, -1) + tile(it, 0, 0, 1));
+          });
+    });
+  }
+}
+
+int main(int argc, char* argv[]) {
+  context ctx;
+  queue q(ctx, ctx.get_devices()[0], true);
+  benchmark::reporter report("kernels", q);
+  size_t position = 0;
+
+  auto measure = [&](const char* name, void (*run)(queue&, size_t),
+                     size_t size, size_t elements) {
+    // The first run builds the kernels
+    run(q, size);
+    benchmark::get_device_time(q, position, command_t::kernel);
+
+    run(q, size);
+    auto time = benchmark::get_device_time(q, position, command_t::kernel);
+    if (time.ns > 0) {
+      // Elements per nanosecond are billions of elements per second
+      report.add(name, {{"size", static_cast<long long>(size)}},
+                 elements * repetitions / time.ns, "Gelements/s");
+    }
+  };
+
+  for (size_t n : {1u << 10, 1u << 16, 1u << 20}) {
+    measure("vector_add", vector_add, n, n);
+    measure("reduction", reduction, n, n);
+    measure("prefix_sum", prefix_sum, n, n);
+  }
+  for (size_t n : {64u, 256u, 1024u}) {
+    measure("matrix_rotation", matrix_rotation, n, n * n);
+  }
+  for (size_t n : {32u, 64u, 128u}) {
+    measure("stencil_7pt", stencil_7pt, n, (n - 2) * (n - 2) * (n - 2));
+    measure("stencil_7pt_tiled", stencil_7pt_tiled, n, n * n * n);
+  }
+
+  return report.finish(argc, argv);
+}
@@ -0,0 +1,46 @@
+#include "benchmark.h"
+
+// Measures the host overhead of launching a small kernel.
+// The same kernel is launched with unchanged arguments,
+// and with the arguments changing on every launch,
+// which forces all the kernel arguments to be set again.
+
+using namespace cl::sycl;
+
+static const int size = 64;
+static const int launches = 1000;
+
+template <class kernel_name>
+static double launch(queue& q, buffer<int>& a, buffer<int>& b,
+                     bool swap_buffers) {
+  int l = 0;
+  return benchmark::time_us(launches, [&]() {
+    auto& in = (swap_buffers && l % 2 == 1) ? b : a;
+    auto& out = (swap_buffers && l % 2 == 1) ? a : b;
+    q.submit([&](handler& cgh) {
+      auto i = in.get_access<access::mode::read>(cgh);
+      auto o = out.get_access<access::mode::write>(cgh);
+      cgh.parallel_for<kernel_name>(range<1>(size),
+                                    [=](id<1> index) { o[index] = i[index]; });
+    });
+    q.wait();
+    ++l;
+  });
+}
+
+int main(int argc, char* argv[]) {
+  queue q;
+  benchmark::reporter report("launch_overhead", q);
+  buffer<int> a(size);
+  buffer<int> b(size);
+
+  // Warm up, so that the kernel is already built
+  launch<class copy>(q, a, b, false);
+
+  report.add("unchanged_arguments", {{"launches", launches}},
+             launch<class copy>(q, a, b, false), "us");
+  report.add("changed_arguments", {{"launches", launches}},
+             launch<class copy>(q, a, b, true), "us");
+
+  return report.finish(argc, argv);
+}
@@ -0,0 +1,51 @@
+#include "benchmark.h"
+
+// Latency of submitting command groups:
+// an empty command group and a single task without any work,
+// both waited for after every submit and submitted back to back.
+
+using namespace cl::sycl;
+
+static const int submits = 1000;
+
+int main(int argc, char* argv[]) {
+  queue q;
+  benchmark::reporter report("submit_latency", q);
+  buffer<int> data(1);
+
+  auto empty = [&]() { q.submit([](handler&) {}); };
+  auto task = [&]() {
+    q.submit([&](handler& cgh) {
+      auto d = data.get_access<access::mode::write>(cgh);
+      cgh.single_task<class empty_task>([=]() { d[0] = 0; });
+    });
+  };
+
+  // Warm up, so that the kernel is already built
+  task();
+  q.wait();
+
+  report.add("empty_submit_wait", {{"submits", submits}},
+             benchmark::time_us(submits,
+                                [&]() {
+                                  empty();
+                                  q.wait();
+                                }),
+             "us");
+  report.add("empty_submit", {{"submits", submits}},
+             benchmark::time_us(submits, empty), "us");
+  q.wait();
+
+  report.add("task_submit_wait", {{"submits", submits}},
+             benchmark::time_us(submits,
+                                [&]() {
+                                  task();
+                                  q.wait();
+                                }),
+             "us");
+  report.add("task_submit", {{"submits", submits}},
+             benchmark::time_us(submits, task), "us");
+  q.wait();
+
+  return report.finish(argc, argv);
+}
@@ -0,0 +1,45 @@
+#include "benchmark.h"
+
+// Time to trace a kernel of a growing number of statements.
+// The program is built before measuring, so only the kernel invocation
+// inside the command group is timed, the span recorded as handler::build.
+// Submitting, enqueueing and waiting for the kernel are not included.
+
+using namespace cl::sycl;
+
+static const int repetitions = 20;
+
+int main(int argc, char* argv[]) {
+  queue q;
+  benchmark::reporter report("trace_time", q);
+  buffer<int> data(64);
+
+  for (int statements : {1, 10, 100, 1000}) {
+    double total_us = 0;
+    auto submit = [&]() {
+      q.submit([&](handler& cgh) {
+        auto d = data.get_access<access::mode::read_write>(cgh);
+        auto start = benchmark::clock::now();
+        cgh.parallel_for<class statements_kernel>(
+            range<1>(64), [=](id<1> i) {
+              // Host loops are unrolled while tracing
+              for (int s = 0; s < statements; ++s) {
+                d[i] += s;
+              }
+            });
+        total_us += benchmark::elapsed_us(start);
+      });
+      q.wait();
+    };
+    submit();
+
+    total_us = 0;
+    for (int r = 0; r < repetitions; ++r) {
+      submit();
+    }
+    report.add("trace", {{"statements", statements}},
+               total_us / repetitions, "us");
+  }
+
+  return report.finish(argc, argv);
+}
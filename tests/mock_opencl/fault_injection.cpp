@@ -0,0 +1,88 @@
+#include "../common.h"
+#include "mock_opencl.h"
+
+// Injects OpenCL errors through the mock library
+// and checks that they are reported to the caller.
+
+using namespace cl::sycl;
+
+static int queue_creation() {
+  mock_cl_reset();
+  mock_cl_inject("clCreateCommandQueue", CL_OUT_OF_HOST_MEMORY, 0, 1);
+  try {
+    queue myQueue;
+  } catch (cl_exception& e) {
+    if (e.get_cl_code() == CL_OUT_OF_HOST_MEMORY) {
+      return 0;
+    }
+    debug() << "Unexpected error code" << e.get_cl_code();
+    return 1;
+  }
+  debug() << "Failed queue creation was not reported";
+  return 1;
+}
+
+static int kernel_launch() {
+  mock_cl_reset();
+  mock_cl_inject("clEnqueueNDRangeKernel", CL_OUT_OF_RESOURCES, 0, 1);
+  int result = 1;
+  try {
+    queue myQueue;
+    buffer<int> data(16);
+    myQueue.submit([&](handler& cgh) {
+      auto d = data.get_access<access::mode::discard_write>(cgh);
+      cgh.parallel_for<class failed_launch>(range<1>(16),
+                                            [=](id<1> i) { d[i] = i; });
+    });
+    myQueue.wait();
+  } catch (cl_exception& e) {
+    if (e.get_cl_code() == CL_OUT_OF_RESOURCES) {
+      result = 0;
+    } else {
+      debug() << "Unexpected error code" << e.get_cl_code();
+    }
+  }
+  if (result != 0) {
+    debug() << "Failed kernel launch was not reported";
+  }
+  return result;
+}
+
+// The queue is destroyed without waiting,
+// so the error reaches the async handler unless submit threw it
+static int kernel_build() {
+  mock_cl_reset();
+  mock_cl_inject("clBuildProgram", CL_BUILD_PROGRAM_FAILURE, 0, 1);
+  int reported = 0;
+  {
+    async_handler count_errors = [&](exception_list list) {
+      reported += static_cast<int>(list.size());
+    };
+    queue myQueue(count_errors);
+    buffer<int> data(16);
+    try {
+      myQueue.submit([&](handler& cgh) {
+        auto d = data.get_access<access::mode::discard_write>(cgh);
+        cgh.parallel_for<class failed_build>(range<1>(16),
+                                             [=](id<1> i) { d[i] = i; });
+      });
+    } catch (cl_exception& e) {
+      if (e.get_cl_code() == CL_BUILD_PROGRAM_FAILURE) {
+        ++reported;
+      }
+    }
+  }
+  if (reported != 1) {
+    debug() << "Expected one failed build, got" << reported;
+    return 1;
+  }
+  return 0;
+}
+
+int main() {
+  int result = 0;
+  result += queue_creation();
+  result += kernel_launch();
+  result += kernel_build();
+  return result;
+}
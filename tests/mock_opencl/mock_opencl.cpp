@@ -0,0 +1,1629 @@
+// Mock OpenCL 1.2 implementation for tests and benchmarks.
+// Buffers and transfers are real host memory operations,
+// programs always build and kernels are never executed.
+// Any entry point can be made to fail, see mock_opencl.h.
+
+#define CL_USE_DEPRECATED_OPENCL_1_2_APIS
+#ifdef __APPLE__
+#include <OpenCL/cl.h>
+#else
+#include <CL/cl.h>
+#endif
+
+#include "mock_opencl.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Fault injection
+
+struct fault {
+  cl_int error_code;
+  unsigned int skip_calls;
+  unsigned int fail_calls;
+};
+
+static std::mutex state_lock;
+static std::map<std::string, unsigned long> calls;
+static std::map<std::string, fault> faults;
+static std::once_flag env_flag;
+
+static void read_environment() {
+  // MOCK_CL_INJECT=function:error_code[:skip_calls[:fail_calls]],...
+  auto env = std::getenv("MOCK_CL_INJECT");
+  if (env == nullptr) {
+    return;
+  }
+  std::stringstream list(env);
+  std::string entry;
+  while (std::getline(list, entry, ',')) {
+    std::stringstream fields(entry);
+    std::string function;
+    std::string value;
+    std::getline(fields, function, ':');
+    fault f{CL_OUT_OF_RESOURCES, 0, ~0u};
+    if (std::getline(fields, value, ':')) {
+      f.error_code = std::atoi(value.c_str());
+    }
+    if (std::getline(fields, value, ':')) {
+      f.skip_calls = static_cast<unsigned int>(std::atoi(value.c_str()));
+    }
+    if (std::getline(fields, value, ':')) {
+      f.fail_calls = static_cast<unsigned int>(std::atoi(value.c_str()));
+    }
+    faults[function] = f;
+  }
+}
+
+static cl_int enter(const char* function) {
+  std::call_once(env_flag, read_environment);
+  std::lock_guard<std::mutex> guard(state_lock);
+  ++calls[function];
+  auto it = faults.find(function);
+  if (it == faults.end()) {
+    return CL_SUCCESS;
+  }
+  auto& f = it->second;
+  if (f.skip_calls > 0) {
+    --f.skip_calls;
+    return CL_SUCCESS;
+  }
+  if (f.fail_calls == 0) {
+    return CL_SUCCESS;
+  }
+  --f.fail_calls;
+  return f.error_code;
+}
+
+static unsigned long env_number(const char* name) {
+  auto env = std::getenv(name);
+  return (env == nullptr ? 0 : std::strtoul(env, nullptr, 10));
+}
+
+static cl_ulong now() {
+  using namespace std::chrono;
+  return static_cast<cl_ulong>(
+      duration_cast<nanoseconds>(steady_clock::now().time_since_epoch())
+          .count());
+}
+
+static cl_int set_info(const void* value, size_t value_size,
+                       size_t param_value_size, void* param_value,
+                       size_t* param_value_size_ret) {
+  if (param_value != nullptr) {
+    if (param_value_size < value_size) {
+      return CL_INVALID_VALUE;
+    }
+    std::memcpy(param_value, value, value_size);
+  }
+  if (param_value_size_ret != nullptr) {
+    *param_value_size_ret = value_size;
+  }
+  return CL_SUCCESS;
+}
+
+template <class T>
+static cl_int set_info(const T& value, size_t param_value_size,
+                       void* param_value, size_t* param_value_size_ret) {
+  return set_info(&value, sizeof(T), param_value_size, param_value,
+                  param_value_size_ret);
+}
+
+static cl_int set_info(const std::string& value, size_t param_value_size,
+                       void* param_value, size_t* param_value_size_ret) {
+  return set_info(value.c_str(), value.size() + 1, param_value_size,
+                  param_value, param_value_size_ret);
+}
+
+template <class T>
+static cl_int set_info(const std::vector<T>& value, size_t param_value_size,
+                       void* param_value, size_t* param_value_size_ret) {
+  return set_info(value.data(), value.size() * sizeof(T), param_value_size,
+                  param_value, param_value_size_ret);
+}
+
+static void set_error(cl_int* errcode_ret, cl_int error_code) {
+  if (errcode_ret != nullptr) {
+    *errcode_ret = error_code;
+  }
+}
+
+#define MOCK_CL_ENTER()                     \
+  do {                                      \
+    auto injected_error = enter(__func__);  \
+    if (injected_error != CL_SUCCESS) {     \
+      return injected_error;                \
+    }                                       \
+  } while (false)
+
+#define MOCK_CL_ENTER_CREATE(errcode_ret)        \
+  do {                                           \
+    auto injected_error = enter(__func__);       \
+    if (injected_error != CL_SUCCESS) {          \
+      if (errcode_ret != nullptr) {              \
+        *errcode_ret = injected_error;           \
+      }                                          \
+      return nullptr;                            \
+    }                                            \
+  } while (false)
+
+// Objects
+
+struct mock_object {
+  std::atomic<cl_uint> references;
+  mock_object() : references(1) {}
+  virtual ~mock_object() = default;
+};
+
+template <class T>
+static cl_int retain(T* object) {
+  if (object == nullptr) {
+    return CL_INVALID_VALUE;
+  }
+  ++object->references;
+  return CL_SUCCESS;
+}
+
+template <class T>
+static cl_int release(T* object) {
+  if (object == nullptr) {
+    return CL_INVALID_VALUE;
+  }
+  if (--object->references == 0) {
+    delete object;
+  }
+  return CL_SUCCESS;
+}
+
+struct _cl_platform_id {};
+struct _cl_device_id {};
+
+static _cl_platform_id the_platform;
+static _cl_device_id the_device;
+
+struct _cl_context : mock_object {
+  std::vector<cl_device_id> devices;
+  std::vector<cl_context_properties> properties;
+};
+
+struct _cl_command_queue : mock_object {
+  cl_context ctx;
+  cl_device_id dev;
+  cl_command_queue_properties properties;
+
+  _cl_command_queue(cl_context ctx, cl_device_id dev,
+                    cl_command_queue_properties properties)
+      : ctx(ctx), dev(dev), properties(properties) {
+    retain(ctx);
+  }
+  ~_cl_command_queue() {
+    release(ctx);
+  }
+};
+
+struct _cl_mem : mock_object {
+  cl_context ctx;
+  cl_mem_flags flags;
+  size_t size;
+  void* host_ptr;
+  std::shared_ptr<std::vector<char>> storage;
+  cl_mem parent = nullptr;
+  size_t offset = 0;
+
+  _cl_mem(cl_context ctx, cl_mem_flags flags, size_t size, void* host_ptr)
+      : ctx(ctx), flags(flags), size(size), host_ptr(host_ptr) {
+    retain(ctx);
+  }
+  ~_cl_mem() {
+    if (parent != nullptr) {
+      release(parent);
+    }
+    release(ctx);
+  }
+
+  char* data() {
+    return storage->data() + offset;
+  }
+};
+
+struct _cl_program : mock_object {
+  cl_context ctx;
+  std::string source;
+  std::string options;
+  std::string log;
+  cl_build_status status = CL_BUILD_NONE;
+  cl_program_binary_type binary_type = CL_PROGRAM_BINARY_TYPE_NONE;
+  std::vector<std::string> kernel_names;
+
+  explicit _cl_program(cl_context ctx) : ctx(ctx) {
+    retain(ctx);
+  }
+  ~_cl_program() {
+    release(ctx);
+  }
+
+  void find_kernels() {
+    kernel_names.clear();
+    static const std::string marker = "__kernel void ";
+    for (auto pos = source.find(marker); pos != std::string::npos;
+         pos = source.find(marker, pos + 1)) {
+      auto start = pos + marker.size();
+      auto end = source.find('(', start);
+      kernel_names.push_back(source.substr(start, end - start));
+    }
+  }
+
+  // Number of parameters of a kernel, counted from its signature
+  cl_uint num_args(const std::string& name) const {
+    auto pos = source.find("__kernel void " + name + "(");
+    if (pos == std::string::npos) {
+      return 0;
+    }
+    auto start = source.find('(', pos) + 1;
+    auto end = source.find(')', start);
+    auto list = source.substr(start, end - start);
+    if (list.find_first_not_of(" \t\n") == std::string::npos) {
+      return 0;
+    }
+    return static_cast<cl_uint>(std::count(list.begin(), list.end(), ',') + 1);
+  }
+
+  cl_int build(const char* build_options) {
+    options = (build_options == nullptr ? "" : build_options);
+    auto delay = env_number("MOCK_CL_BUILD_DELAY_MS");
+    if (delay > 0) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(delay));
+    }
+    if (source.find("#error") != std::string::npos) {
+      status = CL_BUILD_ERROR;
+      log = "mock: #error directive in source";
+      return CL_BUILD_PROGRAM_FAILURE;
+    }
+    status = CL_BUILD_SUCCESS;
+    log = "";
+    find_kernels();
+    return CL_SUCCESS;
+  }
+};
+
+struct _cl_kernel : mock_object {
+  cl_program prog;
+  std::string name;
+  std::vector<std::vector<char>> args;
+
+  _cl_kernel(cl_program prog, std::string name)
+      : prog(prog), name(std::move(name)), args(prog->num_args(this->name)) {
+    retain(prog);
+  }
+  ~_cl_kernel() {
+    release(prog);
+  }
+};
+
+struct _cl_event : mock_object {
+  cl_context ctx;
+  cl_command_queue q;
+  cl_command_type type;
+  cl_int status;
+  cl_ulong queued;
+  cl_ulong submit;
+  cl_ulong start;
+  cl_ulong end;
+
+  _cl_event(cl_context ctx, cl_command_queue q, cl_command_type type,
+            cl_int status)
+      : ctx(ctx), q(q), type(type), status(status) {
+    queued = submit = start = end = now();
+    retain(ctx);
+    if (q != nullptr) {
+      retain(q);
+    }
+  }
+  ~_cl_event() {
+    if (q != nullptr) {
+      release(q);
+    }
+    release(ctx);
+  }
+};
+
+static std::atomic<unsigned long> kernel_launches(0);
+
+// Commands complete when enqueued
+static cl_int complete(cl_command_queue q, cl_command_type type,
+                       cl_ulong start, cl_uint num_events_in_wait_list,
+                       const cl_event* event_wait_list, cl_event* evnt) {
+  if (q == nullptr) {
+    return CL_INVALID_COMMAND_QUEUE;
+  }
+  if ((num_events_in_wait_list == 0) != (event_wait_list == nullptr)) {
+    return CL_INVALID_EVENT_WAIT_LIST;
+  }
+  for (cl_uint i = 0; i < num_events_in_wait_list; ++i) {
+    if (event_wait_list[i] == nullptr) {
+      return CL_INVALID_EVENT_WAIT_LIST;
+    }
+  }
+  if (evnt != nullptr) {
+    auto e = new _cl_event(q->ctx, q, type, CL_COMPLETE);
+    e->queued = e->submit = e->start = start;
+    *evnt = e;
+  }
+  return CL_SUCCESS;
+}
+
+static bool in_bounds(cl_mem buffer, size_t offset, size_t size) {
+  return buffer != nullptr && offset + size <= buffer->size;
+}
+
+// Walks a rectangular region, calling f(dst_offset, src_offset, row_size)
+template <class F>
+static void for_each_row(const size_t* dst_origin, const size_t* src_origin,
+                         const size_t* region, size_t dst_row_pitch,
+                         size_t dst_slice_pitch, size_t src_row_pitch,
+                         size_t src_slice_pitch, F f) {
+  if (dst_row_pitch == 0) {
+    dst_row_pitch = region[0];
+  }
+  if (dst_slice_pitch == 0) {
+    dst_slice_pitch = region[1] * dst_row_pitch;
+  }
+  if (src_row_pitch == 0) {
+    src_row_pitch = region[0];
+  }
+  if (src_slice_pitch == 0) {
+    src_slice_pitch = region[1] * src_row_pitch;
+  }
+  for (size_t z = 0; z < region[2]; ++z) {
+    for (size_t y = 0; y < region[1]; ++y) {
+      f((dst_origin[2] + z) * dst_slice_pitch +
+            (dst_origin[1] + y) * dst_row_pitch + dst_origin[0],
+        (src_origin[2] + z) * src_slice_pitch +
+            (src_origin[1] + y) * src_row_pitch + src_origin[0],
+        region[0]);
+    }
+  }
+}
+
+// Mock control
+
+extern "C" {
+
+void mock_cl_inject(const char* function, cl_int error_code,
+                    unsigned int skip_calls, unsigned int fail_calls) {
+  std::call_once(env_flag, read_environment);
+  std::lock_guard<std::mutex> guard(state_lock);
+  faults[function] = fault{error_code, skip_calls, fail_calls};
+}
+
+void mock_cl_reset() {
+  std::call_once(env_flag, read_environment);
+  std::lock_guard<std::mutex> guard(state_lock);
+  faults.clear();
+  calls.clear();
+  kernel_launches = 0;
+}
+
+unsigned long mock_cl_calls(const char* function) {
+  std::lock_guard<std::mutex> guard(state_lock);
+  auto it = calls.find(function);
+  return (it == calls.end() ? 0 : it->second);
+}
+
+unsigned long mock_cl_kernel_launches() {
+  return kernel_launches;
+}
+
+// Platforms and devices
+
+cl_int clGetPlatformIDs(cl_uint num_entries, cl_platform_id* platforms,
+                        cl_uint* num_platforms) {
+  MOCK_CL_ENTER();
+  if (platforms != nullptr && num_entries > 0) {
+    platforms[0] = &the_platform;
+  }
+  if (num_platforms != nullptr) {
+    *num_platforms = 1;
+  }
+  return CL_SUCCESS;
+}
+
+cl_int clGetPlatformInfo(cl_platform_id platform, cl_platform_info param_name,
+                         size_t param_value_size, void* param_value,
+                         size_t* param_value_size_ret) {
+  MOCK_CL_ENTER();
+  std::string value;
+  switch (param_name) {
+    case CL_PLATFORM_PROFILE:
+      value = "FULL_PROFILE";
+      break;
+    case CL_PLATFORM_VERSION:
+      value = "OpenCL 1.2 mock";
+      break;
+    case CL_PLATFORM_NAME:
+      value = "Mock OpenCL platform";
+      break;
+    case CL_PLATFORM_VENDOR:
+      value = "sycl-gtx";
+      break;
+    case CL_PLATFORM_EXTENSIONS:
+      value = "";
+      break;
+    default:
+      return CL_INVALID_VALUE;
+  }
+  return set_info(value, param_value_size, param_value, param_value_size_ret);
+}
+
+cl_int clGetDeviceIDs(cl_platform_id platform, cl_device_type device_type,
+                      cl_uint num_entries, cl_device_id* devices,
+                      cl_uint* num_devices) {
+  MOCK_CL_ENTER();
+  if ((device_type & (CL_DEVICE_TYPE_GPU | CL_DEVICE_TYPE_DEFAULT)) == 0) {
+    return CL_DEVICE_NOT_FOUND;
+  }
+  if (devices != nullptr && num_entries > 0) {
+    devices[0] = &the_device;
+  }
+  if (num_devices != nullptr) {
+    *num_devices = 1;
+  }
+  return CL_SUCCESS;
+}
+
+cl_int clGetDeviceInfo(cl_device_id device, cl_device_info param_name,
+                       size_t param_value_size, void* param_value,
+                       size_t* param_value_size_ret) {
+  MOCK_CL_ENTER();
+  auto size = param_value_size;
+  auto value = param_value;
+  auto size_ret = param_value_size_ret;
+  switch (param_name) {
+    case CL_DEVICE_TYPE:
+      return set_info<cl_device_type>(CL_DEVICE_TYPE_GPU, size, value,
+                                      size_ret);
+    case CL_DEVICE_VENDOR_ID:
+      return set_info<cl_uint>(0, size, value, size_ret);
+    case CL_DEVICE_MAX_COMPUTE_UNITS:
+      return set_info<cl_uint>(16, size, value, size_ret);
+    case CL_DEVICE_MAX_WORK_ITEM_DIMENSIONS:
+      return set_info<cl_uint>(3, size, value, size_ret);
+    case CL_DEVICE_MAX_WORK_GROUP_SIZE:
+      return set_info<size_t>(1024, size, value, size_ret);
+    case CL_DEVICE_MAX_WORK_ITEM_SIZES:
+      return set_info(std::vector<size_t>{1024, 1024, 64}, size, value,
+                      size_ret);
+    case CL_DEVICE_PREFERRED_VECTOR_WIDTH_CHAR:
+    case CL_DEVICE_NATIVE_VECTOR_WIDTH_CHAR:
+      return set_info<cl_uint>(16, size, value, size_ret);
+    case CL_DEVICE_PREFERRED_VECTOR_WIDTH_SHORT:
+    case CL_DEVICE_NATIVE_VECTOR_WIDTH_SHORT:
+      return set_info<cl_uint>(8, size, value, size_ret);
+    case CL_DEVICE_PREFERRED_VECTOR_WIDTH_INT:
+    case CL_DEVICE_NATIVE_VECTOR_WIDTH_INT:
+    case CL_DEVICE_PREFERRED_VECTOR_WIDTH_FLOAT:
+    case CL_DEVICE_NATIVE_VECTOR_WIDTH_FLOAT:
+      return set_info<cl_uint>(4, size, value, size_ret);
+    case CL_DEVICE_PREFERRED_VECTOR_WIDTH_LONG:
+    case CL_DEVICE_NATIVE_VECTOR_WIDTH_LONG:
+    case CL_DEVICE_PREFERRED_VECTOR_WIDTH_DOUBLE:
+    case CL_DEVICE_NATIVE_VECTOR_WIDTH_DOUBLE:
+      return set_info<cl_uint>(2, size, value, size_ret);
+    case CL_DEVICE_PREFERRED_VECTOR_WIDTH_HALF:
+    case CL_DEVICE_NATIVE_VECTOR_WIDTH_HALF:
+      return set_info<cl_uint>(0, size, value, size_ret);
+    case CL_DEVICE_MAX_CLOCK_FREQUENCY:
+      return set_info<cl_uint>(1000, size, value, size_ret);
+    case CL_DEVICE_ADDRESS_BITS:
+      return set_info<cl_uint>(64, size, value, size_ret);
+    case CL_DEVICE_MAX_MEM_ALLOC_SIZE:
+      return set_info<cl_ulong>(cl_ulong(1) << 30, size, value, size_ret);
+    case CL_DEVICE_GLOBAL_MEM_SIZE:
+      return set_info<cl_ulong>(cl_ulong(4) << 30, size, value, size_ret);
+    case CL_DEVICE_GLOBAL_MEM_CACHE_SIZE:
+      return set_info<cl_ulong>(1 << 20, size, value, size_ret);
+    case CL_DEVICE_GLOBAL_MEM_CACHELINE_SIZE:
+      return set_info<cl_uint>(64, size, value, size_ret);
+    case CL_DEVICE_GLOBAL_MEM_CACHE_TYPE:
+      return set_info<cl_device_mem_cache_type>(CL_READ_WRITE_CACHE, size,
+                                                value, size_ret);
+    case CL_DEVICE_MAX_CONSTANT_BUFFER_SIZE:
+      return set_info<cl_ulong>(64 << 10, size, value, size_ret);
+    case CL_DEVICE_MAX_CONSTANT_ARGS:
+      return set_info<cl_uint>(8, size, value, size_ret);
+    case CL_DEVICE_LOCAL_MEM_TYPE:
+      return set_info<cl_device_local_mem_type>(CL_LOCAL, size, value,
+                                                size_ret);
+    case CL_DEVICE_LOCAL_MEM_SIZE:
+      return set_info<cl_ulong>(32 << 10, size, value, size_ret);
+    case CL_DEVICE_MAX_PARAMETER_SIZE:
+      return set_info<size_t>(1024, size, value, size_ret);
+    case CL_DEVICE_MEM_BASE_ADDR_ALIGN:
+      return set_info<cl_uint>(1024, size, value, size_ret);
+    case CL_DEVICE_MIN_DATA_TYPE_ALIGN_SIZE:
+      return set_info<cl_uint>(128, size, value, size_ret);
+    case CL_DEVICE_PROFILING_TIMER_RESOLUTION:
+      return set_info<size_t>(1, size, value, size_ret);
+    case CL_DEVICE_SINGLE_FP_CONFIG:
+    case CL_DEVICE_DOUBLE_FP_CONFIG:
+      return set_info<cl_device_fp_config>(
+          CL_FP_DENORM | CL_FP_INF_NAN | CL_FP_ROUND_TO_NEAREST | CL_FP_FMA,
+          size, value, size_ret);
+    case CL_DEVICE_EXECUTION_CAPABILITIES:
+      return set_info<cl_device_exec_capabilities>(CL_EXEC_KERNEL, size, value,
+                                                   size_ret);
+    case CL_DEVICE_QUEUE_PROPERTIES:
+      return set_info<cl_command_queue_properties>(
+          CL_QUEUE_OUT_OF_ORDER_EXEC_MODE_ENABLE | CL_QUEUE_PROFILING_ENABLE,
+          size, value, size_ret);
+    case CL_DEVICE_IMAGE_SUPPORT:
+    case CL_DEVICE_ERROR_CORRECTION_SUPPORT:
+    case CL_DEVICE_HOST_UNIFIED_MEMORY:
+      return set_info<cl_bool>(CL_FALSE, size, value, size_ret);
+    case CL_DEVICE_ENDIAN_LITTLE:
+    case CL_DEVICE_AVAILABLE:
+    case CL_DEVICE_COMPILER_AVAILABLE:
+    case CL_DEVICE_LINKER_AVAILABLE:
+      return set_info<cl_bool>(CL_TRUE, size, value, size_ret);
+    case CL_DEVICE_PLATFORM:
+      return set_info<cl_platform_id>(&the_platform, size, value, size_ret);
+    case CL_DEVICE_NAME:
+      return set_info(std::string("Mock OpenCL device"), size, value,
+                      size_ret);
+    case CL_DEVICE_VENDOR:
+      return set_info(std::string("sycl-gtx"), size, value, size_ret);
+    case CL_DRIVER_VERSION:
+      return set_info(std::string("1.0"), size, value, size_ret);
+    case CL_DEVICE_PROFILE:
+      return set_info(std::string("FULL_PROFILE"), size, value, size_ret);
+    case CL_DEVICE_VERSION:
+      return set_info(std::string("OpenCL 1.2 mock"), size, value, size_ret);
+    case CL_DEVICE_OPENCL_C_VERSION:
+      return set_info(std::string("OpenCL C 1.2"), size, value, size_ret);
+    case CL_DEVICE_EXTENSIONS:
+    case CL_DEVICE_BUILT_IN_KERNELS:
+      return set_info(std::string(""), size, value, size_ret);
+    case CL_DEVICE_PARENT_DEVICE:
+      return set_info<cl_device_id>(nullptr, size, value, size_ret);
+    case CL_DEVICE_REFERENCE_COUNT:
+      return set_info<cl_uint>(1, size, value, size_ret);
+    default:
+      return set_info<cl_ulong>(0, size, value, size_ret);
+  }
+}
+
+cl_int clCreateSubDevices(cl_device_id in_device,
+                          const cl_device_partition_property* properties,
+                          cl_uint num_devices, cl_device_id* out_devices,
+                          cl_uint* num_devices_ret) {
+  MOCK_CL_ENTER();
+  return CL_DEVICE_PARTITION_FAILED;
+}
+
+cl_int clRetainDevice(cl_device_id device) {
+  MOCK_CL_ENTER();
+  return CL_SUCCESS;
+}
+
+cl_int clReleaseDevice(cl_device_id device) {
+  MOCK_CL_ENTER();
+  return CL_SUCCESS;
+}
+
+// Contexts
+
+cl_context clCreateContext(
+    const cl_context_properties* properties, cl_uint num_devices,
+    const cl_device_id* devices,
+    void(CL_CALLBACK* pfn_notify)(const char*, const void*, size_t, void*),
+    void* user_data, cl_int* errcode_ret) {
+  MOCK_CL_ENTER_CREATE(errcode_ret);
+  if (num_devices == 0 || devices == nullptr) {
+    set_error(errcode_ret, CL_INVALID_VALUE);
+    return nullptr;
+  }
+  auto ctx = new _cl_context();
+  ctx->devices.assign(devices, devices + num_devices);
+  if (properties != nullptr) {
+    for (auto p = properties; *p != 0; p += 2) {
+      ctx->properties.push_back(p[0]);
+      ctx->properties.push_back(p[1]);
+    }
+    ctx->properties.push_back(0);
+  }
+  set_error(errcode_ret, CL_SUCCESS);
+  return ctx;
+}
+
+cl_context clCreateContextFromType(
+    const cl_context_properties* properties, cl_device_type device_type,
+    void(CL_CALLBACK* pfn_notify)(const char*, const void*, size_t, void*),
+    void* user_data, cl_int* errcode_ret) {
+  cl_device_id dev = &the_device;
+  return clCreateContext(properties, 1, &dev, pfn_notify, user_data,
+                         errcode_ret);
+}
+
+cl_int clRetainContext(cl_context context) {
+  MOCK_CL_ENTER();
+  return retain(context);
+}
+
+cl_int clReleaseContext(cl_context context) {
+  MOCK_CL_ENTER();
+  return release(context);
+}
+
+cl_int clGetContextInfo(cl_context context, cl_context_info param_name,
+                        size_t param_value_size, void* param_value,
+                        size_t* param_value_size_ret) {
+  MOCK_CL_ENTER();
+  if (context == nullptr) {
+    return CL_INVALID_CONTEXT;
+  }
+  switch (param_name) {
+    case CL_CONTEXT_REFERENCE_COUNT:
+      return set_info<cl_uint>(context->references, param_value_size,
+                               param_value, param_value_size_ret);
+    case CL_CONTEXT_NUM_DEVICES:
+      return set_info<cl_uint>(static_cast<cl_uint>(context->devices.size()),
+                               param_value_size, param_value,
+                               param_value_size_ret);
+    case CL_CONTEXT_DEVICES:
+      return set_info(context->devices, param_value_size, param_value,
+                      param_value_size_ret);
+    case CL_CONTEXT_PROPERTIES:
+      return set_info(context->properties, param_value_size, param_value,
+                      param_value_size_ret);
+    default:
+      return CL_INVALID_VALUE;
+  }
+}
+
+// Command queues
+
+cl_command_queue clCreateCommandQueue(cl_context context, cl_device_id device,
+                                      cl_command_queue_properties properties,
+                                      cl_int* errcode_ret) {
+  MOCK_CL_ENTER_CREATE(errcode_ret);
+  if (context == nullptr) {
+    set_error(errcode_ret, CL_INVALID_CONTEXT);
+    return nullptr;
+  }
+  if (device == nullptr) {
+    set_error(errcode_ret, CL_INVALID_DEVICE);
+    return nullptr;
+  }
+  set_error(errcode_ret, CL_SUCCESS);
+  return new _cl_command_queue(context, device, properties);
+}
+
+cl_int clRetainCommandQueue(cl_command_queue command_queue) {
+  MOCK_CL_ENTER();
+  return retain(command_queue);
+}
+
+cl_int clReleaseCommandQueue(cl_command_queue command_queue) {
+  MOCK_CL_ENTER();
+  return release(command_queue);
+}
+
+cl_int clGetCommandQueueInfo(cl_command_queue command_queue,
+                             cl_command_queue_info param_name,
+                             size_t param_value_size, void* param_value,
+                             size_t* param_value_size_ret) {
+  MOCK_CL_ENTER();
+  if (command_queue == nullptr) {
+    return CL_INVALID_COMMAND_QUEUE;
+  }
+  switch (param_name) {
+    case CL_QUEUE_CONTEXT:
+      return set_info(command_queue->ctx, param_value_size, param_value,
+                      param_value_size_ret);
+    case CL_QUEUE_DEVICE:
+      return set_info(command_queue->dev, param_value_size, param_value,
+                      param_value_size_ret);
+    case CL_QUEUE_REFERENCE_COUNT:
+      return set_info<cl_uint>(command_queue->references, param_value_size,
+                               param_value, param_value_size_ret);
+    case CL_QUEUE_PROPERTIES:
+      return set_info(command_queue->properties, param_value_size, param_value,
+                      param_value_size_ret);
+    default:
+      return CL_INVALID_VALUE;
+  }
+}
+
+cl_int clFlush(cl_command_queue command_queue) {
+  MOCK_CL_ENTER();
+  return (command_queue == nullptr ? CL_INVALID_COMMAND_QUEUE : CL_SUCCESS);
+}
+
+cl_int clFinish(cl_command_queue command_queue) {
+  MOCK_CL_ENTER();
+  return (command_queue == nullptr ? CL_INVALID_COMMAND_QUEUE : CL_SUCCESS);
+}
+
+// Memory objects
+
+cl_mem clCreateBuffer(cl_context context, cl_mem_flags flags, size_t size,
+                      void* host_ptr, cl_int* errcode_ret) {
+  MOCK_CL_ENTER_CREATE(errcode_ret);
+  if (context == nullptr) {
+    set_error(errcode_ret, CL_INVALID_CONTEXT);
+    return nullptr;
+  }
+  if (size == 0) {
+    set_error(errcode_ret, CL_INVALID_BUFFER_SIZE);
+    return nullptr;
+  }
+  bool needs_host_ptr = (flags & (CL_MEM_USE_HOST_PTR | CL_MEM_COPY_HOST_PTR));
+  if (needs_host_ptr != (host_ptr != nullptr)) {
+    set_error(errcode_ret, CL_INVALID_HOST_PTR);
+    return nullptr;
+  }
+  auto mem = new _cl_mem(context, flags, size, host_ptr);
+  mem->storage = std::make_shared<std::vector<char>>(size);
+  if (host_ptr != nullptr) {
+    std::memcpy(mem->storage->data(), host_ptr, size);
+  }
+  set_error(errcode_ret, CL_SUCCESS);
+  return mem;
+}
+
+cl_mem clCreateSubBuffer(cl_mem buffer, cl_mem_flags flags,
+                         cl_buffer_create_type buffer_create_type,
+                         const void* buffer_create_info, cl_int* errcode_ret) {
+  MOCK_CL_ENTER_CREATE(errcode_ret);
+  if (buffer == nullptr || buffer->parent != nullptr) {
+    set_error(errcode_ret, CL_INVALID_MEM_OBJECT);
+    return nullptr;
+  }
+  auto region = static_cast<const cl_buffer_region*>(buffer_create_info);
+  if (buffer_create_type != CL_BUFFER_CREATE_TYPE_REGION ||
+      region == nullptr || region->size == 0 ||
+      !in_bounds(buffer, region->origin, region->size)) {
+    set_error(errcode_ret, CL_INVALID_VALUE);
+    return nullptr;
+  }
+  if (region->origin % 128 != 0) {
+    set_error(errcode_ret, CL_MISALIGNED_SUB_BUFFER_OFFSET);
+    return nullptr;
+  }
+  auto mem = new _cl_mem(buffer->ctx, (flags == 0 ? buffer->flags : flags),
+                         region->size, nullptr);
+  mem->storage = buffer->storage;
+  mem->offset = buffer->offset + region->origin;
+  mem->parent = buffer;
+  retain(buffer);
+  set_error(errcode_ret, CL_SUCCESS);
+  return mem;
+}
+
+cl_int clRetainMemObject(cl_mem memobj) {
+  MOCK_CL_ENTER();
+  return retain(memobj);
+}
+
+cl_int clReleaseMemObject(cl_mem memobj) {
+  MOCK_CL_ENTER();
+  return release(memobj);
+}
+
+cl_int clGetMemObjectInfo(cl_mem memobj, cl_mem_info param_name,
+                          size_t param_value_size, void* param_value,
+                          size_t* param_value_size_ret) {
+  MOCK_CL_ENTER();
+  if (memobj == nullptr) {
+    return CL_INVALID_MEM_OBJECT;
+  }
+  auto size = param_value_size;
+  auto value = param_value;
+  auto size_ret = param_value_size_ret;
+  switch (param_name) {
+    case CL_MEM_TYPE:
+      return set_info<cl_mem_object_type>(CL_MEM_OBJECT_BUFFER, size, value,
+                                          size_ret);
+    case CL_MEM_FLAGS:
+      return set_info(memobj->flags, size, value, size_ret);
+    case CL_MEM_SIZE:
+      return set_info(memobj->size, size, value, size_ret);
+    case CL_MEM_HOST_PTR:
+      return set_info(memobj->host_ptr, size, value, size_ret);
+    case CL_MEM_MAP_COUNT:
+      return set_info<cl_uint>(0, size, value, size_ret);
+    case CL_MEM_REFERENCE_COUNT:
+      return set_info<cl_uint>(memobj->references, size, value, size_ret);
+    case CL_MEM_CONTEXT:
+      return set_info(memobj->ctx, size, value, size_ret);
+    case CL_MEM_ASSOCIATED_MEMOBJECT:
+      return set_info(memobj->parent, size, value, size_ret);
+    case CL_MEM_OFFSET:
+      return set_info(memobj->offset, size, value, size_ret);
+    default:
+      return CL_INVALID_VALUE;
+  }
+}
+
+cl_int clSetMemObjectDestructorCallback(
+    cl_mem memobj, void(CL_CALLBACK* pfn_notify)(cl_mem, void*),
+    void* user_data) {
+  MOCK_CL_ENTER();
+  return CL_SUCCESS;
+}
+
+// Programs
+
+cl_program clCreateProgramWithSource(cl_context context, cl_uint count,
+                                     const char** strings,
+                                     const size_t* lengths,
+                                     cl_int* errcode_ret) {
+  MOCK_CL_ENTER_CREATE(errcode_ret);
+  if (context == nullptr) {
+    set_error(errcode_ret, CL_INVALID_CONTEXT);
+    return nullptr;
+  }
+  if (count == 0 || strings == nullptr) {
+    set_error(errcode_ret, CL_INVALID_VALUE);
+    return nullptr;
+  }
+  auto prog = new _cl_program(context);
+  for (cl_uint i = 0; i < count; ++i) {
+    if (lengths == nullptr || lengths[i] == 0) {
+      prog->source += strings[i];
+    } else {
+      prog->source.append(strings[i], lengths[i]);
+    }
+  }
+  set_error(errcode_ret, CL_SUCCESS);
+  return prog;
+}
+
+cl_program clCreateProgramWithBinary(cl_context context, cl_uint num_devices,
+                                     const cl_device_id* device_list,
+                                     const size_t* lengths,
+                                     const unsigned char** binaries,
+                                     cl_int* binary_status,
+                                     cl_int* errcode_ret) {
+  MOCK_CL_ENTER_CREATE(errcode_ret);
+  if (context == nullptr) {
+    set_error(errcode_ret, CL_INVALID_CONTEXT);
+    return nullptr;
+  }
+  if (num_devices == 0 || lengths == nullptr || binaries == nullptr ||
+      lengths[0] == 0 || binaries[0] == nullptr) {
+    set_error(errcode_ret, CL_INVALID_VALUE);
+    return nullptr;
+  }
+  // Mock binaries are the program source
+  auto prog = new _cl_program(context);
+  prog->source.assign(reinterpret_cast<const char*>(binaries[0]), lengths[0]);
+  prog->binary_type = CL_PROGRAM_BINARY_TYPE_EXECUTABLE;
+  if (binary_status != nullptr) {
+    for (cl_uint i = 0; i < num_devices; ++i) {
+      binary_status[i] = CL_SUCCESS;
+    }
+  }
+  set_error(errcode_ret, CL_SUCCESS);
+  return prog;
+}
+
+cl_program clCreateProgramWithBuiltInKernels(cl_context context,
+                                             cl_uint num_devices,
+                                             const cl_device_id* device_list,
+                                             const char* kernel_names,
+                                             cl_int* errcode_ret) {
+  MOCK_CL_ENTER_CREATE(errcode_ret);
+  set_error(errcode_ret, CL_INVALID_VALUE);
+  return nullptr;
+}
+
+cl_int clRetainProgram(cl_program program) {
+  MOCK_CL_ENTER();
+  return retain(program);
+}
+
+cl_int clReleaseProgram(cl_program program) {
+  MOCK_CL_ENTER();
+  return release(program);
+}
+
+cl_int clBuildProgram(cl_program program, cl_uint num_devices,
+                      const cl_device_id* device_list, const char* options,
+                      void(CL_CALLBACK* pfn_notify)(cl_program, void*),
+                      void* user_data) {
+  MOCK_CL_ENTER();
+  if (program == nullptr) {
+    return CL_INVALID_PROGRAM;
+  }
+  if (pfn_notify == nullptr && user_data != nullptr) {
+    return CL_INVALID_VALUE;
+  }
+  if (pfn_notify != nullptr && env_number("MOCK_CL_ASYNC_BUILD") != 0) {
+    // Build in the background and return immediately
+    program->status = CL_BUILD_IN_PROGRESS;
+    retain(program);
+    std::string build_options = (options == nullptr ? "" : options);
+    std::thread([=]() {
+      program->build(build_options.c_str());
+      pfn_notify(program, user_data);
+      release(program);
+    }).detach();
+    return CL_SUCCESS;
+  }
+  auto error_code = program->build(options);
+  if (error_code == CL_SUCCESS) {
+    program->binary_type = CL_PROGRAM_BINARY_TYPE_EXECUTABLE;
+  }
+  if (pfn_notify != nullptr) {
+    pfn_notify(program, user_data);
+  }
+  return error_code;
+}
+
+cl_int clCompileProgram(cl_program program, cl_uint num_devices,
+                        const cl_device_id* device_list, const char* options,
+                        cl_uint num_input_headers,
+                        const cl_program* input_headers,
+                        const char** header_include_names,
+                        void(CL_CALLBACK* pfn_notify)(cl_program, void*),
+                        void* user_data) {
+  MOCK_CL_ENTER();
+  if (program == nullptr) {
+    return CL_INVALID_PROGRAM;
+  }
+  auto error_code = program->build(options);
+  if (error_code != CL_SUCCESS) {
+    return CL_COMPILE_PROGRAM_FAILURE;
+  }
+  program->binary_type = CL_PROGRAM_BINARY_TYPE_COMPILED_OBJECT;
+  if (pfn_notify != nullptr) {
+    pfn_notify(program, user_data);
+  }
+  return CL_SUCCESS;
+}
+
+cl_program clLinkProgram(cl_context context, cl_uint num_devices,
+                         const cl_device_id* device_list, const char* options,
+                         cl_uint num_input_programs,
+                         const cl_program* input_programs,
+                         void(CL_CALLBACK* pfn_notify)(cl_program, void*),
+                         void* user_data, cl_int* errcode_ret) {
+  MOCK_CL_ENTER_CREATE(errcode_ret);
+  if (context == nullptr) {
+    set_error(errcode_ret, CL_INVALID_CONTEXT);
+    return nullptr;
+  }
+  if (num_input_programs == 0 || input_programs == nullptr) {
+    set_error(errcode_ret, CL_INVALID_VALUE);
+    return nullptr;
+  }
+  auto prog = new _cl_program(context);
+  for (cl_uint i = 0; i < num_input_programs; ++i) {
+    if (input_programs[i]->status != CL_BUILD_SUCCESS) {
+      release(prog);
+      set_error(errcode_ret, CL_INVALID_PROGRAM);
+      return nullptr;
+    }
+    prog->source += input_programs[i]->source;
+  }
+  prog->build(options);
+  prog->binary_type = CL_PROGRAM_BINARY_TYPE_EXECUTABLE;
+  if (pfn_notify != nullptr) {
+    pfn_notify(prog, user_data);
+  }
+  set_error(errcode_ret, CL_SUCCESS);
+  return prog;
+}
+
+cl_int clUnloadPlatformCompiler(cl_platform_id platform) {
+  MOCK_CL_ENTER();
+  return CL_SUCCESS;
+}
+
+cl_int clGetProgramInfo(cl_program program, cl_program_info param_name,
+                        size_t param_value_size, void* param_value,
+                        size_t* param_value_size_ret) {
+  MOCK_CL_ENTER();
+  if (program == nullptr) {
+    return CL_INVALID_PROGRAM;
+  }
+  auto size = param_value_size;
+  auto value = param_value;
+  auto size_ret = param_value_size_ret;
+  switch (param_name) {
+    case CL_PROGRAM_REFERENCE_COUNT:
+      return set_info<cl_uint>(program->references, size, value, size_ret);
+    case CL_PROGRAM_CONTEXT:
+      return set_info(program->ctx, size, value, size_ret);
+    case CL_PROGRAM_NUM_DEVICES:
+      return set_info<cl_uint>(1, size, value, size_ret);
+    case CL_PROGRAM_DEVICES:
+      return set_info(std::vector<cl_device_id>{&the_device}, size, value,
+                      size_ret);
+    case CL_PROGRAM_SOURCE:
+      return set_info(program->source, size, value, size_ret);
+    case CL_PROGRAM_BINARY_SIZES:
+      return set_info(std::vector<size_t>{program->source.size()}, size, value,
+                      size_ret);
+    case CL_PROGRAM_BINARIES: {
+      if (value != nullptr) {
+        if (size < sizeof(unsigned char*)) {
+          return CL_INVALID_VALUE;
+        }
+        auto binaries = static_cast<unsigned char**>(value);
+        if (binaries[0] != nullptr) {
+          std::memcpy(binaries[0], program->source.data(),
+                      program->source.size());
+        }
+      }
+      if (size_ret != nullptr) {
+        *size_ret = sizeof(unsigned char*);
+      }
+      return CL_SUCCESS;
+    }
+    case CL_PROGRAM_NUM_KERNELS:
+      return set_info<size_t>(program->kernel_names.size(), size, value,
+                              size_ret);
+    case CL_PROGRAM_KERNEL_NAMES: {
+      std::string names;
+      for (auto& name : program->kernel_names) {
+        names += (names.empty() ? "" : ";") + name;
+      }
+      return set_info(names, size, value, size_ret);
+    }
+    default:
+      return CL_INVALID_VALUE;
+  }
+}
+
+cl_int clGetProgramBuildInfo(cl_program program, cl_device_id device,
+                             cl_program_build_info param_name,
+                             size_t param_value_size, void* param_value,
+                             size_t* param_value_size_ret) {
+  MOCK_CL_ENTER();
+  if (program == nullptr) {
+    return CL_INVALID_PROGRAM;
+  }
+  switch (param_name) {
+    case CL_PROGRAM_BUILD_STATUS:
+      return set_info(program->status, param_value_size, param_value,
+                      param_value_size_ret);
+    case CL_PROGRAM_BUILD_OPTIONS:
+      return set_info(program->options, param_value_size, param_value,
+                      param_value_size_ret);
+    case CL_PROGRAM_BUILD_LOG:
+      return set_info(program->log, param_value_size, param_value,
+                      param_value_size_ret);
+    case CL_PROGRAM_BINARY_TYPE:
+      return set_info(program->binary_type, param_value_size, param_value,
+                      param_value_size_ret);
+    default:
+      return CL_INVALID_VALUE;
+  }
+}
+
+// Kernels
+
+cl_kernel clCreateKernel(cl_program program, const char* kernel_name,
+                         cl_int* errcode_ret) {
+  MOCK_CL_ENTER_CREATE(errcode_ret);
+  if (program == nullptr) {
+    set_error(errcode_ret, CL_INVALID_PROGRAM);
+    return nullptr;
+  }
+  if (program->status != CL_BUILD_SUCCESS) {
+    set_error(errcode_ret, CL_INVALID_PROGRAM_EXECUTABLE);
+    return nullptr;
+  }
+  auto& names = program->kernel_names;
+  if (kernel_name == nullptr ||
+      std::find(names.begin(), names.end(), kernel_name) == names.end()) {
+    set_error(errcode_ret, CL_INVALID_KERNEL_NAME);
+    return nullptr;
+  }
+  set_error(errcode_ret, CL_SUCCESS);
+  return new _cl_kernel(program, kernel_name);
+}
+
+cl_int clCreateKernelsInProgram(cl_program program, cl_uint num_kernels,
+                                cl_kernel* kernels, cl_uint* num_kernels_ret) {
+  MOCK_CL_ENTER();
+  if (program == nullptr) {
+    return CL_INVALID_PROGRAM;
+  }
+  auto& names = program->kernel_names;
+  if (kernels != nullptr) {
+    if (num_kernels < names.size()) {
+      return CL_INVALID_VALUE;
+    }
+    for (size_t i = 0; i < names.size(); ++i) {
+      kernels[i] = new _cl_kernel(program, names[i]);
+    }
+  }
+  if (num_kernels_ret != nullptr) {
+    *num_kernels_ret = static_cast<cl_uint>(names.size());
+  }
+  return CL_SUCCESS;
+}
+
+cl_int clRetainKernel(cl_kernel kernel) {
+  MOCK_CL_ENTER();
+  return retain(kernel);
+}
+
+cl_int clReleaseKernel(cl_kernel kernel) {
+  MOCK_CL_ENTER();
+  return release(kernel);
+}
+
+cl_int clSetKernelArg(cl_kernel kernel, cl_uint arg_index, size_t arg_size,
+                      const void* arg_value) {
+  MOCK_CL_ENTER();
+  if (kernel == nullptr) {
+    return CL_INVALID_KERNEL;
+  }
+  if (arg_index >= kernel->args.size()) {
+    return CL_INVALID_ARG_INDEX;
+  }
+  if (arg_size == 0) {
+    return CL_INVALID_ARG_SIZE;
+  }
+  auto& arg = kernel->args[arg_index];
+  if (arg_value == nullptr) {
+    // Local memory
+    arg.assign(1, 0);
+  } else {
+    auto bytes = static_cast<const char*>(arg_value);
+    arg.assign(bytes, bytes + arg_size);
+  }
+  return CL_SUCCESS;
+}
+
+cl_int clGetKernelInfo(cl_kernel kernel, cl_kernel_info param_name,
+                       size_t param_value_size, void* param_value,
+                       size_t* param_value_size_ret) {
+  MOCK_CL_ENTER();
+  if (kernel == nullptr) {
+    return CL_INVALID_KERNEL;
+  }
+  switch (param_name) {
+    case CL_KERNEL_FUNCTION_NAME:
+      return set_info(kernel->name, param_value_size, param_value,
+                      param_value_size_ret);
+    case CL_KERNEL_NUM_ARGS:
+      return set_info<cl_uint>(static_cast<cl_uint>(kernel->args.size()),
+                               param_value_size, param_value,
+                               param_value_size_ret);
+    case CL_KERNEL_REFERENCE_COUNT:
+      return set_info<cl_uint>(kernel->references, param_value_size,
+                               param_value, param_value_size_ret);
+    case CL_KERNEL_CONTEXT:
+      return set_info(kernel->prog->ctx, param_value_size, param_value,
+                      param_value_size_ret);
+    case CL_KERNEL_PROGRAM:
+      return set_info(kernel->prog, param_value_size, param_value,
+                      param_value_size_ret);
+    case CL_KERNEL_ATTRIBUTES:
+      return set_info(std::string(""), param_value_size, param_value,
+                      param_value_size_ret);
+    default:
+      return CL_INVALID_VALUE;
+  }
+}
+
+cl_int clGetKernelWorkGroupInfo(cl_kernel kernel, cl_device_id device,
+                                cl_kernel_work_group_info param_name,
+                                size_t param_value_size, void* param_value,
+                                size_t* param_value_size_ret) {
+  MOCK_CL_ENTER();
+  if (kernel == nullptr) {
+    return CL_INVALID_KERNEL;
+  }
+  switch (param_name) {
+    case CL_KERNEL_WORK_GROUP_SIZE:
+      return set_info<size_t>(1024, param_value_size, param_value,
+                              param_value_size_ret);
+    case CL_KERNEL_COMPILE_WORK_GROUP_SIZE:
+      return set_info(std::vector<size_t>{0, 0, 0}, param_value_size,
+                      param_value, param_value_size_ret);
+    case CL_KERNEL_PREFERRED_WORK_GROUP_SIZE_MULTIPLE:
+      return set_info<size_t>(32, param_value_size, param_value,
+                              param_value_size_ret);
+    case CL_KERNEL_LOCAL_MEM_SIZE:
+    case CL_KERNEL_PRIVATE_MEM_SIZE:
+      return set_info<cl_ulong>(0, param_value_size, param_value,
+                                param_value_size_ret);
+    default:
+      return CL_INVALID_VALUE;
+  }
+}
+
+// Events
+
+cl_int clWaitForEvents(cl_uint num_events, const cl_event* event_list) {
+  MOCK_CL_ENTER();
+  if (num_events == 0 || event_list == nullptr) {
+    return CL_INVALID_VALUE;
+  }
+  for (cl_uint i = 0; i < num_events; ++i) {
+    if (event_list[i] == nullptr) {
+      return CL_INVALID_EVENT;
+    }
+  }
+  return CL_SUCCESS;
+}
+
+cl_int clGetEventInfo(cl_event evnt, cl_event_info param_name,
+                      size_t param_value_size, void* param_value,
+                      size_t* param_value_size_ret) {
+  MOCK_CL_ENTER();
+  if (evnt == nullptr) {
+    return CL_INVALID_EVENT;
+  }
+  switch (param_name) {
+    case CL_EVENT_COMMAND_QUEUE:
+      return set_info(evnt->q, param_value_size, param_value,
+                      param_value_size_ret);
+    case CL_EVENT_CONTEXT:
+      return set_info(evnt->ctx, param_value_size, param_value,
+                      param_value_size_ret);
+    case CL_EVENT_COMMAND_TYPE:
+      return set_info(evnt->type, param_value_size, param_value,
+                      param_value_size_ret);
+    case CL_EVENT_COMMAND_EXECUTION_STATUS:
+      return set_info(evnt->status, param_value_size, param_value,
+                      param_value_size_ret);
+    case CL_EVENT_REFERENCE_COUNT:
+      return set_info<cl_uint>(evnt->references, param_value_size, param_value,
+                               param_value_size_ret);
+    default:
+      return CL_INVALID_VALUE;
+  }
+}
+
+cl_event clCreateUserEvent(cl_context context, cl_int* errcode_ret) {
+  MOCK_CL_ENTER_CREATE(errcode_ret);
+  if (context == nullptr) {
+    set_error(errcode_ret, CL_INVALID_CONTEXT);
+    return nullptr;
+  }
+  set_error(errcode_ret, CL_SUCCESS);
+  return new _cl_event(context, nullptr, CL_COMMAND_USER, CL_SUBMITTED);
+}
+
+cl_int clRetainEvent(cl_event evnt) {
+  MOCK_CL_ENTER();
+  return retain(evnt);
+}
+
+cl_int clReleaseEvent(cl_event evnt) {
+  MOCK_CL_ENTER();
+  return release(evnt);
+}
+
+cl_int clSetUserEventStatus(cl_event evnt, cl_int execution_status) {
+  MOCK_CL_ENTER();
+  if (evnt == nullptr || evnt->type != CL_COMMAND_USER) {
+    return CL_INVALID_EVENT;
+  }
+  evnt->status = execution_status;
+  evnt->end = now();
+  return CL_SUCCESS;
+}
+
+cl_int clSetEventCallback(cl_event evnt, cl_int command_exec_callback_type,
+                          void(CL_CALLBACK* pfn_notify)(cl_event, cl_int,
+                                                        void*),
+                          void* user_data) {
+  MOCK_CL_ENTER();
+  if (evnt == nullptr) {
+    return CL_INVALID_EVENT;
+  }
+  if (pfn_notify == nullptr) {
+    return CL_INVALID_VALUE;
+  }
+  // All commands are complete once enqueued
+  pfn_notify(evnt, evnt->status, user_data);
+  return CL_SUCCESS;
+}
+
+cl_int clGetEventProfilingInfo(cl_event evnt, cl_profiling_info param_name,
+                               size_t param_value_size, void* param_value,
+                               size_t* param_value_size_ret) {
+  MOCK_CL_ENTER();
+  if (evnt == nullptr) {
+    return CL_INVALID_EVENT;
+  }
+  if (evnt->q == nullptr ||
+      (evnt->q->properties & CL_QUEUE_PROFILING_ENABLE) == 0) {
+    return CL_PROFILING_INFO_NOT_AVAILABLE;
+  }
+  switch (param_name) {
+    case CL_PROFILING_COMMAND_QUEUED:
+      return set_info(evnt->queued, param_value_size, param_value,
+                      param_value_size_ret);
+    case CL_PROFILING_COMMAND_SUBMIT:
+      return set_info(evnt->submit, param_value_size, param_value,
+                      param_value_size_ret);
+    case CL_PROFILING_COMMAND_START:
+      return set_info(evnt->start, param_value_size, param_value,
+                      param_value_size_ret);
+    case CL_PROFILING_COMMAND_END:
+      return set_info(evnt->end, param_value_size, param_value,
+                      param_value_size_ret);
+    default:
+      return CL_INVALID_VALUE;
+  }
+}
+
+// Enqueued commands
+
+cl_int clEnqueueReadBuffer(cl_command_queue command_queue, cl_mem buffer,
+                           cl_bool blocking_read, size_t offset, size_t size,
+                           void* ptr, cl_uint num_events_in_wait_list,
+                           const cl_event* event_wait_list, cl_event* evnt) {
+  MOCK_CL_ENTER();
+  auto start = now();
+  if (!in_bounds(buffer, offset, size) || ptr == nullptr) {
+    return CL_INVALID_VALUE;
+  }
+  std::memcpy(ptr, buffer->data() + offset, size);
+  return complete(command_queue, CL_COMMAND_READ_BUFFER, start,
+                  num_events_in_wait_list, event_wait_list, evnt);
+}
+
+cl_int clEnqueueWriteBuffer(cl_command_queue command_queue, cl_mem buffer,
+                            cl_bool blocking_write, size_t offset, size_t size,
+                            const void* ptr, cl_uint num_events_in_wait_list,
+                            const cl_event* event_wait_list, cl_event* evnt) {
+  MOCK_CL_ENTER();
+  auto start = now();
+  if (!in_bounds(buffer, offset, size) || ptr == nullptr) {
+    return CL_INVALID_VALUE;
+  }
+  std::memcpy(buffer->data() + offset, ptr, size);
+  return complete(command_queue, CL_COMMAND_WRITE_BUFFER, start,
+                  num_events_in_wait_list, event_wait_list, evnt);
+}
+
+cl_int clEnqueueReadBufferRect(
+    cl_command_queue command_queue, cl_mem buffer, cl_bool blocking_read,
+    const size_t* buffer_origin, const size_t* host_origin,
+    const size_t* region, size_t buffer_row_pitch, size_t buffer_slice_pitch,
+    size_t host_row_pitch, size_t host_slice_pitch, void* ptr,
+    cl_uint num_events_in_wait_list, const cl_event* event_wait_list,
+    cl_event* evnt) {
+  MOCK_CL_ENTER();
+  auto start = now();
+  if (buffer == nullptr || ptr == nullptr) {
+    return CL_INVALID_VALUE;
+  }
+  auto dst = static_cast<char*>(ptr);
+  auto src = buffer->data();
+  for_each_row(host_origin, buffer_origin, region, host_row_pitch,
+               host_slice_pitch, buffer_row_pitch, buffer_slice_pitch,
+               [=](size_t to, size_t from, size_t row) {
+                 std::memcpy(dst + to, src + from, row);
+               });
+  return complete(command_queue, CL_COMMAND_READ_BUFFER_RECT, start,
+                  num_events_in_wait_list, event_wait_list, evnt);
+}
+
+cl_int clEnqueueWriteBufferRect(
+    cl_command_queue command_queue, cl_mem buffer, cl_bool blocking_write,
+    const size_t* buffer_origin, const size_t* host_origin,
+    const size_t* region, size_t buffer_row_pitch, size_t buffer_slice_pitch,
+    size_t host_row_pitch, size_t host_slice_pitch, const void* ptr,
+    cl_uint num_events_in_wait_list, const cl_event* event_wait_list,
+    cl_event* evnt) {
+  MOCK_CL_ENTER();
+  auto start = now();
+  if (buffer == nullptr || ptr == nullptr) {
+    return CL_INVALID_VALUE;
+  }
+  auto dst = buffer->data();
+  auto src = static_cast<const char*>(ptr);
+  for_each_row(buffer_origin, host_origin, region, buffer_row_pitch,
+               buffer_slice_pitch, host_row_pitch, host_slice_pitch,
+               [=](size_t to, size_t from, size_t row) {
+                 std::memcpy(dst + to, src + from, row);
+               });
+  return complete(command_queue, CL_COMMAND_WRITE_BUFFER_RECT, start,
+                  num_events_in_wait_list, event_wait_list, evnt);
+}
+
+cl_int clEnqueueFillBuffer(cl_command_queue command_queue, cl_mem buffer,
+                           const void* pattern, size_t pattern_size,
+                           size_t offset, size_t size,
+                           cl_uint num_events_in_wait_list,
+                           const cl_event* event_wait_list, cl_event* evnt) {
+  MOCK_CL_ENTER();
+  auto start = now();
+  if (!in_bounds(buffer, offset, size) || pattern == nullptr ||
+      pattern_size == 0 || size % pattern_size != 0 ||
+      offset % pattern_size != 0) {
+    return CL_INVALID_VALUE;
+  }
+  auto dst = buffer->data() + offset;
+  for (size_t i = 0; i < size; i += pattern_size) {
+    std::memcpy(dst + i, pattern, pattern_size);
+  }
+  return complete(command_queue, CL_COMMAND_FILL_BUFFER, start,
+                  num_events_in_wait_list, event_wait_list, evnt);
+}
+
+cl_int clEnqueueCopyBuffer(cl_command_queue command_queue, cl_mem src_buffer,
+                           cl_mem dst_buffer, size_t src_offset,
+                           size_t dst_offset, size_t size,
+                           cl_uint num_events_in_wait_list,
+                           const cl_event* event_wait_list, cl_event* evnt) {
+  MOCK_CL_ENTER();
+  auto start = now();
+  if (!in_bounds(src_buffer, src_offset, size) ||
+      !in_bounds(dst_buffer, dst_offset, size)) {
+    return CL_INVALID_VALUE;
+  }
+  std::memmove(dst_buffer->data() + dst_offset,
+               src_buffer->data() + src_offset, size);
+  return complete(command_queue, CL_COMMAND_COPY_BUFFER, start,
+                  num_events_in_wait_list, event_wait_list, evnt);
+}
+
+cl_int clEnqueueCopyBufferRect(
+    cl_command_queue command_queue, cl_mem src_buffer, cl_mem dst_buffer,
+    const size_t* src_origin, const size_t* dst_origin, const size_t* region,
+    size_t src_row_pitch, size_t src_slice_pitch, size_t dst_row_pitch,
+    size_t dst_slice_pitch, cl_uint num_events_in_wait_list,
+    const cl_event* event_wait_list, cl_event* evnt) {
+  MOCK_CL_ENTER();
+  auto start = now();
+  if (src_buffer == nullptr || dst_buffer == nullptr) {
+    return CL_INVALID_MEM_OBJECT;
+  }
+  auto dst = dst_buffer->data();
+  auto src = src_buffer->data();
+  for_each_row(dst_origin, src_origin, region, dst_row_pitch, dst_slice_pitch,
+               src_row_pitch, src_slice_pitch,
+               [=](size_t to, size_t from, size_t row) {
+                 std::memmove(dst + to, src + from, row);
+               });
+  return complete(command_queue, CL_COMMAND_COPY_BUFFER_RECT, start,
+                  num_events_in_wait_list, event_wait_list, evnt);
+}
+
+void* clEnqueueMapBuffer(cl_command_queue command_queue, cl_mem buffer,
+                         cl_bool blocking_map, cl_map_flags map_flags,
+                         size_t offset, size_t size,
+                         cl_uint num_events_in_wait_list,
+                         const cl_event* event_wait_list, cl_event* evnt,
+                         cl_int* errcode_ret) {
+  MOCK_CL_ENTER_CREATE(errcode_ret);
+  auto start = now();
+  if (!in_bounds(buffer, offset, size)) {
+    set_error(errcode_ret, CL_INVALID_VALUE);
+    return nullptr;
+  }
+  auto error_code = complete(command_queue, CL_COMMAND_MAP_BUFFER, start,
+                             num_events_in_wait_list, event_wait_list, evnt);
+  set_error(errcode_ret, error_code);
+  return (error_code == CL_SUCCESS ? buffer->data() + offset : nullptr);
+}
+
+cl_int clEnqueueUnmapMemObject(cl_command_queue command_queue, cl_mem memobj,
+                               void* mapped_ptr,
+                               cl_uint num_events_in_wait_list,
+                               const cl_event* event_wait_list,
+                               cl_event* evnt) {
+  MOCK_CL_ENTER();
+  auto start = now();
+  if (memobj == nullptr) {
+    return CL_INVALID_MEM_OBJECT;
+  }
+  return complete(command_queue, CL_COMMAND_UNMAP_MEM_OBJECT, start,
+                  num_events_in_wait_list, event_wait_list, evnt);
+}
+
+cl_int clEnqueueMigrateMemObjects(cl_command_queue command_queue,
+                                  cl_uint num_mem_objects,
+                                  const cl_mem* mem_objects,
+                                  cl_mem_migration_flags flags,
+                                  cl_uint num_events_in_wait_list,
+                                  const cl_event* event_wait_list,
+                                  cl_event* evnt) {
+  MOCK_CL_ENTER();
+  return complete(command_queue, CL_COMMAND_MIGRATE_MEM_OBJECTS, now(),
+                  num_events_in_wait_list, event_wait_list, evnt);
+}
+
+cl_int clEnqueueNDRangeKernel(cl_command_queue command_queue, cl_kernel kernel,
+                              cl_uint work_dim,
+                              const size_t* global_work_offset,
+                              const size_t* global_work_size,
+                              const size_t* local_work_size,
+                              cl_uint num_events_in_wait_list,
+                              const cl_event* event_wait_list,
+                              cl_event* evnt) {
+  MOCK_CL_ENTER();
+  auto start = now();
+  if (kernel == nullptr) {
+    return CL_INVALID_KERNEL;
+  }
+  if (work_dim < 1 || work_dim > 3) {
+    return CL_INVALID_WORK_DIMENSION;
+  }
+  if (global_work_size == nullptr) {
+    return CL_INVALID_GLOBAL_WORK_SIZE;
+  }
+  for (cl_uint i = 0; i < work_dim; ++i) {
+    if (global_work_size[i] == 0) {
+      return CL_INVALID_GLOBAL_WORK_SIZE;
+    }
+    if (local_work_size != nullptr &&
+        (local_work_size[i] == 0 ||
+         global_work_size[i] % local_work_size[i] != 0)) {
+      return CL_INVALID_WORK_GROUP_SIZE;
+    }
+  }
+  for (auto& arg : kernel->args) {
+    if (arg.empty()) {
+      return CL_INVALID_KERNEL_ARGS;
+    }
+  }
+  ++kernel_launches;
+  return complete(command_queue, CL_COMMAND_NDRANGE_KERNEL, start,
+                  num_events_in_wait_list, event_wait_list, evnt);
+}
+
+cl_int clEnqueueTask(cl_command_queue command_queue, cl_kernel kernel,
+                     cl_uint num_events_in_wait_list,
+                     const cl_event* event_wait_list, cl_event* evnt) {
+  MOCK_CL_ENTER();
+  auto start = now();
+  if (kernel == nullptr) {
+    return CL_INVALID_KERNEL;
+  }
+  for (auto& arg : kernel->args) {
+    if (arg.empty()) {
+      return CL_INVALID_KERNEL_ARGS;
+    }
+  }
+  ++kernel_launches;
+  return complete(command_queue, CL_COMMAND_TASK, start,
+                  num_events_in_wait_list, event_wait_list, evnt);
+}
+
+cl_int clEnqueueMarkerWithWaitList(cl_command_queue command_queue,
+                                   cl_uint num_events_in_wait_list,
+                                   const cl_event* event_wait_list,
+                                   cl_event* evnt) {
+  MOCK_CL_ENTER();
+  return complete(command_queue, CL_COMMAND_MARKER, now(),
+                  num_events_in_wait_list, event_wait_list, evnt);
+}
+
+cl_int clEnqueueBarrierWithWaitList(cl_command_queue command_queue,
+                                    cl_uint num_events_in_wait_list,
+                                    const cl_event* event_wait_list,
+                                    cl_event* evnt) {
+  MOCK_CL_ENTER();
+  return complete(command_queue, CL_COMMAND_BARRIER, now(),
+                  num_events_in_wait_list, event_wait_list, evnt);
+}
+
+void* clGetExtensionFunctionAddressForPlatform(cl_platform_id platform,
+                                               const char* func_name) {
+  return nullptr;
+}
+
+}  // extern "C"
@@ -0,0 +1,30 @@
+#pragma once
+
+// Control interface of the mock OpenCL library.
+// Builds are delayed by MOCK_CL_BUILD_DELAY_MS milliseconds
+// and run on a separate thread if MOCK_CL_ASYNC_BUILD is set
+// and clBuildProgram is given a callback.
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Makes the OpenCL function fail with error_code,
+// after it succeeded skip_calls times, for fail_calls calls.
+// Faults can also be set up with the MOCK_CL_INJECT environment variable,
+// as a list of function:error_code[:skip_calls[:fail_calls]] entries.
+void mock_cl_inject(const char* function, int error_code,
+                    unsigned int skip_calls, unsigned int fail_calls);
+
+// Removes all faults and resets the counters
+void mock_cl_reset();
+
+// Number of times the OpenCL function was called
+unsigned long mock_cl_calls(const char* function);
+
+// Number of kernels enqueued, they are never executed
+unsigned long mock_cl_kernel_launches();
+
+#ifdef __cplusplus
+}
+#endif
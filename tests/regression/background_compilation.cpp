@@ -0,0 +1,109 @@
+#include "../common.h"
+
+#include <thread>
+#include <vector>
+
+// Kernels are built on a background thread pool
+// and cached by context, devices, options and source.
+// Warming up a kernel builds the program the submit uses,
+// and concurrent builds of the same kernel share one cache entry.
+
+using namespace cl::sycl;
+
+// Functors need a public default constructor to be built by name
+class warmed_up {
+ public:
+  void operator()(id<1> i) {
+    int1 x = i[0];
+    x += 1;
+  }
+};
+
+class shared_build {
+ public:
+  void operator()(id<1> i) {
+    int1 x = i[0];
+    x *= 2;
+  }
+};
+
+static bool check(const char* name, ::cl_ulong value, ::cl_ulong expected) {
+  debug() << name << value;
+  if (value != expected) {
+    debug() << "Expected" << expected;
+    return false;
+  }
+  return true;
+}
+
+static int warm_up() {
+  context ctx;
+  ctx.reset_counters();
+  int result = 0;
+
+  queue myQueue(ctx, ctx.get_devices()[0]);
+  program prog(ctx);
+  prog.build_from_kernel_name_async<warmed_up>();
+
+  // Traced again, the build started above is reused
+  myQueue.submit([&](handler& cgh) {
+    cgh.parallel_for(range<1>(16), warmed_up());
+  });
+  myQueue.wait();
+
+  if (!check("program_cache_misses",
+             ctx.get_counter<info::counter::program_cache_misses>(), 1) ||
+      !check("program_cache_hits",
+             ctx.get_counter<info::counter::program_cache_hits>(), 1) ||
+      !check("kernel_launches",
+             ctx.get_counter<info::counter::kernel_launches>(), 1)) {
+    result = 1;
+  }
+  return result;
+}
+
+static int concurrent_builds() {
+  const int num_threads = 8;
+  context ctx;
+  ctx.reset_counters();
+  int result = 0;
+
+  std::vector<cl_kernel> kernels(num_threads, nullptr);
+  std::vector<std::thread> threads;
+  threads.reserve(num_threads);
+  for (int t = 0; t < num_threads; ++t) {
+    threads.emplace_back([&, t]() {
+      program prog(ctx);
+      prog.build_from_kernel_name_async<shared_build>();
+      kernels[t] = prog.get_kernel<shared_build>().get();
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  if (!check("program_cache_misses",
+             ctx.get_counter<info::counter::program_cache_misses>(), 1) ||
+      !check("program_cache_hits",
+             ctx.get_counter<info::counter::program_cache_hits>(),
+             num_threads - 1) ||
+      !check("programs_compiled",
+             ctx.get_counter<info::counter::programs_compiled>(), 1)) {
+    result = 1;
+  }
+  for (auto k : kernels) {
+    if (k == nullptr || k != kernels[0]) {
+      debug() << "The threads did not share one kernel object";
+      result = 1;
+      break;
+    }
+  }
+  return result;
+}
+
+int main() {
+  int result = 0;
+  result += warm_up();
+  result += concurrent_builds();
+  return result;
+}
@@ -0,0 +1,102 @@
+#include "../common.h"
+
+// A kernel that fails to compile drops its command group.
+// The build error is thrown by the next submit or wait,
+// or passed to the async handler if the queue is destroyed first.
+// It never escapes a destructor.
+
+using namespace cl::sycl;
+
+static const int size = 16;
+
+// Generates code that is not valid OpenCL C
+template <class name>
+static void submit_broken(queue& q, buffer<int>& buf, const char* code) {
+  q.submit([&](handler& cgh) {
+    auto d = buf.get_access<access::mode::read_write>(cgh);
+    cgh.parallel_for<name>(range<1>(size), [=](id<1> i) {
+      d[i] = 2;
+      detail::kernel_add(code);
+    });
+  });
+}
+
+static bool is_build_error(const cl_exception& e) {
+  debug() << "Build error:" << e.what();
+  return e.get_cl_code() == CL_BUILD_PROGRAM_FAILURE;
+}
+
+int main() {
+  std::vector<int> data(size, 1);
+  int result = 0;
+
+  {
+    queue myQueue;
+    buffer<int> buf(data.data(), size);
+
+    submit_broken<class broken>(myQueue, buf, "undeclared_variable = 1");
+    bool thrown = false;
+    try {
+      myQueue.wait();
+    } catch (cl_exception& e) {
+      thrown = is_build_error(e);
+    }
+    if (!thrown) {
+      debug() << "wait did not throw the build error";
+      result = 1;
+    }
+
+    // The failed build is cached, so the next submit reports it
+    thrown = false;
+    try {
+      submit_broken<class broken>(myQueue, buf, "undeclared_variable = 1");
+    } catch (cl_exception& e) {
+      thrown = is_build_error(e);
+    }
+    if (!thrown) {
+      debug() << "submit did not throw the cached build error";
+      result = 1;
+    }
+
+    // Errors are only reported once
+    try {
+      myQueue.wait();
+    } catch (cl_exception&) {
+      debug() << "The build error was reported twice";
+      result = 1;
+    }
+  }
+
+  for (int i = 0; i < size; ++i) {
+    if (data[i] != 1) {
+      debug() << "A dropped command group changed index" << i;
+      result = 1;
+      break;
+    }
+  }
+
+  int reported = 0;
+  {
+    async_handler count_errors = [&](exception_list list) {
+      reported += static_cast<int>(list.size());
+    };
+    queue myQueue(count_errors);
+    buffer<int> buf(data.data(), size);
+    // Thrown here only if the build failed before the submit returned,
+    // otherwise the queue destructor reports it
+    try {
+      submit_broken<class broken_destroyed>(myQueue, buf,
+                                            "another_undeclared_variable = 1");
+    } catch (cl_exception& e) {
+      if (is_build_error(e)) {
+        ++reported;
+      }
+    }
+  }
+  if (reported != 1) {
+    debug() << "Expected one build error, got" << reported;
+    result = 1;
+  }
+
+  return result;
+}
@@ -0,0 +1,125 @@
+#include "../common.h"
+
+#include <vector>
+
+// Tracing a kernel again produces byte-identical source,
+// named _sycl_kernel_ followed by the hash of the source,
+// so it is found in the program cache.
+// Arguments are numbered in the order of first use,
+// which doesn't change when the buffers of the kernel are swapped.
+
+using namespace cl::sycl;
+
+// Different types with the same body
+class first_functor {
+ public:
+  void operator()(id<1> i) {
+    int1 x = i[0];
+    x += 5;
+  }
+};
+
+class second_functor {
+ public:
+  void operator()(id<1> i) {
+    int1 x = i[0];
+    x += 5;
+  }
+};
+
+static const int size = 64;
+
+template <class name>
+static void add(queue& q, buffer<int>& a, buffer<int>& b, buffer<int>& c) {
+  q.submit([&](handler& cgh) {
+    auto first = a.get_access<access::mode::read>(cgh);
+    auto second = b.get_access<access::mode::read>(cgh);
+    auto out = c.get_access<access::mode::discard_write>(cgh);
+    cgh.parallel_for<name>(range<1>(size), [=](id<1> i) {
+      out[i] = first[i] * 2 + second[i];
+    });
+  });
+}
+
+static bool check(const char* name, ::cl_ulong value, ::cl_ulong expected) {
+  debug() << name << value;
+  if (value != expected) {
+    debug() << "Expected" << expected;
+    return false;
+  }
+  return true;
+}
+
+static int kernel_names() {
+  context ctx;
+  ctx.reset_counters();
+  int result = 0;
+
+  program first(ctx);
+  first.build_from_kernel_name_async<first_functor>();
+  auto first_name = first.get_kernel<first_functor>().get_function_name();
+
+  program second(ctx);
+  second.build_from_kernel_name_async<second_functor>();
+  auto second_name = second.get_kernel<second_functor>().get_function_name();
+
+  // Drops the terminating null of the info strings
+  first_name = first_name.c_str();
+  second_name = second_name.c_str();
+  debug() << "Kernel names" << first_name << second_name;
+
+  const string_class root = "_sycl_kernel_";
+  if (first_name != second_name || first_name.size() != root.size() + 16 ||
+      first_name.compare(0, root.size(), root) != 0) {
+    debug() << "Expected the same name derived from the source";
+    result = 1;
+  }
+  if (!check("program_cache_misses",
+             ctx.get_counter<info::counter::program_cache_misses>(), 1)) {
+    result = 1;
+  }
+  return result;
+}
+
+static int argument_order() {
+  context ctx;
+  ctx.reset_counters();
+  int result = 0;
+
+  std::vector<int> x(size, 1);
+  std::vector<int> y(size, 10);
+  std::vector<int> xy(size, 0);
+  std::vector<int> yx(size, 0);
+  {
+    queue myQueue(ctx, ctx.get_devices()[0]);
+    buffer<int> bx(x.data(), size);
+    buffer<int> by(y.data(), size);
+    buffer<int> bxy(xy.data(), size);
+    buffer<int> byx(yx.data(), size);
+
+    // The buffers are used first in a different order,
+    // the arguments are still numbered the same way
+    add<class canonical_add>(myQueue, bx, by, bxy);
+    add<class canonical_add>(myQueue, by, bx, byx);
+    myQueue.wait();
+  }
+
+  if (!check("program_cache_misses",
+             ctx.get_counter<info::counter::program_cache_misses>(), 1) ||
+      !check("program_cache_hits",
+             ctx.get_counter<info::counter::program_cache_hits>(), 1)) {
+    result = 1;
+  }
+  if (xy[0] != 12 || yx[0] != 21) {
+    debug() << "Wrong results" << xy[0] << yx[0];
+    result = 1;
+  }
+  return result;
+}
+
+int main() {
+  int result = 0;
+  result += kernel_names();
+  result += argument_order();
+  return result;
+}
@@ -0,0 +1,62 @@
+#include "../common.h"
+
+#include <thread>
+#include <vector>
+
+// Stress test for submitting command groups from many host threads.
+// All threads share one queue and one read-only input buffer,
+// each thread writes to its own output buffer.
+
+int main() {
+  using namespace cl::sycl;
+
+  const int num_threads = 8;
+  const int submits_per_thread = 16;
+  const int size = 1024;
+
+  std::vector<int> input(size);
+  for (int i = 0; i < size; ++i) {
+    input[i] = i;
+  }
+  std::vector<std::vector<int>> outputs(num_threads, std::vector<int>(size, 0));
+
+  {
+    queue myQueue;
+    buffer<int> in(input.data(), size);
+
+    std::vector<std::thread> threads;
+    threads.reserve(num_threads);
+
+    for (int t = 0; t < num_threads; ++t) {
+      threads.emplace_back([&, t]() {
+        buffer<int> out(outputs[t].data(), size);
+        for (int s = 0; s < submits_per_thread; ++s) {
+          myQueue.submit([&](handler& cgh) {
+            auto i = in.get_access<access::mode::read>(cgh);
+            auto o = out.get_access<access::mode::read_write>(cgh);
+
+            cgh.parallel_for<class concurrent_add>(
+                range<1>(size), [=](id<1> index) { o[index] += i[index]; });
+          });
+        }
+      });
+    }
+
+    for (auto& thread : threads) {
+      thread.join();
+    }
+  }
+
+  for (int t = 0; t < num_threads; ++t) {
+    for (int i = 0; i < size; ++i) {
+      auto expected = input[i] * submits_per_thread;
+      if (outputs[t][i] != expected) {
+        debug() << "thread" << t << "index" << i << "expected" << expected
+                << "got" << outputs[t][i];
+        return 1;
+      }
+    }
+  }
+
+  return 0;
+}
@@ -0,0 +1,80 @@
+#include "extracted_kernels.h"
+
+// Reads a small coefficient table, which fits in constant memory,
+// together with an input too large for it.
+// The kernel is extracted to check that the table is declared __constant
+// and the input stays __global.
+
+using namespace cl::sycl;
+
+static const char* kernel_dir = "constant_promotion_kernels";
+
+int main() {
+  const int num_coefficients = 4;
+  const int size = 1 << 20;
+  int result = 0;
+
+  vector_class<float> coefficients = {0.5f, 1.0f, 2.0f, 4.0f};
+  vector_class<int> input(size);
+  vector_class<float> output(size, 0.0f);
+  for (int i = 0; i < size; ++i) {
+    input[i] = i % 1000;
+  }
+
+  // Left over from an earlier run
+  take_extracted_kernels(kernel_dir);
+  detail::kernel_store::extract_to(kernel_dir);
+
+  ::cl_ulong max_constant_size;
+  {
+    queue myQueue;
+    max_constant_size = myQueue.get_device()
+                            .get_info<info::device::max_constant_buffer_size>();
+    buffer<float> c(coefficients.data(), range<1>(num_coefficients));
+    buffer<int> in(input.data(), range<1>(size));
+    buffer<float> out(output.data(), range<1>(size));
+
+    myQueue.submit([&](handler& cgh) {
+      auto coef = c.get_access<access::mode::read>(cgh);
+      auto data = in.get_access<access::mode::read>(cgh);
+      auto res = out.get_access<access::mode::discard_write>(cgh);
+      cgh.parallel_for<class constant_promotion>(
+          range<1>(size), [=](id<1> i) {
+            res[i] = data[i] * coef[i % num_coefficients];
+          });
+    });
+  }
+
+  detail::kernel_store::extract_to("");
+  auto kernels = take_extracted_kernels(kernel_dir);
+  if (kernels.size() != 1) {
+    debug() << "Expected one extracted kernel, got" << kernels.size();
+    result = 1;
+  } else {
+    auto signature = kernel_signature(kernels[0]);
+    debug() << signature;
+    if (signature.find("__constant const float*") == string_class::npos) {
+      debug() << "The coefficient table is not in constant memory";
+      result = 1;
+    }
+    // Only too large for devices with less constant memory than the input
+    if (max_constant_size < size * sizeof(int) &&
+        signature.find("__global const int*") == string_class::npos) {
+      debug() << "The input does not fit in constant memory,"
+              << "but is not __global";
+      result = 1;
+    }
+  }
+
+  for (int i = 0; i < size; ++i) {
+    auto expected = input[i] * coefficients[i % num_coefficients];
+    if (output[i] != expected) {
+      debug() << "Element" << i << "is" << output[i] << "instead of"
+              << expected;
+      result = 1;
+      break;
+    }
+  }
+
+  return result;
+}
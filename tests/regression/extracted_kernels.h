@@ -0,0 +1,75 @@
+#pragma once
+
+#include "../common.h"
+#include <SYCL/detail/kernel_store.h>
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+#ifdef _WIN32
+#include <direct.h>
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <dirent.h>
+#include <sys/stat.h>
+#endif
+
+// Tests that check the generated code extract their kernels
+// with kernel_store::extract_to and read them back from the directory.
+
+// Reads and removes the kernels extracted to the directory,
+// which is created if it doesn't exist
+inline cl::sycl::vector_class<cl::sycl::string_class> take_extracted_kernels(
+    const char* dir) {
+  using cl::sycl::string_class;
+
+  cl::sycl::vector_class<string_class> names;
+#ifdef _WIN32
+  _mkdir(dir);
+  WIN32_FIND_DATAA data;
+  auto find = FindFirstFileA((string_class(dir) + "\\*.cl").c_str(), &data);
+  if (find != INVALID_HANDLE_VALUE) {
+    do {
+      names.push_back(data.cFileName);
+    } while (FindNextFileA(find, &data));
+    FindClose(find);
+  }
+#else
+  mkdir(dir, 0755);
+  auto d = opendir(dir);
+  if (d != nullptr) {
+    while (auto entry = readdir(d)) {
+      string_class name = entry->d_name;
+      if (name.size() > 3 && name.compare(name.size() - 3, 3, ".cl") == 0) {
+        names.push_back(name);
+      }
+    }
+    closedir(d);
+  }
+#endif
+
+  cl::sycl::vector_class<string_class> kernels;
+  for (auto& name : names) {
+    auto path = string_class(dir) + "/" + name;
+    {
+      std::ifstream file(path);
+      std::stringstream code;
+      code << file.rdbuf();
+      kernels.push_back(code.str());
+    }
+    std::remove(path.c_str());
+  }
+  return kernels;
+}
+
+// Arguments of the kernel function in the source
+inline cl::sycl::string_class kernel_signature(
+    const cl::sycl::string_class& code) {
+  auto begin = code.find("__kernel");
+  if (begin == cl::sycl::string_class::npos) {
+    return "";
+  }
+  return code.substr(begin, code.find(')', begin) - begin);
+}
@@ -0,0 +1,103 @@
+#include "../common.h"
+
+// Fills and copies buffers on the device, without kernels.
+// A copy source is uploaded again only after its host memory changed.
+
+int main() {
+  using namespace cl::sycl;
+
+  const int size = 1024;
+  int result = 0;
+
+  vector_class<int> filled(size, 0);
+  vector_class<int> copied(size, 0);
+  vector_class<float> small(4 * 3);
+  vector_class<float> large(6 * 5, -1.0f);
+  for (int i = 0; i < 4 * 3; ++i) {
+    small[i] = static_cast<float>(i);
+  }
+
+  {
+    queue myQueue;
+    buffer<int> a(filled.data(), range<1>(size));
+    buffer<int> b(copied.data(), range<1>(size));
+    buffer<float, 2> s(small.data(), range<2>(4, 3));
+    buffer<float, 2> l(large.data(), range<2>(6, 5));
+
+    // The copy has to see the filled data, not the host data
+    myQueue.submit([&](handler& cgh) {
+      auto src = a.get_access<access::mode::read_write>(cgh);
+      auto dest = b.get_access<access::mode::discard_write>(cgh);
+      cgh.fill(src, 7);
+      cgh.copy(src, dest);
+    });
+
+    myQueue.submit([&](handler& cgh) {
+      auto src = s.get_access<access::mode::read>(cgh);
+      auto dest = l.get_access<access::mode::write>(cgh);
+      cgh.copy(src, dest);
+    });
+  }
+
+  for (int i = 0; i < size; ++i) {
+    if (filled[i] != 7 || copied[i] != 7) {
+      debug() << "Element" << i << "is" << filled[i] << "and" << copied[i]
+              << "instead of 7";
+      result = 1;
+      break;
+    }
+  }
+
+  for (int y = 0; y < 5; ++y) {
+    for (int x = 0; x < 6; ++x) {
+      auto expected =
+          (x < 4 && y < 3) ? static_cast<float>(y * 4 + x) : -1.0f;
+      if (large[y * 6 + x] != expected) {
+        debug() << "Element" << x << y << "is" << large[y * 6 + x]
+                << "instead of" << expected;
+        return 1;
+      }
+    }
+  }
+
+  vector_class<int> source(size, 3);
+  vector_class<int> first(size, 0);
+  vector_class<int> second(size, 0);
+  context ctx;
+  {
+    queue myQueue(ctx, ctx.get_devices()[0]);
+    buffer<int> src(source.data(), range<1>(size));
+    buffer<int> d1(first.data(), range<1>(size));
+    buffer<int> d2(second.data(), range<1>(size));
+
+    auto copy_to = [&](buffer<int>& dest) {
+      myQueue.submit([&](handler& cgh) {
+        auto from = src.get_access<access::mode::read>(cgh);
+        auto to = dest.get_access<access::mode::discard_write>(cgh);
+        cgh.copy(from, to);
+      });
+    };
+    copy_to(d1);
+    copy_to(d2);
+    {
+      auto host = src.get_access<access::mode::write,
+                                 access::target::host_buffer>();
+      host[0] = 5;
+    }
+    copy_to(d2);
+  }
+
+  auto uploaded = ctx.get_counter<info::counter::bytes_uploaded>();
+  if (uploaded != 2 * size * sizeof(int)) {
+    debug() << "Uploaded" << uploaded << "bytes instead of"
+            << 2 * size * sizeof(int);
+    result = 1;
+  }
+  if (first[0] != 3 || second[0] != 5 || second[size - 1] != 3) {
+    debug() << "Copied" << first[0] << second[0] << second[size - 1]
+            << "instead of 3 5 3";
+    result = 1;
+  }
+
+  return result;
+}
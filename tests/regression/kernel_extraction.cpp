@@ -0,0 +1,65 @@
+#include "../common.h"
+
+#include <vector>
+
+// Built twice from this file.
+// kernel_extraction_extract runs at build time in extraction mode,
+// kernel_extraction embeds the kernels and binaries it extracted
+// and creates its programs from them instead of compiling the source.
+
+using namespace cl::sycl;
+
+class extracted_functor {
+ public:
+  void operator()(id<1> i) {
+    int1 x = i[0];
+    x += 3;
+  }
+};
+
+// Built when the first queue is created in extraction mode
+SYCL_EXTRACT_KERNEL(extracted_functor);
+
+int main() {
+  const int size = 64;
+  std::vector<int> data(size, 1);
+  int result = 0;
+
+  context ctx;
+  ctx.reset_counters();
+  {
+    queue myQueue(ctx, ctx.get_devices()[0]);
+    buffer<int> buf(data.data(), size);
+
+    myQueue.submit([&](handler& cgh) {
+      cgh.parallel_for(range<1>(size), extracted_functor());
+    });
+
+    // Only known once traced, extracted after it is built
+    myQueue.submit([&](handler& cgh) {
+      auto d = buf.get_access<access::mode::read_write>(cgh);
+      cgh.parallel_for<class traced_kernel>(range<1>(size),
+                                            [=](id<1> i) { d[i] += i; });
+    });
+  }
+
+  for (int i = 0; i < size; ++i) {
+    if (data[i] != 1 + i) {
+      debug() << "index" << i << "expected" << 1 + i << "got" << data[i];
+      result = 1;
+      break;
+    }
+  }
+
+  if (detail::kernel_store::is_extracting()) {
+    return result;
+  }
+
+  auto loaded = ctx.get_counter<info::counter::programs_loaded>();
+  if (loaded != 2) {
+    debug() << "Expected both programs to be loaded from embedded binaries,"
+            << "loaded" << loaded;
+    result = 1;
+  }
+  return result;
+}
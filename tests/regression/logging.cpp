@@ -0,0 +1,51 @@
+#include "../common.h"
+#include <SYCL/detail/logger.h>
+
+// Checks that enabled log categories are recorded in the ring buffer
+// and that disabled ones are not.
+
+int main() {
+  using namespace cl::sycl;
+  using detail::logger;
+
+  const int size = 16;
+  int result = 0;
+
+  logger::set_level(logger::level_t::trace,
+                    1u << static_cast<unsigned int>(logger::category_t::sync));
+  if (!SYCL_LOG_ENABLED(trace, sync) || SYCL_LOG_ENABLED(trace, command)) {
+    debug() << "Unexpected categories enabled";
+    result = 1;
+  }
+
+  {
+    queue myQueue;
+    buffer<int> data(size);
+    myQueue.submit([&](handler& cgh) {
+      auto d = data.get_access<access::mode::discard_write>(cgh);
+      cgh.parallel_for<class logged>(range<1>(size),
+                                     [=](id<1> i) { d[i] = i; });
+    });
+    myQueue.wait();
+  }
+
+  std::stringstream log;
+  logger::dump(log);
+  auto text = log.str();
+  if (text.find("trace sync can_flush") == string_class::npos) {
+    debug() << "Synchronizer records are missing";
+    result = 1;
+  }
+  if (text.find("trace command") != string_class::npos) {
+    debug() << "Command records were not filtered out";
+    result = 1;
+  }
+
+  logger::disable();
+  if (SYCL_LOG_ENABLED(error, general)) {
+    debug() << "Logging was not disabled";
+    result = 1;
+  }
+
+  return result;
+}
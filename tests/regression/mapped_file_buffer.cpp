@@ -0,0 +1,69 @@
+#include "../common.h"
+
+#include <cstdio>
+#include <fstream>
+
+// Creates a buffer from a memory-mapped file,
+// which is uploaded only once although two kernels read it.
+
+int main() {
+  using namespace cl::sycl;
+
+  const int size = 4096;
+  const int header = 16;
+  const char* path = "mapped_file_buffer.bin";
+  int result = 0;
+
+  {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    vector_class<char> padding(header, 'x');
+    file.write(padding.data(), header);
+    for (int i = 0; i < size; ++i) {
+      file.write(reinterpret_cast<const char*>(&i), sizeof(i));
+    }
+  }
+
+  vector_class<int> output(size, 0);
+  context ctx;
+  {
+    queue myQueue(ctx, ctx.get_devices()[0]);
+    buffer<int> input(mapped_file(path, header), range<1>(size));
+    buffer<int> out(output.data(), range<1>(size));
+
+    {
+      auto host =
+          input.get_access<access::mode::read, access::target::host_buffer>();
+      if (host[1] != 1 || host[size - 1] != size - 1) {
+        debug() << "The mapping does not start at the offset";
+        result = 1;
+      }
+    }
+
+    for (int pass = 1; pass <= 2; ++pass) {
+      myQueue.submit([&](handler& cgh) {
+        auto in = input.get_access<access::mode::read>(cgh);
+        auto o = out.get_access<access::mode::write>(cgh);
+        cgh.parallel_for<class mapped>(range<1>(size),
+                                       [=](id<1> i) { o[i] = in[i] * pass; });
+      });
+    }
+    myQueue.wait();
+  }
+  std::remove(path);
+
+  auto uploaded = ctx.get_counter<info::counter::bytes_uploaded>();
+  if (uploaded != size * sizeof(int)) {
+    debug() << "Uploaded" << uploaded << "bytes instead of"
+            << size * sizeof(int);
+    result = 1;
+  }
+
+  for (int i = 0; i < size; ++i) {
+    if (output[i] != i * 2) {
+      debug() << "Element" << i << "is" << output[i] << "instead of" << i * 2;
+      return 1;
+    }
+  }
+
+  return result;
+}
@@ -0,0 +1,139 @@
+#include "../common.h"
+
+// Uses more buffers than fit into the device memory budget of the context,
+// so that the least recently used ones are evicted and uploaded again.
+// Strided sub-buffers have no host pointer of their own,
+// but are restored from their parent, so they are evicted as well.
+
+using namespace cl::sycl;
+
+// The left and right halves of each row, so neither spans whole rows
+static int strided_sub_buffers() {
+  const int width = 64;
+  const int height = 64;
+  const int half = width / 2;
+  const int rounds = 3;
+  int result = 0;
+
+  vector_class<int> data(width * height);
+  for (int i = 0; i < width * height; ++i) {
+    data[i] = i;
+  }
+
+  context ctx;
+  ctx.reset_counters();
+  // One half at a time
+  ctx.set_memory_budget(half * height * sizeof(int));
+  {
+    queue myQueue(ctx, ctx.get_devices()[0]);
+    buffer<int, 2> parent(data.data(), range<2>(width, height));
+    buffer<int, 2> left(parent, id<2>(0, 0), range<2>(half, height));
+    buffer<int, 2> right(parent, id<2>(half, 0), range<2>(half, height));
+
+    for (int r = 0; r < rounds; ++r) {
+      for (auto buf : {&left, &right}) {
+        myQueue.submit([&](handler& cgh) {
+          auto d = buf->get_access<access::mode::read_write>(cgh);
+          cgh.parallel_for<class evicted_strided>(
+              range<2>(half, height), [=](id<2> i) { d[i] += 1; });
+        });
+        myQueue.wait();
+
+        auto usage = ctx.get_memory_usage();
+        if (usage == 0 || usage > ctx.get_memory_budget()) {
+          debug() << "Strided sub-buffers use" << usage
+                  << "bytes, expected up to the budget";
+          result = 1;
+        }
+      }
+    }
+  }
+
+  auto evicted = ctx.get_counter<info::counter::buffers_evicted>();
+  debug() << "strided buffers_evicted" << evicted;
+  if (evicted == 0) {
+    debug() << "Expected strided sub-buffers to be evicted";
+    result = 1;
+  }
+
+  for (int i = 0; i < width * height; ++i) {
+    if (data[i] != i + rounds) {
+      debug() << "Strided element" << i << "is" << data[i] << "instead of"
+              << i + rounds;
+      return 1;
+    }
+  }
+
+  return result;
+}
+
+int main() {
+  const int size = 1024;
+  const int num_buffers = 3;
+  const int rounds = 3;
+  const ::size_t bytes = size * sizeof(int);
+  int result = 0;
+
+  vector_class<vector_class<int>> data(num_buffers, vector_class<int>(size));
+  for (int b = 0; b < num_buffers; ++b) {
+    for (int i = 0; i < size; ++i) {
+      data[b][i] = b * size + i;
+    }
+  }
+
+  context ctx;
+  ctx.set_memory_budget(2 * bytes);
+  {
+    queue myQueue(ctx, ctx.get_devices()[0]);
+    vector_class<buffer<int>> buffers;
+    buffers.reserve(num_buffers);
+    for (auto& d : data) {
+      buffers.emplace_back(d.data(), range<1>(size));
+    }
+
+    for (int r = 0; r < rounds; ++r) {
+      for (auto& buf : buffers) {
+        myQueue.submit([&](handler& cgh) {
+          auto d = buf.get_access<access::mode::read_write>(cgh);
+          cgh.parallel_for<class evicted>(range<1>(size),
+                                          [=](id<1> i) { d[i] += 1; });
+        });
+        myQueue.wait();
+
+        auto usage = ctx.get_memory_usage();
+        if (usage > ctx.get_memory_budget()) {
+          debug() << "Using" << usage << "bytes, over the budget";
+          result = 1;
+        }
+      }
+    }
+  }
+
+  auto evicted = ctx.get_counter<info::counter::buffers_evicted>();
+  debug() << "buffers_evicted" << evicted;
+  if (evicted == 0) {
+    debug() << "Expected evictions";
+    result = 1;
+  }
+  if (ctx.get_memory_usage() != 0) {
+    debug() << "Memory still accounted for after the buffers were destroyed";
+    result = 1;
+  }
+
+  for (int b = 0; b < num_buffers; ++b) {
+    for (int i = 0; i < size; ++i) {
+      auto expected = b * size + i + rounds;
+      if (data[b][i] != expected) {
+        debug() << "Buffer" << b << "element" << i << "is" << data[b][i]
+                << "instead of" << expected;
+        return 1;
+      }
+    }
+  }
+
+  if (strided_sub_buffers() != 0) {
+    result = 1;
+  }
+
+  return result;
+}
@@ -0,0 +1,75 @@
+#include "../common.h"
+
+// Checks the profiling log of a queue created with profiling enabled,
+// and that the events returned by submit are filled in.
+// Buffers created one after another at the same address
+// are listed separately.
+
+int main() {
+  using namespace cl::sycl;
+
+  const int size = 1024;
+  const int submits = 4;
+  int result = 0;
+
+  {
+    context ctx;
+    queue myQueue(ctx, ctx.get_devices()[0], true);
+    buffer<int> data(size);
+
+    handler_event events;
+    for (int s = 0; s < submits; ++s) {
+      events = myQueue.submit([&](handler& cgh) {
+        auto d = data.get_access<access::mode::discard_write>(cgh);
+        cgh.parallel_for<class profiled>(range<1>(size),
+                                         [=](id<1> i) { d[i] = i; });
+      });
+    }
+
+    auto kernels = myQueue.get_kernel_stats();
+    if (kernels.size() != 1 || kernels[0].count != submits) {
+      debug() << "Expected" << submits << "launches of one kernel";
+      result = 1;
+    } else {
+      debug() << "Kernel" << kernels[0].name << "total" << kernels[0].total
+              << "ns";
+    }
+
+    auto buffers = myQueue.get_buffer_stats();
+    if (buffers.empty()) {
+      debug() << "No buffer commands recorded";
+      result = 1;
+    }
+    for (auto& s : buffers) {
+      debug() << s.name << s.count << "commands" << s.bytes << "bytes";
+    }
+
+    if (events.get_kernel().get() == nullptr ||
+        events.get_complete().get() == nullptr) {
+      debug() << "Events of the last submit were not filled in";
+      result = 1;
+    }
+
+    for (int b = 0; b < 2; ++b) {
+      buffer<int> temporary(size);
+      myQueue.submit([&](handler& cgh) {
+        auto t = temporary.get_access<access::mode::discard_write>(cgh);
+        cgh.parallel_for<class temporary_kernel>(range<1>(size),
+                                                 [=](id<1> i) { t[i] = i; });
+      });
+      myQueue.wait();
+    }
+    ::size_t created = 0;
+    for (auto& s : myQueue.get_buffer_stats()) {
+      if (s.type == detail::profiler::command_t::create_buffer) {
+        ++created;
+      }
+    }
+    if (created != 3) {
+      debug() << "Expected 3 created buffers, got" << created;
+      result = 1;
+    }
+  }
+
+  return result;
+}
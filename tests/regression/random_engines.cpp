@@ -0,0 +1,114 @@
+#include "../common.h"
+
+// Counter-based random number generators,
+// the kernel has to generate the same numbers as the host
+
+template <class Engine>
+struct random_result {
+  cl::sycl::cl_uint word;
+  float uniform;
+  float normal;
+  float exponential;
+};
+
+template <class Engine>
+random_result<Engine> hostRandom(unsigned int seed, unsigned int id) {
+  using namespace cl::sycl;
+  Engine rng(seed, id);
+  random_result<Engine> r;
+  r.word = rng();
+  r.uniform = random::uniform(rng);
+  r.normal = random::normal(rng, 1.0f, 2.0f);
+  r.exponential = random::exponential(rng, 0.5f);
+  return r;
+}
+
+// Known answers from Random123
+bool knownAnswers() {
+  using namespace cl::sycl;
+
+  unsigned int philox[4] = {0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344};
+  unsigned int philoxKey[2] = {0xa4093822, 0x299f31d0};
+  random::philox4x32<unsigned int>::block(philox, philoxKey);
+
+  unsigned int threefry[2] = {0x243f6a88, 0x85a308d3};
+  unsigned int threefryKey[2] = {0x13198a2e, 0x03707344};
+  random::threefry2x32<unsigned int>::block(threefry, threefryKey);
+
+  return philox[0] == 0xd16cfe09 && philox[1] == 0x94fdcceb &&
+         philox[2] == 0x5001e420 && philox[3] == 0x24126ea1 &&
+         threefry[0] == 0xc4923a9c && threefry[1] == 0x483df7a0;
+}
+
+template <class Engine, class DeviceEngine>
+int test(cl::sycl::queue& myQueue) {
+  using namespace cl::sycl;
+
+  const int size = 1024;
+  const unsigned int seed = 20170419;
+
+  buffer<unsigned int> words(size);
+  buffer<float> uniform(size);
+  buffer<float> normal(size);
+  buffer<float> exponential(size);
+
+  myQueue.submit([&](handler& cgh) {
+    auto w = words.get_access<access::mode::discard_write>(cgh);
+    auto u = uniform.get_access<access::mode::discard_write>(cgh);
+    auto n = normal.get_access<access::mode::discard_write>(cgh);
+    auto e = exponential.get_access<access::mode::discard_write>(cgh);
+
+    cgh.parallel_for<DeviceEngine>(range<1>(size), [=](id<1> i) {
+      DeviceEngine rng(seed, i[0]);
+      w[i] = rng();
+      u[i] = random::uniform(rng);
+      n[i] = random::normal(rng, 1.0f, 2.0f);
+      e[i] = random::exponential(rng, 0.5f);
+    });
+  });
+
+  auto w = words.get_access<access::mode::read, access::target::host_buffer>();
+  auto u =
+      uniform.get_access<access::mode::read, access::target::host_buffer>();
+  auto n = normal.get_access<access::mode::read, access::target::host_buffer>();
+  auto e =
+      exponential.get_access<access::mode::read, access::target::host_buffer>();
+
+  // The built-in functions are not exact
+  auto floatEqual = [](float first, float second) {
+    return std::fabs(first - second) <= 1e-4f * (1 + std::fabs(second));
+  };
+
+  for (int i = 0; i < size; ++i) {
+    auto expected = hostRandom<Engine>(seed, i);
+    if (w[i] != expected.word || u[i] != expected.uniform) {
+      debug() << i << "generated" << w[i] << u[i] << "instead of"
+              << expected.word << expected.uniform;
+      return 1;
+    }
+    if (!floatEqual(n[i], expected.normal) ||
+        !floatEqual(e[i], expected.exponential)) {
+      debug() << i << "distributions are" << n[i] << e[i] << "instead of"
+              << expected.normal << expected.exponential;
+      return 1;
+    }
+  }
+
+  return 0;
+}
+
+int main() {
+  using namespace cl::sycl;
+
+  if (!knownAnswers()) {
+    debug() << "Host generators do not match the known answers";
+    return 1;
+  }
+
+  queue myQueue;
+
+  return test<random::philox4x32<unsigned int>, random::philox4x32<>>(
+             myQueue) +
+         test<random::threefry2x32<unsigned int>, random::threefry2x32<>>(
+             myQueue);
+}
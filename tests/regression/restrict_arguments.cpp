@@ -0,0 +1,95 @@
+#include "extracted_kernels.h"
+
+#include <cstdlib>
+
+// Kernel arguments are declared restrict when the buffers are distinct,
+// but not when a buffer and its sub-buffer share host memory.
+// The test then runs itself with SYCL_GTX_NO_RESTRICT set,
+// which turns restrict off for distinct buffers too.
+
+using namespace cl::sycl;
+
+static const char* kernel_dir = "restrict_arguments_kernels";
+static const int size = 64;
+
+// Runs one kernel and returns the signature of its extracted source
+template <class name>
+static string_class run(buffer<int>& in, buffer<int>& out) {
+  take_extracted_kernels(kernel_dir);
+  detail::kernel_store::extract_to(kernel_dir);
+  {
+    queue myQueue;
+    myQueue.submit([&](handler& cgh) {
+      auto r = in.get_access<access::mode::read>(cgh);
+      auto w = out.get_access<access::mode::discard_write>(cgh);
+      cgh.parallel_for<name>(range<1>(size / 2),
+                             [=](id<1> i) { w[i] = r[i] * 2; });
+    });
+    myQueue.wait();
+  }
+  detail::kernel_store::extract_to("");
+
+  auto kernels = take_extracted_kernels(kernel_dir);
+  if (kernels.size() != 1) {
+    debug() << "Expected one extracted kernel, got" << kernels.size();
+    return "";
+  }
+  auto signature = kernel_signature(kernels[0]);
+  debug() << signature;
+  return signature;
+}
+
+static bool is_restrict(const string_class& signature) {
+  return signature.find("restrict") != string_class::npos;
+}
+
+static void set_no_restrict() {
+#ifdef _WIN32
+  _putenv_s("SYCL_GTX_NO_RESTRICT", "1");
+#else
+  setenv("SYCL_GTX_NO_RESTRICT", "1", 1);
+#endif
+}
+
+int main(int argc, char* argv[]) {
+  vector_class<int> first(size, 1);
+  vector_class<int> second(size, 0);
+  buffer<int> a(first.data(), range<1>(size));
+  buffer<int> b(second.data(), range<1>(size));
+
+  if (argc > 1) {
+    // Started with SYCL_GTX_NO_RESTRICT set
+    auto signature = run<class unrestricted>(a, b);
+    if (signature.empty() || is_restrict(signature)) {
+      debug() << "SYCL_GTX_NO_RESTRICT did not turn restrict off";
+      return 1;
+    }
+    return 0;
+  }
+
+  int result = 0;
+
+  auto signature = run<class distinct>(a, b);
+  if (!is_restrict(signature)) {
+    debug() << "Distinct buffers are not restrict";
+    result = 1;
+  }
+
+  // Reads the first half of a and writes the second half through the
+  // sub-buffer, the arguments don't overlap but their host memory does
+  buffer<int> upper(a, id<1>(size / 2), range<1>(size / 2));
+  signature = run<class aliased>(a, upper);
+  if (signature.empty() || is_restrict(signature)) {
+    debug() << "A buffer and its sub-buffer are restrict";
+    result = 1;
+  }
+
+  set_no_restrict();
+  auto command = string_class("\"") + argv[0] + "\" no_restrict";
+  if (std::system(command.c_str()) != 0) {
+    debug() << "The run with SYCL_GTX_NO_RESTRICT failed";
+    result = 1;
+  }
+
+  return result;
+}
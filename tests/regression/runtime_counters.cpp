@@ -0,0 +1,70 @@
+#include "../common.h"
+
+// Checks the runtime counters of a context after a few submits,
+// and that they are shared by the context of the queue.
+
+int main() {
+  using namespace cl::sycl;
+
+  const int size = 1024;
+  const int submits = 4;
+  int result = 0;
+
+  context ctx;
+  {
+    queue myQueue(ctx, ctx.get_devices()[0]);
+    buffer<int> data(size);
+
+    for (int s = 0; s < submits; ++s) {
+      myQueue.submit([&](handler& cgh) {
+        auto d = data.get_access<access::mode::read_write>(cgh);
+        cgh.parallel_for<class counted>(range<1>(size),
+                                        [=](id<1> i) { d[i] += 1; });
+      });
+    }
+    myQueue.wait();
+
+    auto launches = myQueue.get_context()
+                        .get_counter<info::counter::kernel_launches>();
+    if (launches != submits) {
+      debug() << "Expected" << submits << "kernel launches, got" << launches;
+      result = 1;
+    }
+  }
+
+  auto check_at_least = [&](const char* name, ::cl_ulong value,
+                            ::cl_ulong minimum) {
+    debug() << name << value;
+    if (value < minimum) {
+      debug() << "Expected at least" << minimum;
+      result = 1;
+    }
+  };
+  check_at_least("bytes_uploaded",
+                 ctx.get_counter<info::counter::bytes_uploaded>(),
+                 size * sizeof(int));
+  check_at_least("bytes_downloaded",
+                 ctx.get_counter<info::counter::bytes_downloaded>(),
+                 size * sizeof(int));
+  check_at_least("buffers_created",
+                 ctx.get_counter<info::counter::buffers_created>(), 1);
+  check_at_least("bytes_allocated",
+                 ctx.get_counter<info::counter::bytes_allocated>(),
+                 size * sizeof(int));
+  check_at_least("programs_compiled",
+                 ctx.get_counter<info::counter::programs_compiled>(), 1);
+  check_at_least("program_cache_hits",
+                 ctx.get_counter<info::counter::program_cache_hits>(),
+                 submits - 1);
+  check_at_least("wait_time", ctx.get_counter<info::counter::wait_time>(),
+                 1);
+
+  ctx.reset_counters();
+  if (ctx.get_counter<info::counter::kernel_launches>() != 0 ||
+      ctx.get_counter<info::counter::bytes_uploaded>() != 0) {
+    debug() << "Counters were not reset";
+    result = 1;
+  }
+
+  return result;
+}
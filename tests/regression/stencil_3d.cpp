@@ -0,0 +1,130 @@
+#include "../common.h"
+
+// Seven-point stencil on a volume,
+// once reading global memory over the interior with an offset,
+// once from tiles in local memory over the whole volume,
+// followed by a kernel on a block of the result as a sub-buffer
+
+static const int nx = 32;
+static const int ny = 16;
+static const int nz = 8;
+static const float center = 0.4f;
+static const float neighbour = 0.1f;
+
+static int index(int x, int y, int z) {
+  x = std::min(std::max(x, 0), nx - 1);
+  y = std::min(std::max(y, 0), ny - 1);
+  z = std::min(std::max(z, 0), nz - 1);
+  return x + y * nx + z * nx * ny;
+}
+
+int main() {
+  using namespace cl::sycl;
+
+  const int size = nx * ny * nz;
+  const range<3> volume(nx, ny, nz);
+  const range<3> group(8, 4, 2);
+  int result = 0;
+
+  vector_class<float> input(size);
+  vector_class<float> direct(size, 0.0f);
+  vector_class<float> tiled(size, 0.0f);
+  for (int i = 0; i < size; ++i) {
+    input[i] = static_cast<float>((i * 7) % 13);
+  }
+
+  auto stencil = [&](int x, int y, int z) {
+    return center * input[index(x, y, z)] +
+           neighbour *
+               (input[index(x - 1, y, z)] + input[index(x + 1, y, z)] +
+                input[index(x, y - 1, z)] + input[index(x, y + 1, z)] +
+                input[index(x, y, z - 1)] + input[index(x, y, z + 1)]);
+  };
+
+  {
+    queue myQueue;
+    buffer<float, 3> in(input.data(), volume);
+    buffer<float, 3> out(direct.data(), volume);
+    buffer<float, 3> tiles(tiled.data(), volume);
+
+    myQueue.submit([&](handler& cgh) {
+      auto i = in.get_access<access::mode::read>(cgh);
+      auto o = out.get_access<access::mode::write>(cgh);
+      cgh.parallel_for<class stencil_direct>(
+          range<3>(nx - 2, ny - 2, nz - 2), id<3>(1, 1, 1), [=](id<3> p) {
+            auto x = p[0];
+            auto y = p[1];
+            auto z = p[2];
+            o[p] = center * i[p] +
+                   neighbour * (i[x - 1][y][z] + i[x + 1][y][z] +
+                                i[x][y - 1][z] + i[x][y + 1][z] +
+                                i[x][y][z - 1] + i[x][y][z + 1]);
+          });
+    });
+
+    myQueue.submit([&](handler& cgh) {
+      auto i = in.get_access<access::mode::read>(cgh);
+      auto o = tiles.get_access<access::mode::discard_write>(cgh);
+      local_tile_3d<float> tile(group, 1, cgh);
+      cgh.parallel_for<class stencil_tiled>(
+          nd_range<3>(volume, group), [=](nd_item<3> it) {
+            tile.load(it, i, volume);
+            o[it.get_global()] =
+                center * tile(it, 0, 0, 0) +
+                neighbour * (tile(it, -1, 0, 0) + tile(it, 1, 0, 0) +
+                             tile(it, 0, -1, 0) + tile(it, 0, 1, 0) +
+                             tile(it, 0, 0, -1) + tile(it, 0, 0, 1));
+          });
+    });
+
+    // Waits for the stencil before the block is uploaded
+    tiles.get_access<access::mode::read, access::target::host_buffer>();
+
+    // Neither whole rows nor whole slices of the volume
+    buffer<float, 3> block(tiles, id<3>(4, 2, 1), range<3>(8, 4, 2));
+    myQueue.submit([&](handler& cgh) {
+      auto b = block.get_access<access::mode::read_write>(cgh);
+      cgh.parallel_for<class stencil_block>(range<3>(8, 4, 2),
+                                            [=](id<3> p) { b[p] *= 2.0f; });
+    });
+
+    auto b =
+        block.get_access<access::mode::read, access::target::host_buffer>();
+    for (int z = 0; z < 2 && result == 0; ++z) {
+      for (int y = 0; y < 4 && result == 0; ++y) {
+        for (int x = 0; x < 8 && result == 0; ++x) {
+          auto expected = 2 * stencil(x + 4, y + 2, z + 1);
+          if (std::fabs(b[x][y][z] - expected) > 1e-4f) {
+            debug() << "Block element" << x << y << z << "is" << b[x][y][z]
+                    << "instead of" << expected;
+            result = 1;
+          }
+        }
+      }
+    }
+  }
+
+  for (int z = 0; z < nz && result == 0; ++z) {
+    for (int y = 0; y < ny && result == 0; ++y) {
+      for (int x = 0; x < nx && result == 0; ++x) {
+        auto i = index(x, y, z);
+        bool interior = x > 0 && x < nx - 1 && y > 0 && y < ny - 1 && z > 0 &&
+                        z < nz - 1;
+        bool in_block = x >= 4 && x < 12 && y >= 2 && y < 6 && z >= 1 && z < 3;
+        auto expected = stencil(x, y, z);
+        if (std::fabs(direct[i] - (interior ? expected : 0.0f)) > 1e-4f) {
+          debug() << "Element" << x << y << z << "is" << direct[i]
+                  << "instead of" << expected;
+          result = 1;
+        }
+        if (std::fabs(tiled[i] - (in_block ? 2 : 1) * expected) > 1e-4f) {
+          debug() << "Tiled element" << x << y << z << "is" << tiled[i]
+                  << "instead of" << expected;
+          result = 1;
+        }
+      }
+    }
+  }
+
+  return result;
+}
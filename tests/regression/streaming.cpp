@@ -0,0 +1,43 @@
+#include "../common.h"
+
+// Streams a host array through a kernel in chunks,
+// with the last chunk smaller than the others.
+
+using namespace cl::sycl;
+
+using chunk_t =
+    accessor<int, 1, access::mode::read_write, access::target::global_buffer>;
+
+struct scale {
+  void operator()(chunk_t chunk, id<1> i) const {
+    chunk[i] = chunk[i] * 2 + 1;
+  }
+};
+
+int main() {
+  const ::size_t size = 10000;
+  const ::size_t chunk_size = 1024;
+
+  vector_class<int> input(size);
+  vector_class<int> output(size, 0);
+  for (::size_t i = 0; i < size; ++i) {
+    input[i] = static_cast<int>(i);
+  }
+
+  {
+    queue myQueue;
+    stream_chunks<class streamed>(myQueue, input.data(), output.data(), size,
+                                  chunk_size, scale());
+  }
+
+  for (::size_t i = 0; i < size; ++i) {
+    auto expected = input[i] * 2 + 1;
+    if (output[i] != expected) {
+      debug() << "Element" << i << "is" << output[i] << "instead of"
+              << expected;
+      return 1;
+    }
+  }
+
+  return 0;
+}
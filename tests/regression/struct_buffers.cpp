@@ -0,0 +1,132 @@
+#include "../common.h"
+
+// Buffers of user-defined structs, accessed field by field in the kernel
+
+struct bounds {
+  float min;
+  float max;
+};
+
+struct particle {
+  cl::sycl::cl_float3 position;
+  cl::sycl::cl_float3 velocity;
+  bounds limits;
+  float mass;
+  int steps;
+};
+
+#define BOUNDS_FIELDS(field) field(min) field(max)
+SYCL_STRUCT(bounds, BOUNDS_FIELDS)
+
+#define PARTICLE_FIELDS(field) \
+  field(position) field(velocity) field(limits) field(mass) field(steps)
+SYCL_STRUCT(particle, PARTICLE_FIELDS)
+
+int main() {
+  using namespace cl::sycl;
+
+  const int size = 256;
+  const float dt = 0.5f;
+  int result = 0;
+
+  buffer<particle> particles(size);
+  buffer<particle> copies(size);
+  buffer<float> momentum(size);
+
+  auto setup = [](int i, particle& p) {
+    p.position.x() = static_cast<float>(i);
+    p.position.y() = static_cast<float>(i % 7);
+    p.position.z() = 1;
+    p.velocity.x() = static_cast<float>(i % 5);
+    p.velocity.y() = -1;
+    p.velocity.z() = 0.25f;
+    p.limits.min = 0;
+    p.limits.max = static_cast<float>(size);
+    p.mass = static_cast<float>(i % 3 + 1);
+    p.steps = i;
+  };
+
+  {
+    auto p = particles.get_access<access::mode::discard_write,
+                                  access::target::host_buffer>();
+    for (int i = 0; i < size; ++i) {
+      setup(i, p[i]);
+    }
+  }
+
+  queue myQueue;
+
+  myQueue.submit([&](handler& cgh) {
+    auto p = particles.get_access<access::mode::read_write>(cgh);
+    auto c = copies.get_access<access::mode::discard_write>(cgh);
+    auto m = momentum.get_access<access::mode::discard_write>(cgh);
+
+    cgh.parallel_for<class struct_buffers>(range<1>(size), [=](id<1> i) {
+      // Refers to the element of the buffer
+      auto current = p[i];
+      current.position += current.velocity * dt;
+      SYCL_IF(current.position.x() > current.limits.max) {
+        current.position.x() = current.limits.max;
+      }
+      SYCL_END;
+      current.steps += 1;
+
+      // A copy is a new variable
+      device_struct<particle> copy = current;
+      copy.mass = copy.mass * 2.0f;
+      copy.limits.min = -copy.limits.max;
+      c[i] = copy;
+
+      m[i] = current.mass * length(current.velocity);
+    });
+  });
+
+  auto p =
+      particles.get_access<access::mode::read, access::target::host_buffer>();
+  auto c = copies.get_access<access::mode::read, access::target::host_buffer>();
+  auto m =
+      momentum.get_access<access::mode::read, access::target::host_buffer>();
+
+  for (int i = 0; i < size; ++i) {
+    particle expected;
+    setup(i, expected);
+    auto& v = expected.velocity;
+    expected.position.x() =
+        std::min(expected.position.x() + v.x() * dt, expected.limits.max);
+    expected.position.y() += v.y() * dt;
+    expected.position.z() += v.z() * dt;
+    expected.steps += 1;
+    auto expectedMomentum = expected.mass * std::sqrt(v.x() * v.x() +
+                                                      v.y() * v.y() +
+                                                      v.z() * v.z());
+
+    if (p[i].position.x() != expected.position.x() ||
+        p[i].position.y() != expected.position.y() ||
+        p[i].position.z() != expected.position.z() ||
+        p[i].steps != expected.steps || p[i].mass != expected.mass) {
+      debug() << "Particle" << i << "is at" << p[i].position.x()
+              << p[i].position.y() << p[i].position.z() << "after"
+              << p[i].steps << "steps";
+      result = 1;
+    }
+    if (c[i].position.x() != expected.position.x() ||
+        c[i].steps != expected.steps || c[i].mass != 2 * expected.mass ||
+        c[i].limits.min != -expected.limits.max ||
+        c[i].limits.max != expected.limits.max) {
+      debug() << "Copy" << i << "has mass" << c[i].mass << "and limits"
+              << c[i].limits.min << c[i].limits.max;
+      result = 1;
+    }
+    if (std::fabs(m[i] - expectedMomentum) > 1e-4f * (1 + expectedMomentum)) {
+      debug() << "Momentum" << i << "is" << m[i] << "instead of"
+              << expectedMomentum;
+      result = 1;
+    }
+
+    if (result != 0) {
+      break;
+    }
+  }
+
+  return result;
+}
@@ -0,0 +1,143 @@
+#include "../common.h"
+
+// Buffers of structs stored as a separate array for each field,
+// accessed as structs on the host and in the kernel.
+// Copies between buffers of different layouts are refused.
+
+struct body {
+  cl::sycl::cl_float4 position;
+  cl::sycl::cl_float4 velocity;
+  float mass;
+  int collisions;
+  cl::sycl::cl_float2 extent;
+};
+
+#define BODY_FIELDS(field) \
+  field(position) field(velocity) field(mass) field(collisions) field(extent)
+SYCL_STRUCT(body, BODY_FIELDS)
+
+int main() {
+  using namespace cl::sycl;
+
+  const int size = 1000;
+  const float dt = 0.25f;
+  int result = 0;
+
+  buffer<body> bodies(size);
+  buffer<body> snapshot(size);
+  buffer<body> filled(size);
+  bodies.set_layout(buffer_layout::struct_of_arrays);
+  filled.set_layout(buffer_layout::struct_of_arrays);
+
+  auto setup = [](int i, body& b) {
+    b.position.x() = static_cast<float>(i);
+    b.position.y() = static_cast<float>(i % 10);
+    b.position.z() = static_cast<float>(-i);
+    b.position.w() = 1;
+    b.velocity.x() = 1;
+    b.velocity.y() = static_cast<float>(i % 3);
+    b.velocity.z() = -2;
+    b.velocity.w() = 0;
+    b.mass = static_cast<float>(i % 4 + 1);
+    b.collisions = i;
+    b.extent.x() = static_cast<float>(i % 5);
+    b.extent.y() = 2;
+  };
+
+  {
+    auto b = bodies.get_access<access::mode::discard_write,
+                               access::target::host_buffer>();
+    for (int i = 0; i < size; ++i) {
+      setup(i, b[i]);
+    }
+  }
+
+  queue myQueue;
+
+  myQueue.submit([&](handler& cgh) {
+    auto b = bodies.get_access<access::mode::read_write>(cgh);
+    auto s = snapshot.get_access<access::mode::discard_write>(cgh);
+
+    cgh.parallel_for<class struct_of_arrays>(range<1>(size), [=](id<1> i) {
+      auto current = b[i];
+      current.position += current.velocity * dt;
+      SYCL_IF(current.extent.x() > current.extent.y()) {
+        current.collisions += 1;
+      }
+      SYCL_END;
+
+      // Gathered from the arrays into a struct
+      device_struct<body> copy = current;
+      copy.mass = copy.mass * 0.5f;
+      s[i] = copy;
+    });
+  });
+
+  body value;
+  setup(7, value);
+  myQueue.submit([&](handler& cgh) {
+    auto f = filled.get_access<access::mode::discard_write>(cgh);
+    cgh.fill(f, value);
+  });
+
+  // The arrays of the fields would have to be rearranged
+  bool thrown = false;
+  try {
+    myQueue.submit([&](handler& cgh) {
+      auto from = bodies.get_access<access::mode::read>(cgh);
+      auto to = snapshot.get_access<access::mode::discard_write>(cgh);
+      cgh.copy(from, to);
+    });
+  } catch (cl_exception&) {
+    thrown = true;
+  }
+  if (!thrown) {
+    debug() << "Copying between layouts was not refused on submit";
+    result = 1;
+  }
+
+  auto b = bodies.get_access<access::mode::read, access::target::host_buffer>();
+  auto s =
+      snapshot.get_access<access::mode::read, access::target::host_buffer>();
+  auto f = filled.get_access<access::mode::read, access::target::host_buffer>();
+
+  for (int i = 0; i < size; ++i) {
+    body expected;
+    setup(i, expected);
+    expected.position.x() += expected.velocity.x() * dt;
+    expected.position.y() += expected.velocity.y() * dt;
+    expected.position.z() += expected.velocity.z() * dt;
+    if (expected.extent.x() > expected.extent.y()) {
+      expected.collisions += 1;
+    }
+
+    for (auto actual : {&b[i], &s[i]}) {
+      auto mass = (actual == &s[i]) ? expected.mass * 0.5f : expected.mass;
+      if (actual->position.x() != expected.position.x() ||
+          actual->position.y() != expected.position.y() ||
+          actual->position.z() != expected.position.z() ||
+          actual->position.w() != expected.position.w() ||
+          actual->collisions != expected.collisions ||
+          actual->mass != mass || actual->extent.x() != expected.extent.x()) {
+        debug() << "Body" << i << "is at" << actual->position.x()
+                << actual->position.y() << actual->position.z() << "with"
+                << actual->collisions << "collisions and mass"
+                << actual->mass;
+        result = 1;
+      }
+    }
+
+    if (f[i].position.x() != value.position.x() ||
+        f[i].mass != value.mass || f[i].collisions != value.collisions ||
+        f[i].extent.y() != value.extent.y()) {
+      debug() << "Filled body" << i << "has mass" << f[i].mass;
+      result = 1;
+    }
+
+    if (result != 0) {
+      break;
+    }
+  }
+
+  return result;
+}
@@ -0,0 +1,145 @@
+#include "../common.h"
+
+#include <cstdlib>
+#include <fstream>
+#include <set>
+#include <sstream>
+
+// Runs itself with SYCL_GTX_TRACE set and checks the written timeline.
+// Two independent command groups both feed a third one,
+// each group runs on its own OpenCL queue,
+// so the third kernel gets an arrow from both.
+// Tracing alone must neither record nor print the profile of the queue.
+
+using namespace cl::sycl;
+
+static const char* trace_file = "trace_export.json";
+static const char* stderr_file = "trace_export.err";
+
+static int run_traced() {
+  const int size = 256;
+
+  queue myQueue;
+  buffer<int> a(size);
+  buffer<int> b(size);
+  buffer<int> c(size);
+
+  myQueue.submit([&](handler& cgh) {
+    auto w = a.get_access<access::mode::discard_write>(cgh);
+    cgh.parallel_for<class trace_first>(range<1>(size),
+                                        [=](id<1> i) { w[i] = i; });
+  });
+  myQueue.submit([&](handler& cgh) {
+    auto w = b.get_access<access::mode::discard_write>(cgh);
+    cgh.parallel_for<class trace_second>(range<1>(size),
+                                         [=](id<1> i) { w[i] = 2 * i; });
+  });
+  myQueue.submit([&](handler& cgh) {
+    auto x = a.get_access<access::mode::read>(cgh);
+    auto y = b.get_access<access::mode::read>(cgh);
+    auto w = c.get_access<access::mode::discard_write>(cgh);
+    cgh.parallel_for<class trace_sum>(range<1>(size),
+                                      [=](id<1> i) { w[i] = x[i] + y[i]; });
+  });
+  myQueue.wait();
+
+  if (myQueue.is_profiling() || !myQueue.get_profiling_log().empty()) {
+    debug() << "Tracing recorded the profile of the queue";
+    return 1;
+  }
+  return 0;
+}
+
+static string_class read_file(const char* path) {
+  std::ifstream file(path);
+  std::stringstream contents;
+  contents << file.rdbuf();
+  return contents.str();
+}
+
+static ::size_t count(const string_class& text, const string_class& what) {
+  ::size_t n = 0;
+  for (auto pos = text.find(what); pos != string_class::npos;
+       pos = text.find(what, pos + what.size())) {
+    ++n;
+  }
+  return n;
+}
+
+static void set_trace_path(const char* path) {
+#ifdef _WIN32
+  _putenv_s("SYCL_GTX_TRACE", path);
+#else
+  setenv("SYCL_GTX_TRACE", path, 1);
+#endif
+}
+
+int main(int argc, char* argv[]) {
+  if (argc > 1) {
+    return run_traced();
+  }
+
+  std::remove(trace_file);
+  set_trace_path(trace_file);
+  auto command =
+      string_class("\"") + argv[0] + "\" traced 2> " + stderr_file;
+  if (std::system(command.c_str()) != 0) {
+    debug() << "The traced run failed";
+    return 1;
+  }
+
+  int result = 0;
+  auto trace = read_file(trace_file);
+  debug() << "Trace of" << trace.size() << "bytes";
+
+  if (trace.compare(0, 16, "{\"traceEvents\":[") != 0 ||
+      trace.find("\"displayTimeUnit\":\"ns\"}") == string_class::npos) {
+    debug() << "Not a complete trace";
+    result = 1;
+  }
+  if (count(trace, "\"name\":\"handler::build\"") < 3) {
+    debug() << "Expected a handler::build span per command group";
+    result = 1;
+  }
+
+  auto kernels = count(trace, "\"cat\":\"kernel\"");
+  if (kernels != 3) {
+    debug() << "Expected 3 kernels, got" << kernels;
+    result = 1;
+  }
+  // The master queue has a track too if it enqueued anything
+  auto tracks = count(trace, "\"name\":\"thread_name\"");
+  if (tracks < 3) {
+    debug() << "Expected a track per command group, got" << tracks;
+    result = 1;
+  }
+  auto flows = count(trace, "\"ph\":\"f\"");
+  if (flows != count(trace, "\"ph\":\"s\"")) {
+    debug() << "Unmatched flow events";
+    result = 1;
+  }
+  // Tracks the arrows start from
+  std::set<string_class> producers;
+  std::stringstream lines(trace);
+  string_class line;
+  while (std::getline(lines, line)) {
+    auto tid = line.find("\"tid\":");
+    if (line.find("\"ph\":\"s\"") != string_class::npos &&
+        tid != string_class::npos) {
+      producers.insert(line.substr(tid, line.find(',', tid) - tid));
+    }
+  }
+  if (producers.size() < 2) {
+    debug() << "Expected arrows from both producer queues, got"
+            << producers.size();
+    result = 1;
+  }
+
+  auto errors = read_file(stderr_file);
+  if (errors.find("Profile") != string_class::npos) {
+    debug() << "Tracing printed the profile of the queue";
+    result = 1;
+  }
+
+  return result;
+}
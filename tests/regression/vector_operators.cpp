@@ -0,0 +1,121 @@
+#include "../common.h"
+
+// Vector arithmetic, comparisons, integer operators,
+// conversions and built-in functions on whole vectors.
+
+int main() {
+  using namespace cl::sycl;
+
+  const int size = 64;
+  int result = 0;
+
+  cl::sycl::cl_float4 offset;
+  offset.x() = 1;
+  offset.y() = -2;
+  offset.z() = 0.5f;
+  offset.w() = 4;
+
+  buffer<float4> input(size);
+  buffer<float4> arithmetic(size);
+  buffer<int4> relational(size);
+  buffer<int4> integer(size);
+  buffer<float> geometric(size);
+
+  {
+    auto in = input.get_access<access::mode::discard_write,
+                               access::target::host_buffer>();
+    for (int i = 0; i < size; ++i) {
+      in[i].x() = static_cast<float>(i);
+      in[i].y() = static_cast<float>(i % 5);
+      in[i].z() = static_cast<float>(-i);
+      in[i].w() = 0.25f * i;
+    }
+  }
+
+  queue myQueue;
+
+  myQueue.submit([&](handler& cgh) {
+    auto in = input.get_access<access::mode::read>(cgh);
+    auto ar = arithmetic.get_access<access::mode::discard_write>(cgh);
+    auto re = relational.get_access<access::mode::discard_write>(cgh);
+    auto it = integer.get_access<access::mode::discard_write>(cgh);
+    auto ge = geometric.get_access<access::mode::discard_write>(cgh);
+
+    cgh.parallel_for<class vector_operators>(range<1>(size), [=](id<1> i) {
+      float4 o = offset;
+      ar[i] = -in[i] * 2.0f + 3.0f * (in[i] + o) / 2.0f;
+      ar[i] -= o;
+      re[i] = (in[i] > 2.0f) && !(in[i] == o);
+      it[i] = (in[i].convert<int, rounding_mode::rtz>() % 3) << 1;
+      it[i] |= 1;
+      ge[i] = dot(in[i], o) + length(fabs(in[i].xyz()) - 1.0f);
+    });
+  });
+
+  auto in =
+      input.get_access<access::mode::read, access::target::host_buffer>();
+  auto ar =
+      arithmetic.get_access<access::mode::read, access::target::host_buffer>();
+  auto re =
+      relational.get_access<access::mode::read, access::target::host_buffer>();
+  auto it =
+      integer.get_access<access::mode::read, access::target::host_buffer>();
+  auto ge =
+      geometric.get_access<access::mode::read, access::target::host_buffer>();
+
+  auto floatEqual = [](float first, float second) {
+    return std::fabs(first - second) <= 1e-4f * (1 + std::fabs(second));
+  };
+
+  for (int i = 0; i < size; ++i) {
+    float x[] = {in[i].x(), in[i].y(), in[i].z(), in[i].w()};
+    float o[] = {offset.x(), offset.y(), offset.z(), offset.w()};
+    float a[] = {ar[i].x(), ar[i].y(), ar[i].z(), ar[i].w()};
+    int r[] = {re[i].x(), re[i].y(), re[i].z(), re[i].w()};
+    int n[] = {it[i].x(), it[i].y(), it[i].z(), it[i].w()};
+
+    float dot = 0;
+    float length = 0;
+    for (int j = 0; j < 4; ++j) {
+      auto expected = -x[j] * 2.0f + 3.0f * (x[j] + o[j]) / 2.0f - o[j];
+      if (!floatEqual(a[j], expected)) {
+        debug() << "Arithmetic" << i << j << "is" << a[j] << "instead of"
+                << expected;
+        result = 1;
+      }
+
+      // Vector comparisons are -1 when true
+      int truth = (x[j] > 2.0f && x[j] != o[j]) ? -1 : 0;
+      if (r[j] != truth) {
+        debug() << "Relational" << i << j << "is" << r[j] << "instead of"
+                << truth;
+        result = 1;
+      }
+
+      int integral = ((static_cast<int>(x[j]) % 3) << 1) | 1;
+      if (n[j] != integral) {
+        debug() << "Integer" << i << j << "is" << n[j] << "instead of"
+                << integral;
+        result = 1;
+      }
+
+      dot += x[j] * o[j];
+      if (j < 3) {
+        auto d = std::fabs(x[j]) - 1.0f;
+        length += d * d;
+      }
+    }
+
+    auto expected = dot + std::sqrt(length);
+    if (!floatEqual(ge[i], expected)) {
+      debug() << "Geometric" << i << "is" << ge[i] << "instead of" << expected;
+      result = 1;
+    }
+
+    if (result != 0) {
+      break;
+    }
+  }
+
+  return result;
+}
@@ -0,0 +1,111 @@
+#include "../common.h"
+
+// Reading and assigning vector swizzles, which are generated as OpenCL swizzles
+
+int main() {
+  using namespace cl::sycl;
+
+  const int size = 64;
+  int result = 0;
+
+  buffer<float4> input(size);
+  buffer<float8> wide(size);
+  buffer<float4> reversed(size);
+  buffer<float4> partial(size);
+  buffer<float4> halves(size);
+
+  {
+    auto in = input.get_access<access::mode::discard_write,
+                               access::target::host_buffer>();
+    auto wi = wide.get_access<access::mode::discard_write,
+                              access::target::host_buffer>();
+    for (int i = 0; i < size; ++i) {
+      in[i].x() = static_cast<float>(i);
+      in[i].y() = static_cast<float>(i + 1);
+      in[i].z() = static_cast<float>(i + 2);
+      in[i].w() = static_cast<float>(i + 3);
+      cl::sycl::cl_float4* parts[] = {&wi[i].lo(), &wi[i].hi()};
+      for (int j = 0; j < 2; ++j) {
+        auto first = static_cast<float>(i * 8 + j * 4);
+        parts[j]->x() = first;
+        parts[j]->y() = first + 1;
+        parts[j]->z() = first + 2;
+        parts[j]->w() = first + 3;
+      }
+    }
+  }
+
+  queue myQueue;
+
+  myQueue.submit([&](handler& cgh) {
+    auto in = input.get_access<access::mode::read>(cgh);
+    auto wi = wide.get_access<access::mode::read>(cgh);
+    auto re = reversed.get_access<access::mode::discard_write>(cgh);
+    auto pa = partial.get_access<access::mode::discard_write>(cgh);
+    auto ha = halves.get_access<access::mode::discard_write>(cgh);
+
+    cgh.parallel_for<class vector_swizzles>(range<1>(size), [=](id<1> i) {
+      float4 v = in[i];
+      re[i] = v.wzyx();
+
+      float4 p = v.xxxx();
+      p.xzy() = v.yxz() + 1.0f;
+      p.a() = v.r() * v.g();
+      pa[i] = p;
+
+      float8 w = wi[i];
+      float4 h = w.swizzle<0, 2, 4, 6>() - w.even();
+      h.xy() = w.lo().lo() + w.hi().hi();
+      h.zw() = w.odd().hi();
+      ha[i] = h;
+    });
+  });
+
+  auto in =
+      input.get_access<access::mode::read, access::target::host_buffer>();
+  auto wi = wide.get_access<access::mode::read, access::target::host_buffer>();
+  auto re =
+      reversed.get_access<access::mode::read, access::target::host_buffer>();
+  auto pa =
+      partial.get_access<access::mode::read, access::target::host_buffer>();
+  auto ha =
+      halves.get_access<access::mode::read, access::target::host_buffer>();
+
+  for (int i = 0; i < size; ++i) {
+    float x[] = {in[i].x(), in[i].y(), in[i].z(), in[i].w()};
+    float r[] = {re[i].x(), re[i].y(), re[i].z(), re[i].w()};
+    float p[] = {pa[i].x(), pa[i].y(), pa[i].z(), pa[i].w()};
+    float h[] = {ha[i].x(), ha[i].y(), ha[i].z(), ha[i].w()};
+    auto& lo = wi[i].lo();
+    auto& hi = wi[i].hi();
+    float w[] = {lo.x(), lo.y(), lo.z(), lo.w(),
+                 hi.x(), hi.y(), hi.z(), hi.w()};
+
+    float expectedP[] = {x[1] + 1, x[2] + 1, x[0] + 1, x[0] * x[1]};
+    float expectedH[] = {w[0] + w[6], w[1] + w[7], w[5], w[7]};
+
+    for (int j = 0; j < 4; ++j) {
+      if (r[j] != x[3 - j]) {
+        debug() << "Reversed" << i << j << "is" << r[j] << "instead of"
+                << x[3 - j];
+        result = 1;
+      }
+      if (p[j] != expectedP[j]) {
+        debug() << "Partial" << i << j << "is" << p[j] << "instead of"
+                << expectedP[j];
+        result = 1;
+      }
+      if (h[j] != expectedH[j]) {
+        debug() << "Halves" << i << j << "is" << h[j] << "instead of"
+                << expectedH[j];
+        result = 1;
+      }
+    }
+
+    if (result != 0) {
+      break;
+    }
+  }
+
+  return result;
+}
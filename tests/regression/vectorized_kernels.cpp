@@ -0,0 +1,80 @@
+#include "../common.h"
+
+// Element-wise kernels run with vector loads and stores,
+// with a number of elements that is not a multiple of the width,
+// and a kernel that cannot be vectorized.
+
+int main() {
+  using namespace cl::sycl;
+
+  const int size = 1003;
+  int result = 0;
+
+  vector_class<float> a(size);
+  vector_class<float> b(size);
+  vector_class<float> c(size, 1.0f);
+  vector_class<int> d(size);
+  vector_class<int> e(size, 0);
+  for (int i = 0; i < size; ++i) {
+    a[i] = static_cast<float>(i);
+    b[i] = static_cast<float>(size - i);
+    d[i] = i;
+  }
+
+  {
+    queue myQueue;
+    buffer<float> bufA(a.data(), range<1>(size));
+    buffer<float> bufB(b.data(), range<1>(size));
+    buffer<float> bufC(c.data(), range<1>(size));
+    buffer<int> bufD(d.data(), range<1>(size));
+    buffer<int> bufE(e.data(), range<1>(size));
+
+    myQueue.submit([&](handler& cgh) {
+      auto ka = bufA.get_access<access::mode::read>(cgh);
+      auto kb = bufB.get_access<access::mode::read>(cgh);
+      auto kc = bufC.get_access<access::mode::read_write>(cgh);
+      cgh.parallel_for_vectorized<class vectorized_float>(
+          range<1>(size),
+          [=](id<1> i) { kc[i] += ka[i] * 2.0f + sqrt(kb[i]); });
+    });
+
+    myQueue.submit([&](handler& cgh) {
+      auto kd = bufD.get_access<access::mode::read>(cgh);
+      auto ke = bufE.get_access<access::mode::write>(cgh);
+      cgh.parallel_for_vectorized<class vectorized_int>(
+          range<1>(size), [=](id<1> i) { ke[i] = (kd[i] << 1) + 3; }, 8);
+    });
+
+    // Reads a neighbour, so it runs as a scalar kernel
+    myQueue.submit([&](handler& cgh) {
+      auto kd = bufD.get_access<access::mode::read_write>(cgh);
+      cgh.parallel_for_vectorized<class not_vectorized>(
+          range<1>(size - 1), [=](id<1> i) { kd[i] = kd[i + 1]; });
+    });
+  }
+
+  for (int i = 0; i < size; ++i) {
+    auto expected = 1.0f + a[i] * 2.0f + std::sqrt(b[i]);
+    if (std::fabs(c[i] - expected) > 1e-3f * expected) {
+      debug() << "Element" << i << "is" << c[i] << "instead of" << expected;
+      result = 1;
+      break;
+    }
+  }
+  for (int i = 0; i < size; ++i) {
+    if (e[i] != i * 2 + 3) {
+      debug() << "Element" << i << "is" << e[i] << "instead of" << i * 2 + 3;
+      result = 1;
+      break;
+    }
+  }
+  for (int i = 0; i < size - 1; ++i) {
+    if (d[i] != i + 1) {
+      debug() << "Element" << i << "is" << d[i] << "instead of" << i + 1;
+      result = 1;
+      break;
+    }
+  }
+
+  return result;
+}
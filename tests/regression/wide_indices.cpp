@@ -0,0 +1,56 @@
+#include "../common.h"
+
+// Global ids beyond INT_MAX, here because of the work item offset,
+// are computed as long, as are the indices into the buffers
+
+int main() {
+  using namespace cl::sycl;
+
+  const int size = 64;
+  const ::size_t offset = 3000000000u;
+  int result = 0;
+
+  buffer<int> linear(size);
+  buffer<int, 2> grid(range<2>(size, size));
+
+  queue myQueue;
+
+  myQueue.submit([&](handler& cgh) {
+    auto l = linear.get_access<access::mode::discard_write>(cgh);
+    cgh.parallel_for<class wide_linear>(
+        range<1>(size), id<1>(offset),
+        [=](id<1> i) { l[i[0] - offset] = (i[0] - offset) * 3; });
+  });
+
+  myQueue.submit([&](handler& cgh) {
+    auto g = grid.get_access<access::mode::discard_write>(cgh);
+    cgh.parallel_for<class wide_grid>(
+        range<2>(size, size), id<2>(offset, 0), [=](id<2> i) {
+          g[i[0] - offset][i[1]] = (i[0] - offset) + i[1] * size;
+        });
+  });
+
+  auto l = linear.get_access<access::mode::read, access::target::host_buffer>();
+  auto g = grid.get_access<access::mode::read, access::target::host_buffer>();
+
+  for (int i = 0; i < size; ++i) {
+    if (l[i] != i * 3) {
+      debug() << "Element" << i << "is" << l[i] << "instead of" << i * 3;
+      result = 1;
+      break;
+    }
+    for (int j = 0; j < size; ++j) {
+      if (g[i][j] != i + j * size) {
+        debug() << "Element" << i << j << "is" << g[i][j] << "instead of"
+                << i + j * size;
+        result = 1;
+        break;
+      }
+    }
+    if (result != 0) {
+      break;
+    }
+  }
+
+  return result;
+}